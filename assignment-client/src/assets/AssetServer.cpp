@@ -89,6 +89,20 @@ void AssetServer::completeSetup() {
                     " (" << maxBandwidth << "bytes/sec)";
     }
 
+    // pace the send queues of every connection with a shared pool of threads instead of a thread per connection
+    static const QString SEND_QUEUE_THREADS_OPTION = "send_queue_threads";
+    bool ok;
+    int numSendQueueThreads = assetServerObject[SEND_QUEUE_THREADS_OPTION].toString().toInt(&ok);
+
+    if (ok && numSendQueueThreads > 0) {
+        if (nodeList->setNumSendQueueThreads(numSendQueueThreads)) {
+            qInfo() << "Pacing send queues with" << numSendQueueThreads << "threads.";
+        } else {
+            qWarning() << "Could not pace send queues with" << numSendQueueThreads << "threads,"
+                " keeping the pool that already paces the existing connections.";
+        }
+    }
+
     // get the path to the asset folder from the domain server settings
     static const QString ASSETS_PATH_OPTION = "assets_path";
     auto assetsJSONValue = assetServerObject[ASSETS_PATH_OPTION];
@@ -403,6 +417,8 @@ void AssetServer::sendStatsPacket() {
         connectionStats["5. Period (us)"] = stat.second.packetSendPeriod;
         connectionStats["6. Up (Mb/s)"] = stat.second.sentBytes * megabitsPerSecPerByte;
         connectionStats["7. Down (Mb/s)"] = stat.second.receivedBytes * megabitsPerSecPerByte;
+        connectionStats["8. Socket Recv (P/syscall)"] = stat.second.receiveSyscalls > 0 ?
+            (float)stat.second.receivedDatagrams / stat.second.receiveSyscalls : 0.0f;
         nodeStats["Connection Stats"] = connectionStats;
 
         using Events = udt::ConnectionStats::Stats::Event;
@@ -41,6 +41,7 @@
 #include <QtNetwork/QNetworkRequest>
 #include <QtNetwork/QNetworkReply>
 
+#include <GLMHelpers.h>
 #include <LogHandler.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
@@ -61,9 +62,12 @@
 const float LOUDNESS_TO_DISTANCE_RATIO = 0.00001f;
 const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.18f;
 const float DEFAULT_NOISE_MUTING_THRESHOLD = 0.003f;
+const float DEFAULT_LISTENER_CLUSTER_DISTANCE = 0.5f;
+const float DEFAULT_LISTENER_CLUSTER_ANGLE = 15.0f;
 const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
+const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 
 InboundAudioStream::Settings AudioMixer::_streamSettings;
 
@@ -79,7 +83,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     _minAudibilityThreshold(LOUDNESS_TO_DISTANCE_RATIO / 2.0f),
     _performanceThrottlingRatio(0.0f),
     _attenuationPerDoublingInDistance(DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE),
-    _noiseMutingThreshold(DEFAULT_NOISE_MUTING_THRESHOLD)
+    _noiseMutingThreshold(DEFAULT_NOISE_MUTING_THRESHOLD),
+    _codecPreferenceOrder(AudioCodecs::getCodecNames()),
+    _listenerClusterDistance(DEFAULT_LISTENER_CLUSTER_DISTANCE),
+    _listenerClusterAngle(DEFAULT_LISTENER_CLUSTER_ANGLE),
+    _workerPool(*this)
 {
     auto nodeList = DependencyManager::get<NodeList>();
     auto& packetReceiver = nodeList->getPacketReceiver();
@@ -89,278 +97,17 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
                                               PacketType::AudioStreamStats },
                                             this, "handleNodeAudioPacket");
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
+    packetReceiver.registerListener(PacketType::NegotiateAudioFormat, this, "handleNegotiateAudioFormat");
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
 }
 
-const float ATTENUATION_BEGINS_AT_DISTANCE = 1.0f;
-
-float AudioMixer::gainForSource(const PositionalAudioStream& streamToAdd,
-                                const AvatarAudioStream& listeningNodeStream, const glm::vec3& relativePosition, bool isEcho) {
-    float gain = 1.0f;
-
-    float distanceBetween = glm::length(relativePosition);
-
-    if (distanceBetween < EPSILON) {
-        distanceBetween = EPSILON;
-    }
-
-    if (streamToAdd.getType() == PositionalAudioStream::Injector) {
-        gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
-    }
-
-    if (!isEcho && (streamToAdd.getType() == PositionalAudioStream::Microphone)) {
-        //  source is another avatar, apply fixed off-axis attenuation to make them quieter as they turn away from listener
-        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.getOrientation()) * relativePosition;
-
-        float angleOfDelivery = glm::angle(glm::vec3(0.0f, 0.0f, -1.0f),
-                                           glm::normalize(rotatedListenerPosition));
-
-        const float MAX_OFF_AXIS_ATTENUATION = 0.2f;
-        const float OFF_AXIS_ATTENUATION_FORMULA_STEP = (1 - MAX_OFF_AXIS_ATTENUATION) / 2.0f;
-
-        float offAxisCoefficient = MAX_OFF_AXIS_ATTENUATION +
-        (OFF_AXIS_ATTENUATION_FORMULA_STEP * (angleOfDelivery / PI_OVER_TWO));
-
-        // multiply the current attenuation coefficient by the calculated off axis coefficient
-        gain *= offAxisCoefficient;
-    }
-
-    float attenuationPerDoublingInDistance = _attenuationPerDoublingInDistance;
-    for (int i = 0; i < _zonesSettings.length(); ++i) {
-        if (_audioZones[_zonesSettings[i].source].contains(streamToAdd.getPosition()) &&
-            _audioZones[_zonesSettings[i].listener].contains(listeningNodeStream.getPosition())) {
-            attenuationPerDoublingInDistance = _zonesSettings[i].coefficient;
-            break;
-        }
-    }
-
-    if (distanceBetween >= ATTENUATION_BEGINS_AT_DISTANCE) {
-        // calculate the distance coefficient using the distance to this node
-        float distanceCoefficient = 1.0f - (logf(distanceBetween / ATTENUATION_BEGINS_AT_DISTANCE) / logf(2.0f)
-                                            * attenuationPerDoublingInDistance);
-
-        if (distanceCoefficient < 0) {
-            distanceCoefficient = 0;
-        }
-
-        // multiply the current attenuation coefficient by the distance coefficient
-        gain *= distanceCoefficient;
-    }
-
-    return gain;
-}
-
-float AudioMixer::azimuthForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                                   const glm::vec3& relativePosition) {
-    glm::quat inverseOrientation = glm::inverse(listeningNodeStream.getOrientation());
-
-    //  Compute sample delay for the two ears to create phase panning
-    glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
-
-    // project the rotated source position vector onto the XZ plane
-    rotatedSourcePosition.y = 0.0f;
-
-    static const float SOURCE_DISTANCE_THRESHOLD = 1e-30f;
-
-    if (glm::length2(rotatedSourcePosition) > SOURCE_DISTANCE_THRESHOLD) {
-        // produce an oriented angle about the y-axis
-        return glm::orientedAngle(glm::vec3(0.0f, 0.0f, -1.0f), glm::normalize(rotatedSourcePosition), glm::vec3(0.0f, -1.0f, 0.0f));
-    } else {
-        // there is no distance between listener and source - return no azimuth
-        return 0;
-    }
-}
-
-void AudioMixer::addStreamToMixForListeningNodeWithStream(AudioMixerClientData& listenerNodeData,
-                                                          const PositionalAudioStream& streamToAdd,
-                                                          const QUuid& sourceNodeID,
-                                                          const AvatarAudioStream& listeningNodeStream) {
-
-
-    // to reduce artifacts we calculate the gain and azimuth for every source for this listener
-    // even if we are not going to end up mixing in this source
-
-    ++_totalMixes;
-
-    // this ensures that the tail of any previously mixed audio or the first block of new audio sounds correct
-
-    // check if this is a server echo of a source back to itself
-    bool isEcho = (&streamToAdd == &listeningNodeStream);
-
-    // figure out the gain for this source at the listener
-    glm::vec3 relativePosition = streamToAdd.getPosition() - listeningNodeStream.getPosition();
-    float gain = gainForSource(streamToAdd, listeningNodeStream, relativePosition, isEcho);
-
-    // figure out the azimuth to this source at the listener
-    float azimuth = isEcho ? 0.0f : azimuthForSource(streamToAdd, listeningNodeStream, relativePosition);
-
-    float repeatedFrameFadeFactor = 1.0f;
-
-    static const int HRTF_DATASET_INDEX = 1;
-
-    if (!streamToAdd.lastPopSucceeded()) {
-        bool forceSilentBlock = true;
-
-        if (_streamSettings._repetitionWithFade && !streamToAdd.getLastPopOutput().isNull()) {
-
-            // reptition with fade is enabled, and we do have a valid previous frame to repeat
-            // so we mix the previously-mixed block
-
-            // this is preferable to not mixing it at all to avoid the harsh jump to silence
-
-            // we'll repeat the last block until it has a block to mix
-            // and we'll gradually fade that repeated block into silence.
-
-            // calculate its fade factor, which depends on how many times it's already been repeated.
-
-            repeatedFrameFadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
-            if (repeatedFrameFadeFactor > 0.0f) {
-                // apply the repeatedFrameFadeFactor to the gain
-                gain *= repeatedFrameFadeFactor;
-
-                forceSilentBlock = false;
-            }
-        }
-
-        if (forceSilentBlock) {
-            // we're deciding not to repeat either since we've already done it enough times or repetition with fade is disabled
-            // in this case we will call renderSilent with a forced silent block
-            // this ensures the correct tail from the previously mixed block and the correct spatialization of first block
-            // of any upcoming audio
-
-            if (!streamToAdd.isStereo() && !isEcho) {
-                // get the existing listener-source HRTF object, or create a new one
-                auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
-
-                // this is not done for stereo streams since they do not go through the HRTF
-                static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
-                hrtf.renderSilent(silentMonoBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
-                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-                ++_hrtfSilentRenders;;
-            }
-
-            return;
-        }
-    }
-
-    // grab the stream from the ring buffer
-    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
-
-    if (streamToAdd.isStereo() || isEcho) {
-        // this is a stereo source or server echo so we do not pass it through the HRTF
-        // simply apply our calculated gain to each sample
-        if (streamToAdd.isStereo()) {
-            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-                _mixedSamples[i] += float(streamPopOutput[i] * gain / AudioConstants::MAX_SAMPLE_VALUE);
-            }
-
-            ++_manualStereoMixes;
-        } else {
-            for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
-                auto monoSample = float(streamPopOutput[i / 2] * gain / AudioConstants::MAX_SAMPLE_VALUE);
-                _mixedSamples[i] += monoSample;
-                _mixedSamples[i + 1] += monoSample;
-            }
-
-            ++_manualEchoMixes;
-        }
-
-        return;
-    }
-
-    // get the existing listener-source HRTF object, or create a new one
-    auto& hrtf = listenerNodeData.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
-
-    static int16_t streamBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
-
-    streamPopOutput.readSamples(streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-    // if the frame we're about to mix is silent, simply call render silent and move on
-    if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
-        // silent frame from source
-
-        // we still need to call renderSilent via the HRTF for mono source
-        hrtf.renderSilent(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
-                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        ++_hrtfSilentRenders;
-
-        return;
-    }
-
-    if (_performanceThrottlingRatio > 0.0f
-        && streamToAdd.getLastPopOutputTrailingLoudness() / glm::length(relativePosition) <= _minAudibilityThreshold) {
-        // the mixer is struggling so we're going to drop off some streams
-
-        // we call renderSilent via the HRTF with the actual frame data and a gain of 0.0
-        hrtf.renderSilent(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, 0.0f,
-                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-
-        ++_hrtfStruggleRenders;
-
-        return;
-    }
-
-    ++_hrtfRenders;
-
-    // mono stream, call the HRTF with our block and calculated azimuth and gain
-    hrtf.render(streamBlock, _mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
-                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
-}
-
-bool AudioMixer::prepareMixForListeningNode(Node* node) {
-    AvatarAudioStream* nodeAudioStream = static_cast<AudioMixerClientData*>(node->getLinkedData())->getAvatarAudioStream();
-    AudioMixerClientData* listenerNodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
-
-    // zero out the client mix for this node
-    memset(_mixedSamples, 0, sizeof(_mixedSamples));
-
-    // loop through all other nodes that have sufficient audio to mix
-
-    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& otherNode){
-        if (otherNode->getLinkedData()) {
-            AudioMixerClientData* otherNodeClientData = (AudioMixerClientData*) otherNode->getLinkedData();
-
-            // enumerate the ARBs attached to the otherNode and add all that should be added to mix
-            auto streamsCopy = otherNodeClientData->getAudioStreams();
-
-            for (auto& streamPair : streamsCopy) {
-
-                auto otherNodeStream = streamPair.second;
-
-                if (*otherNode != *node || otherNodeStream->shouldLoopbackForNode()) {
-                    addStreamToMixForListeningNodeWithStream(*listenerNodeData, *otherNodeStream, otherNode->getUUID(),
-                                                             *nodeAudioStream);
-                }
-            }
-        }
-    });
-
-    int nonZeroSamples = 0;
-
-    // enumerate the mixed samples and clamp any samples outside the min/max
-    // also check if we ended up with a silent frame
-    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
-
-        _clampedSamples[i] = int16_t(glm::clamp(int(_mixedSamples[i] * AudioConstants::MAX_SAMPLE_VALUE),
-                                                AudioConstants::MIN_SAMPLE_VALUE,
-                                                AudioConstants::MAX_SAMPLE_VALUE));
-        if (_clampedSamples[i] != 0.0f) {
-            ++nonZeroSamples;
-        }
-    }
-
-    return (nonZeroSamples > 0);
-}
-
-void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
+void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node, udt::SendBatch& batch) {
     // Send stream properties
     bool hasReverb = false;
     float reverbTime, wetLevel;
-    // find reverb properties
-    for (int i = 0; i < _zoneReverbSettings.size(); ++i) {
+    // find reverb properties, unless the mixer renders the reverb of the zones itself
+    for (int i = 0; i < _zoneReverbSettings.size() && !_enableServerReverb; ++i) {
         AudioMixerClientData* data = static_cast<AudioMixerClientData*>(node->getLinkedData());
         glm::vec3 streamPosition = data->getAvatarAudioStream()->getPosition();
         AABox box = _audioZones[_zoneReverbSettings[i].zone];
@@ -414,7 +161,7 @@ void AudioMixer::sendAudioEnvironmentPacket(SharedNodePointer node) {
             envPacket->writePrimitive(reverbTime);
             envPacket->writePrimitive(wetLevel);
         }
-        nodeList->sendPacket(std::move(envPacket), *node);
+        nodeList->batchPacket(batch, std::move(envPacket), *node);
     }
 }
 
@@ -448,6 +195,53 @@ void AudioMixer::handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> mes
     }
 }
 
+void AudioMixer::handleNegotiateAudioFormat(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    quint8 numberOfCodecs = 0;
+    message->readPrimitive(&numberOfCodecs);
+
+    QStringList codecsOffered;
+    for (quint8 i = 0; i < numberOfCodecs; i++) {
+        codecsOffered << message->readString();
+    }
+
+    // pick the first codec in our preference order that the node offered and we have
+    AudioCodecPointer selectedCodec;
+    for (auto& codecName : _codecPreferenceOrder) {
+        if (codecsOffered.contains(codecName)) {
+            selectedCodec = AudioCodecs::getCodec(codecName);
+            if (selectedCodec) {
+                break;
+            }
+        }
+    }
+
+    QString selectedCodecName = selectedCodec ? selectedCodec->getName() : QString();
+    qDebug() << "Selected codec" << selectedCodecName << "for" << sendingNode->getUUID() << "from" << codecsOffered;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    {
+        QMutexLocker nodeLocker(&sendingNode->getMutex());
+
+        // the node's linked data is otherwise only created with its first audio packet, which may not have arrived
+        if (!sendingNode->getLinkedData() && nodeList->linkedDataCreateCallback) {
+            nodeList->linkedDataCreateCallback(sendingNode.data());
+        }
+
+        AudioMixerClientData* clientData = static_cast<AudioMixerClientData*>(sendingNode->getLinkedData());
+        if (clientData) {
+            QMutexLocker clientDataLocker(&clientData->getMutex());
+            clientData->setupCodec(selectedCodec);
+        }
+    }
+
+    // an empty name tells the node to keep sending uncompressed audio. The mixer has already switched codecs, so the
+    // reply is sent reliably, or a lost one would leave the node on a different codec than the mixer
+    auto replyPacket = NLPacket::create(PacketType::SelectedAudioFormat, -1, true);
+    replyPacket->writeString(selectedCodecName);
+    nodeList->sendPacket(std::move(replyPacket), *sendingNode);
+}
+
 void AudioMixer::handleNodeKilled(SharedNodePointer killedNode) {
     // enumerate the connected listeners to remove HRTF objects for the disconnected node
     auto nodeList = DependencyManager::get<NodeList>();
@@ -458,6 +252,10 @@ void AudioMixer::handleNodeKilled(SharedNodePointer killedNode) {
             clientData->removeHRTFsForNode(node->getUUID());
         }
     });
+
+    for (auto& cluster : _listenerClusters) {
+        cluster.second->getHRTFs().removeHRTFsForNode(killedNode->getUUID());
+    }
 }
 
 void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
@@ -472,12 +270,16 @@ void AudioMixer::removeHRTFsForFinishedInjector(const QUuid& streamID) {
                 listenerClientData->removeHRTFForStream(injectorClientData->getNodeID(), streamID);
             }
         });
+
+        for (auto& cluster : _listenerClusters) {
+            cluster.second->getHRTFs().removeHRTFForStream(injectorClientData->getNodeID(), streamID);
+        }
     }
 }
 
 QString AudioMixer::percentageForMixStats(int counter) {
-    if (_totalMixes > 0) {
-        float mixPercentage = (float(counter) / _totalMixes) * 100.0f;
+    if (_stats.totalMixes > 0) {
+        float mixPercentage = (float(counter) / _stats.totalMixes) * 100.0f;
         return QString::number(mixPercentage, 'f', 2);
     } else {
         return QString("0.0");
@@ -491,27 +293,66 @@ void AudioMixer::sendStatsPacket() {
     statsObject["trailing_sleep_percentage"] = _trailingSleepRatio * 100.0f;
     statsObject["performance_throttling_ratio"] = _performanceThrottlingRatio;
 
-    statsObject["avg_listeners_per_frame"] = (float) _sumListeners / (float) _numStatFrames;
+    // collect the mix stats from each of the workers
+    _stats.reset();
+
+    QJsonObject workerStats;
+    int workerIndex = 0;
+
+    _workerPool.each([&](AudioMixerWorker& worker) {
+        _stats.accumulate(worker.stats);
+        worker.stats.reset();
+
+        QJsonObject frameStats;
+        frameStats["avg_frame_usecs"] = worker.numFrames > 0 ? (double)worker.sumFrameUsecs / worker.numFrames : 0.0;
+        frameStats["max_frame_usecs"] = (double)worker.maxFrameUsecs;
+        worker.resetTimingStats();
+
+        workerStats[QString::number(workerIndex++)] = frameStats;
+    });
+
+    statsObject["num_threads"] = _workerPool.numThreads();
+    statsObject["thread_stats"] = workerStats;
+
+    statsObject["avg_listeners_per_frame"] = (float) _stats.sumListeners / (float) _numStatFrames;
+
+    statsObject["avg_datagrams_per_send_syscall"] = _sendBatch.getNumWriteSyscalls() > 0 ?
+        (float)_sendBatch.getNumWrittenDatagrams() / _sendBatch.getNumWriteSyscalls() : 0.0f;
+    _sendBatch.resetStats();
 
     QJsonObject mixStats;
-    mixStats["%_hrtf_mixes"] = percentageForMixStats(_hrtfRenders);
-    mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(_hrtfSilentRenders);
-    mixStats["%_hrtf_struggle_mixes"] = percentageForMixStats(_hrtfStruggleRenders);
-    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_manualStereoMixes);
-    mixStats["%_manual_echo_mixes"] = percentageForMixStats(_manualEchoMixes);
+    mixStats["%_hrtf_mixes"] = percentageForMixStats(_stats.hrtfRenders);
+    mixStats["%_hrtf_silent_mixes"] = percentageForMixStats(_stats.hrtfSilentRenders);
+    mixStats["%_hrtf_struggle_mixes"] = percentageForMixStats(_stats.hrtfStruggleRenders);
+    mixStats["%_manual_stereo_mixes"] = percentageForMixStats(_stats.manualStereoMixes);
+    mixStats["%_manual_echo_mixes"] = percentageForMixStats(_stats.manualEchoMixes);
+
+    mixStats["total_mixes"] = _stats.totalMixes;
+    mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
+
+    mixStats["max_sources_per_listener"] = _maxSourcesPerListener;
+    mixStats["avg_culled_streams_per_frame"] = (float) _stats.culledStreams / (float) _numStatFrames;
+    mixStats["avg_hrtf_fade_outs_per_frame"] = (float) _stats.hrtfFadeOuts / (float) _numStatFrames;
 
-    mixStats["total_mixes"] = _totalMixes;
-    mixStats["avg_mixes_per_block"] = _totalMixes / _numStatFrames;
+    mixStats["avg_listener_clusters_per_frame"] = (float) _stats.clusterMixes / (float) _numStatFrames;
+    mixStats["avg_clustered_listeners_per_frame"] = (float) _stats.clusteredListeners / (float) _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
-    _sumListeners = 0;
-    _hrtfRenders = 0;
-    _hrtfSilentRenders = 0;
-    _hrtfStruggleRenders = 0;
-    _manualStereoMixes = 0;
-    _manualEchoMixes = 0;
-    _totalMixes = 0;
+    if (!_zoneReverbs.empty()) {
+        QJsonObject zoneReverbStats;
+        for (auto& zoneReverb : _zoneReverbs) {
+            QJsonObject reverbStats;
+            reverbStats["avg_render_usecs_per_frame"] = zoneReverb->getAverageRenderUsecs();
+            reverbStats["rendered_frames"] = zoneReverb->getNumRenders();
+            zoneReverb->resetStats();
+
+            zoneReverbStats[zoneReverb->getZone()] = reverbStats;
+        }
+        statsObject["zone_reverb_stats"] = zoneReverbStats;
+    }
+
+    _stats.reset();
     _numStatFrames = 0;
 
     // add stats for each listerner
@@ -529,6 +370,13 @@ void AudioMixer::sendStatsPacket() {
 
             nodeStats["jitter"] = clientData->getAudioStreamStats();
 
+            QJsonObject codecStats;
+            codecStats["codec"] = clientData->getCodec() ? clientData->getCodec()->getName() : QString("none");
+            codecStats["avg_encode_usecs"] = clientData->getAverageEncodeUsecs();
+            codecStats["avg_decode_usecs"] = clientData->getAverageDecodeUsecs();
+            clientData->resetCodecStats();
+            nodeStats["codec"] = codecStats;
+
             listenerStats[uuidString] = nodeStats;
         }
     });
@@ -575,8 +423,6 @@ void AudioMixer::domainSettingsRequestComplete() {
 }
 
 void AudioMixer::broadcastMixes() {
-    auto nodeList = DependencyManager::get<NodeList>();
-
     int64_t nextFrame = 0;
     QElapsedTimer timer;
     timer.start();
@@ -639,91 +485,249 @@ void AudioMixer::broadcastMixes() {
             ++framesSinceCutoffEvent;
         }
 
-        nodeList->eachNode([&](const SharedNodePointer& node) {
+        AudioMixerWorker::Sources sources;
+        AudioMixerWorkerPool::Listeners listeners;
+        AudioMixerWorkerPool::MixPackets mixPackets;
+        AudioMixerWorkerPool::Clusters clusters;
 
-            if (node->getLinkedData()) {
-                AudioMixerClientData* nodeData = (AudioMixerClientData*)node->getLinkedData();
+        prepareFrame(sources, listeners);
 
-                // this function will attempt to pop a frame from each audio stream.
-                // a pointer to the popped data is stored as a member in InboundAudioStream.
-                // That's how the popped audio data will be read for mixing (but only if the pop was successful)
-                nodeData->checkBuffersBeforeFrameSend();
+        renderZoneReverbs(sources);
 
-                // if the stream should be muted, send mute packet
-                if (nodeData->getAvatarAudioStream()
-                    && shouldMute(nodeData->getAvatarAudioStream()->getQuietestFrameLoudness())) {
-                    auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
-                    nodeList->sendPacket(std::move(mutePacket), *node);
-                }
+        // listeners standing together share a mix
+        size_t numSoloListeners = clusterListeners(listeners, clusters);
 
-                if (node->getType() == NodeType::Agent && node->getActiveSocket()
-                    && nodeData->getAvatarAudioStream()) {
+        // mix each listener, potentially on several threads
+        _workerPool.mix(listeners, numSoloListeners, clusters, sources, mixPackets);
 
-                    bool mixHasAudio = prepareMixForListeningNode(node.data());
+        sendMixes(listeners, mixPackets, nextFrame);
+
+        ++_numStatFrames;
 
-                    std::unique_ptr<NLPacket> mixPacket;
+        // since we're a while loop we need to help Qt's event processing
+        QCoreApplication::processEvents();
 
-                    if (mixHasAudio) {
-                        int mixPacketBytes = sizeof(quint16) + AudioConstants::NETWORK_FRAME_BYTES_STEREO;
-                        mixPacket = NLPacket::create(PacketType::MixedAudio, mixPacketBytes);
+        if (_isFinished) {
+            // at this point the audio-mixer is done
+            // check if we have a deferred delete event to process (which we should once finished)
+            QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
+            break;
+        }
 
-                        // pack sequence number
-                        quint16 sequence = nodeData->getOutgoingSequenceNumber();
-                        mixPacket->writePrimitive(sequence);
+        usecToSleep = (++nextFrame * AudioConstants::NETWORK_FRAME_USECS) - (timer.nsecsElapsed() / 1000);
 
-                        // pack mixed audio samples
-                        mixPacket->write(reinterpret_cast<char*>(_clampedSamples),
-                                         AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                    } else {
-                        int silentPacketBytes = sizeof(quint16) + sizeof(quint16);
-                        mixPacket = NLPacket::create(PacketType::SilentAudioFrame, silentPacketBytes);
+        if (usecToSleep > 0) {
+            usleep(usecToSleep);
+        }
+    }
+}
 
-                        // pack sequence number
-                        quint16 sequence = nodeData->getOutgoingSequenceNumber();
-                        mixPacket->writePrimitive(sequence);
+void AudioMixer::prepareFrame(AudioMixerWorker::Sources& sources, AudioMixerWorkerPool::Listeners& listeners) {
+    auto nodeList = DependencyManager::get<NodeList>();
 
-                        // pack number of silent audio samples
-                        quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
-                        mixPacket->writePrimitive(numSilentSamples);
-                    }
+    nodeList->eachNode([&](const SharedNodePointer& node) {
 
-                    // Send audio environment
-                    sendAudioEnvironmentPacket(node);
+        if (node->getLinkedData()) {
+            AudioMixerClientData* nodeData = (AudioMixerClientData*)node->getLinkedData();
 
-                    // send mixed audio packet
-                    nodeList->sendPacket(std::move(mixPacket), *node);
-                    nodeData->incrementOutgoingMixedAudioSequenceNumber();
+            // this function will attempt to pop a frame from each audio stream.
+            // a pointer to the popped data is stored as a member in InboundAudioStream.
+            // That's how the popped audio data will be read for mixing (but only if the pop was successful)
+            nodeData->checkBuffersBeforeFrameSend();
 
-                    static const int FRAMES_PER_SECOND = int(ceilf(1.0f / AudioConstants::NETWORK_FRAME_SECS));
+            // if the stream should be muted, send mute packet
+            if (nodeData->getAvatarAudioStream()
+                && shouldMute(nodeData->getAvatarAudioStream()->getQuietestFrameLoudness())) {
+                auto mutePacket = NLPacket::create(PacketType::NoisyMute, 0);
+                nodeList->sendPacket(std::move(mutePacket), *node);
+            }
 
-                    // send an audio stream stats packet to the client approximately every second
-                    if (nextFrame % FRAMES_PER_SECOND == 0) {
-                        nodeData->sendAudioStreamStatsPackets(node);
-                    }
+            // grab the streams once for this frame, every listener will mix from this copy
+            sources.push_back({ node, nodeData->getAudioStreams() });
 
-                    ++_sumListeners;
+            if (node->getType() == NodeType::Agent && node->getActiveSocket()
+                && nodeData->getAvatarAudioStream()) {
+                listeners.push_back(node);
+            }
+        }
+    });
+}
+
+void AudioMixer::renderZoneReverbs(const AudioMixerWorker::Sources& sources) {
+    for (auto& zoneReverb : _zoneReverbs) {
+        const AABox& zoneBox = _audioZones[zoneReverb->getZone()];
+
+        for (auto& source : sources) {
+            for (auto& streamPair : source.streams) {
+                const PositionalAudioStream& stream = *streamPair.second;
+
+                if (zoneBox.contains(stream.getPosition())) {
+                    float gain = 1.0f;
+                    if (stream.getType() == PositionalAudioStream::Injector) {
+                        gain = static_cast<const InjectedAudioStream&>(stream).getAttenuationRatio();
+                    }
+                    zoneReverb->addSource(stream, gain);
                 }
             }
-        });
+        }
 
-        ++_numStatFrames;
+        zoneReverb->render();
+    }
+}
 
-        // since we're a while loop we need to help Qt's event processing
-        QCoreApplication::processEvents();
+const AudioMixerZoneReverb* AudioMixer::zoneReverbForPosition(const glm::vec3& position) const {
+    for (auto& zoneReverb : _zoneReverbs) {
+        if (_audioZones[zoneReverb->getZone()].contains(position)) {
+            return zoneReverb.get();
+        }
+    }
+    return nullptr;
+}
 
-        if (_isFinished) {
-            // at this point the audio-mixer is done
-            // check if we have a deferred delete event to process (which we should once finished)
-            QCoreApplication::sendPostedEvents(this, QEvent::DeferredDelete);
+size_t AudioMixer::clusterListeners(AudioMixerWorkerPool::Listeners& listeners, AudioMixerWorkerPool::Clusters& clusters) {
+    clusters.clear();
+
+    if (!_enableListenerClustering) {
+        _listenerClusters.clear();
+        return listeners.size();
+    }
+
+    using ListenerGroups = std::unordered_map<AudioMixerListenerCluster::Key, AudioMixerWorkerPool::Listeners,
+                                              AudioMixerListenerCluster::KeyHasher>;
+    ListenerGroups groups;
+    AudioMixerWorkerPool::Listeners soloListeners;
+
+    for (auto& listener : listeners) {
+        AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
+        if (canClusterListener(*listenerData)) {
+            groups[clusterKeyForListener(*listenerData)].push_back(listener);
+        } else {
+            soloListeners.push_back(listener);
+        }
+    }
+
+    // a listener with nobody to share a mix with is mixed on its own
+    const size_t MIN_LISTENERS_PER_CLUSTER = 2;
+    for (auto it = groups.begin(); it != groups.end();) {
+        if (it->second.size() < MIN_LISTENERS_PER_CLUSTER) {
+            soloListeners.insert(soloListeners.end(), it->second.begin(), it->second.end());
+            it = groups.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    listeners = std::move(soloListeners);
+    size_t numSoloListeners = listeners.size();
+
+    ListenerClusterMap listenerClusters;
+
+    for (auto& group : groups) {
+        // reuse the cluster with this key from the last frame, so the HRTFs of its sources keep their state
+        std::unique_ptr<AudioMixerListenerCluster> cluster;
+        auto existingCluster = _listenerClusters.find(group.first);
+        if (existingCluster != _listenerClusters.end()) {
+            cluster = std::move(existingCluster->second);
+        } else {
+            cluster.reset(new AudioMixerListenerCluster());
+        }
+
+        auto& members = group.second;
+
+        cluster->firstListener = listeners.size();
+        cluster->numListeners = members.size();
+        cluster->memberIndices.clear();
+
+        glm::vec3 positionSum { 0.0f };
+        for (size_t i = 0; i < members.size(); ++i) {
+            AudioMixerClientData* memberData = static_cast<AudioMixerClientData*>(members[i]->getLinkedData());
+            positionSum += memberData->getAvatarAudioStream()->getPosition();
+
+            cluster->memberIndices[members[i]->getUUID()] = (int)i;
+            listeners.push_back(members[i]);
+        }
+
+        AudioMixerClientData* firstMemberData = static_cast<AudioMixerClientData*>(members.front()->getLinkedData());
+        cluster->position = positionSum / (float)members.size();
+        cluster->orientation = firstMemberData->getAvatarAudioStream()->getOrientation();
+
+        // the members all negotiated the same codec, frames without a codec are sent as they are
+        auto& codec = firstMemberData->getCodec();
+        cluster->canShareEncodedFrames = !codec || codec->hasIndependentFrames();
+
+        clusters.push_back(cluster.get());
+        listenerClusters.emplace(group.first, std::move(cluster));
+    }
+
+    // the clusters left without members are dropped
+    _listenerClusters = std::move(listenerClusters);
+
+    return numSoloListeners;
+}
+
+bool AudioMixer::canClusterListener(AudioMixerClientData& listenerData) {
+    // the mix of a cluster leaves out every stream of its members, so a listener who hears itself needs its own mix
+    for (auto& streamPair : listenerData.getAudioStreams()) {
+        if (streamPair.second->shouldLoopbackForNode()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+AudioMixerListenerCluster::Key AudioMixer::clusterKeyForListener(AudioMixerClientData& listenerData) {
+    AvatarAudioStream* stream = listenerData.getAvatarAudioStream();
+    glm::vec3 position = stream->getPosition();
+    glm::vec3 front = stream->getOrientation() * Vectors::FRONT;
+
+    AudioMixerListenerCluster::Key key;
+    key.cell = glm::ivec3(glm::floor(position / _listenerClusterDistance));
+
+    float yaw = glm::degrees(atan2f(-front.x, -front.z));
+    float pitch = glm::degrees(asinf(glm::clamp(front.y, -1.0f, 1.0f)));
+    key.yawBucket = (int)floorf(yaw / _listenerClusterAngle);
+    key.pitchBucket = (int)floorf(pitch / _listenerClusterAngle);
+
+    // zones change the attenuation of sources, so listeners in different zones hear different mixes
+    for (auto it = _audioZones.cbegin(); it != _audioZones.cend(); ++it) {
+        if (it.value().contains(position)) {
+            key.zone = it.key();
             break;
         }
+    }
 
-        usecToSleep = (++nextFrame * AudioConstants::NETWORK_FRAME_USECS) - (timer.nsecsElapsed() / 1000);
+    if (listenerData.getCodec()) {
+        key.codec = listenerData.getCodec()->getName();
+    }
 
-        if (usecToSleep > 0) {
-            usleep(usecToSleep);
+    return key;
+}
+
+void AudioMixer::sendMixes(const AudioMixerWorkerPool::Listeners& listeners, AudioMixerWorkerPool::MixPackets& mixPackets,
+                           int64_t frame) {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        const SharedNodePointer& node = listeners[i];
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+
+        // Send audio environment
+        sendAudioEnvironmentPacket(node, _sendBatch);
+
+        // send mixed audio packet
+        nodeList->batchPacket(_sendBatch, std::move(mixPackets[i]), *node);
+        nodeData->incrementOutgoingMixedAudioSequenceNumber();
+
+        static const int FRAMES_PER_SECOND = int(ceilf(1.0f / AudioConstants::NETWORK_FRAME_SECS));
+
+        // send an audio stream stats packet to the client approximately every second
+        if (frame % FRAMES_PER_SECOND == 0) {
+            nodeData->sendAudioStreamStatsPackets(node);
         }
     }
+
+    // put the packets of every listener on the wire together
+    nodeList->sendBatch(_sendBatch);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
@@ -792,6 +796,18 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
         }
     }
 
+    if (settingsObject.contains(AUDIO_THREADING_GROUP_KEY)) {
+        QJsonObject audioThreadingGroupObject = settingsObject[AUDIO_THREADING_GROUP_KEY].toObject();
+
+        const QString NUM_THREADS_JSON_KEY = "num_threads";
+        bool ok;
+        int numThreads = audioThreadingGroupObject[NUM_THREADS_JSON_KEY].toString().toInt(&ok);
+        if (ok && numThreads > 0) {
+            _workerPool.setNumThreads(numThreads);
+        }
+        qDebug() << "Mixing threads:" << _workerPool.numThreads();
+    }
+
     if (settingsObject.contains(AUDIO_ENV_GROUP_KEY)) {
         QJsonObject audioEnvGroupObject = settingsObject[AUDIO_ENV_GROUP_KEY].toObject();
 
@@ -815,6 +831,16 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             }
         }
 
+        const QString MAX_SOURCES_PER_LISTENER = "max_sources_per_listener";
+        if (audioEnvGroupObject[MAX_SOURCES_PER_LISTENER].isString()) {
+            bool ok = false;
+            int maxSources = audioEnvGroupObject[MAX_SOURCES_PER_LISTENER].toString().toInt(&ok);
+            if (ok && maxSources >= 0) {
+                _maxSourcesPerListener = maxSources;
+                qDebug() << "Max sources per listener changed to" << _maxSourcesPerListener;
+            }
+        }
+
         const QString FILTER_KEY = "enable_filter";
         if (audioEnvGroupObject[FILTER_KEY].isBool()) {
             _enableFilter = audioEnvGroupObject[FILTER_KEY].toBool();
@@ -823,6 +849,52 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
             qDebug() << "Filter enabled";
         }
 
+        const QString SERVER_REVERB = "enable_server_reverb";
+        if (audioEnvGroupObject[SERVER_REVERB].isBool()) {
+            _enableServerReverb = audioEnvGroupObject[SERVER_REVERB].toBool();
+        }
+
+        const QString LISTENER_CLUSTERING = "enable_listener_clustering";
+        if (audioEnvGroupObject[LISTENER_CLUSTERING].isBool()) {
+            _enableListenerClustering = audioEnvGroupObject[LISTENER_CLUSTERING].toBool();
+        }
+
+        const QString LISTENER_CLUSTER_DISTANCE = "listener_cluster_distance";
+        if (audioEnvGroupObject[LISTENER_CLUSTER_DISTANCE].isString()) {
+            bool ok = false;
+            float distance = audioEnvGroupObject[LISTENER_CLUSTER_DISTANCE].toString().toFloat(&ok);
+            if (ok && distance > 0.0f) {
+                _listenerClusterDistance = distance;
+            }
+        }
+
+        const QString LISTENER_CLUSTER_ANGLE = "listener_cluster_angle";
+        if (audioEnvGroupObject[LISTENER_CLUSTER_ANGLE].isString()) {
+            bool ok = false;
+            float angle = audioEnvGroupObject[LISTENER_CLUSTER_ANGLE].toString().toFloat(&ok);
+            if (ok && angle > 0.0f) {
+                _listenerClusterAngle = angle;
+            }
+        }
+
+        if (_enableListenerClustering) {
+            qDebug() << "Listeners within" << _listenerClusterDistance << "meters and" << _listenerClusterAngle
+                << "degrees of each other will share a mix";
+        }
+
+        const QString CODEC_PREFERENCE_ORDER = "codec_preference_order";
+        if (audioEnvGroupObject[CODEC_PREFERENCE_ORDER].isString()) {
+            QStringList codecPreferenceOrder;
+            for (auto& codecName : audioEnvGroupObject[CODEC_PREFERENCE_ORDER].toString().split(",")) {
+                codecName = codecName.trimmed();
+                if (!codecName.isEmpty()) {
+                    codecPreferenceOrder << codecName;
+                }
+            }
+            _codecPreferenceOrder = codecPreferenceOrder;
+        }
+        qDebug() << "Codec preference order:" << _codecPreferenceOrder;
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -928,5 +1000,13 @@ void AudioMixer::parseSettingsObject(const QJsonObject &settingsObject) {
                 }
             }
         }
+
+        _zoneReverbs.clear();
+        if (_enableServerReverb) {
+            for (auto& settings : _zoneReverbSettings) {
+                _zoneReverbs.emplace_back(new AudioMixerZoneReverb(settings.zone, settings.reverbTime, settings.wetLevel));
+            }
+            qDebug() << "The reverb of" << _zoneReverbs.size() << "zones will be rendered by the mixer";
+        }
     }
 }
@@ -17,6 +17,11 @@
 #include <AudioRingBuffer.h>
 #include <ThreadedAssignment.h>
 #include <UUIDHasher.h>
+#include <udt/SendBatch.h>
+
+#include "AudioMixerListenerCluster.h"
+#include "AudioMixerZoneReverb.h"
+#include "AudioMixerWorkerPool.h"
 
 class PositionalAudioStream;
 class AvatarAudioStream;
@@ -45,6 +50,7 @@ private slots:
     void broadcastMixes();
     void handleNodeAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleNegotiateAudioFormat(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
 
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
@@ -52,47 +58,46 @@ private slots:
 private:
     void domainSettingsRequestComplete();
     
-    /// adds one stream to the mix for a listening node
-    void addStreamToMixForListeningNodeWithStream(AudioMixerClientData& listenerNodeData,
-                                                  const PositionalAudioStream& streamToAdd,
-                                                  const QUuid& sourceNodeID,
-                                                  const AvatarAudioStream& listeningNodeStream);
-
-    float gainForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                        const glm::vec3& relativePosition, bool isEcho);
-    float azimuthForSource(const PositionalAudioStream& streamToAdd, const AvatarAudioStream& listeningNodeStream,
-                           const glm::vec3& relativePosition);
-
-    /// prepares and sends a mix to one Node
-    bool prepareMixForListeningNode(Node* node);
-
     /// Send Audio Environment packet for a single node
-    void sendAudioEnvironmentPacket(SharedNodePointer node);
+    void sendAudioEnvironmentPacket(SharedNodePointer node, udt::SendBatch& batch);
 
     void perSecondActions();
 
     QString percentageForMixStats(int counter);
 
+    // pops a frame from each stream and collects the sources and listeners for this frame
+    void prepareFrame(AudioMixerWorker::Sources& sources, AudioMixerWorkerPool::Listeners& listeners);
+
+    // renders the reverb of each zone from the sources in it, before the listeners are mixed
+    void renderZoneReverbs(const AudioMixerWorker::Sources& sources);
+
+    // returns the reverb rendered for the zone a listener at the given position is in, or nullptr if there is none
+    const AudioMixerZoneReverb* zoneReverbForPosition(const glm::vec3& position) const;
+
+    // groups the listeners that can share a mix into clusters, and moves them after the listeners mixed on their own
+    // returns the number of listeners mixed on their own
+    size_t clusterListeners(AudioMixerWorkerPool::Listeners& listeners, AudioMixerWorkerPool::Clusters& clusters);
+    bool canClusterListener(AudioMixerClientData& listenerData);
+    AudioMixerListenerCluster::Key clusterKeyForListener(AudioMixerClientData& listenerData);
+
+    // sends the mixes produced by the worker pool for this frame
+    void sendMixes(const AudioMixerWorkerPool::Listeners& listeners, AudioMixerWorkerPool::MixPackets& mixPackets,
+                   int64_t frame);
+
     bool shouldMute(float quietestFrame);
 
     void parseSettingsObject(const QJsonObject& settingsObject);
 
+    friend class AudioMixerWorker;
+
     float _trailingSleepRatio;
     float _minAudibilityThreshold;
     float _performanceThrottlingRatio;
     float _attenuationPerDoublingInDistance;
+    int _maxSourcesPerListener { 0 }; // the most audible streams mixed for each listener, 0 mixes them all
     float _noiseMutingThreshold;
     int _numStatFrames { 0 };
-    int _sumListeners { 0 };
-    int _hrtfRenders { 0 };
-    int _hrtfSilentRenders { 0 };
-    int _hrtfStruggleRenders { 0 };
-    int _manualStereoMixes { 0 };
-    int _manualEchoMixes { 0 };
-    int _totalMixes { 0 };
-
-    float _mixedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
-    int16_t _clampedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    AudioMixerStats _stats;
 
     QHash<QString, AABox> _audioZones;
     struct ZonesSettings {
@@ -108,6 +113,22 @@ private:
     };
     QVector<ReverbSettings> _zoneReverbSettings;
 
+    bool _enableServerReverb { false };
+    std::vector<std::unique_ptr<AudioMixerZoneReverb>> _zoneReverbs; // rendered by the mixer when server reverb is enabled
+
+    QStringList _codecPreferenceOrder; // the codecs we will agree to, best first
+
+    bool _enableListenerClustering { false };
+    float _listenerClusterDistance; // meters
+    float _listenerClusterAngle; // degrees
+    using ListenerClusterMap = std::unordered_map<AudioMixerListenerCluster::Key, std::unique_ptr<AudioMixerListenerCluster>,
+                                                  AudioMixerListenerCluster::KeyHasher>;
+    ListenerClusterMap _listenerClusters; // the clusters of the last frame
+
+    udt::SendBatch _sendBatch; // the environment and mix packets of a frame, sent together
+
+    AudioMixerWorkerPool _workerPool;
+
     static InboundAudioStream::Settings _streamSettings;
 
     static bool _enableFilter;
@@ -10,6 +10,7 @@
 //
 
 #include <QtCore/QDebug>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonArray>
 
 #include <udt/PacketHeaders.h>
@@ -41,7 +42,18 @@ AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
     return NULL;
 }
 
-void AudioMixerClientData::removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID) {
+AudioHRTF* ListenerHRTFs::findHRTFForStream(const QUuid& nodeID, const QUuid& streamID) {
+    auto nodeIt = _nodeSourcesHRTFMap.find(nodeID);
+    if (nodeIt != _nodeSourcesHRTFMap.end()) {
+        auto streamIt = nodeIt->second.find(streamID);
+        if (streamIt != nodeIt->second.end()) {
+            return &streamIt->second;
+        }
+    }
+    return nullptr;
+}
+
+void ListenerHRTFs::removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID) {
     auto it = _nodeSourcesHRTFMap.find(nodeID);
     if (it != _nodeSourcesHRTFMap.end()) {
         // erase the stream with the given ID from the given node
@@ -91,9 +103,14 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
 
                 bool isStereo = channelFlag == 1;
 
+                auto avatarAudioStream = new AvatarAudioStream(isStereo, AudioMixer::getStreamSettings());
+                if (_codec) {
+                    avatarAudioStream->setupCodec(_codec, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
+                }
+
                 auto emplaced = _audioStreams.emplace(
                     QUuid(),
-                    std::unique_ptr<PositionalAudioStream> { new AvatarAudioStream(isStereo, AudioMixer::getStreamSettings()) }
+                    std::unique_ptr<PositionalAudioStream> { avatarAudioStream }
                 );
 
                 micStreamIt = emplaced.first;
@@ -150,6 +167,50 @@ int AudioMixerClientData::parseData(ReceivedMessage& message) {
     return 0;
 }
 
+void AudioMixerClientData::setupCodec(AudioCodecPointer codec) {
+    _codec = codec;
+
+    // mixes are always stereo
+    _encoder = codec ? codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO) : nullptr;
+
+    auto avatarAudioStream = getAvatarAudioStream();
+    if (avatarAudioStream) {
+        avatarAudioStream->setupCodec(codec, avatarAudioStream->isStereo() ? AudioConstants::STEREO : AudioConstants::MONO);
+    }
+
+    resetCodecStats();
+}
+
+void AudioMixerClientData::encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
+    if (!_encoder) {
+        encodedBuffer = decodedBuffer;
+        return;
+    }
+
+    QElapsedTimer encodeTimer;
+    encodeTimer.start();
+
+    _encoder->encode(decodedBuffer, encodedBuffer);
+
+    _encodeNsecs += encodeTimer.nsecsElapsed();
+    ++_numEncodes;
+}
+
+float AudioMixerClientData::getAverageDecodeUsecs() {
+    auto avatarAudioStream = getAvatarAudioStream();
+    return avatarAudioStream ? avatarAudioStream->getAverageDecodeUsecs() : 0.0f;
+}
+
+void AudioMixerClientData::resetCodecStats() {
+    _encodeNsecs = 0;
+    _numEncodes = 0;
+
+    auto avatarAudioStream = getAvatarAudioStream();
+    if (avatarAudioStream) {
+        avatarAudioStream->resetDecodeStats();
+    }
+}
+
 void AudioMixerClientData::checkBuffersBeforeFrameSend() {
     QWriteLocker writeLocker { &_streamsLock };
 
@@ -15,12 +15,35 @@
 #include <QtCore/QJsonObject>
 
 #include <AABox.h>
+#include <AudioCodec.h>
 #include <AudioHRTF.h>
 #include <UUIDHasher.h>
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
 
+/// The HRTF objects a listener renders its sources with, one for each stream of each source node.
+/// They carry the filter state of a source from one frame to the next.
+class ListenerHRTFs {
+public:
+    // returns a new or existing HRTF object for the given stream from the given node
+    AudioHRTF& hrtfForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) { return _nodeSourcesHRTFMap[nodeID][streamID]; }
+
+    // returns the existing HRTF object for the given stream from the given node, or nullptr if there is none
+    AudioHRTF* findHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
+
+    // remove HRTFs for all sources from this node
+    void removeHRTFsForNode(const QUuid& nodeID) { _nodeSourcesHRTFMap.erase(nodeID); }
+
+    // removes an AudioHRTF object for a given stream
+    void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
+
+private:
+    using HRTFMap = std::unordered_map<QUuid, AudioHRTF>;
+    using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
+    NodeSourcesHRTFMap _nodeSourcesHRTFMap;
+};
+
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
 public:
@@ -36,14 +59,16 @@ public:
     // the following methods should be called from the AudioMixer assignment thread ONLY
     // they are not thread-safe
 
+    ListenerHRTFs& getHRTFs() { return _hrtfs; }
+
     // returns a new or existing HRTF object for the given stream from the given node
-    AudioHRTF& hrtfForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) { return _nodeSourcesHRTFMap[nodeID][streamID]; }
+    AudioHRTF& hrtfForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) { return _hrtfs.hrtfForStream(nodeID, streamID); }
 
     // remove HRTFs for all sources from this node
-    void removeHRTFsForNode(const QUuid& nodeID) { _nodeSourcesHRTFMap.erase(nodeID); }
+    void removeHRTFsForNode(const QUuid& nodeID) { _hrtfs.removeHRTFsForNode(nodeID); }
 
     // removes an AudioHRTF object for a given stream
-    void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid());
+    void removeHRTFForStream(const QUuid& nodeID, const QUuid& streamID = QUuid()) { _hrtfs.removeHRTFForStream(nodeID, streamID); }
     
     int parseData(ReceivedMessage& message);
 
@@ -58,6 +83,18 @@ public:
     void incrementOutgoingMixedAudioSequenceNumber() { _outgoingMixedAudioSequenceNumber++; }
     quint16 getOutgoingSequenceNumber() const { return _outgoingMixedAudioSequenceNumber; }
 
+    // sets the codec negotiated with this node, its mixes are encoded and its microphone stream decoded with it
+    void setupCodec(AudioCodecPointer codec);
+    const AudioCodecPointer& getCodec() const { return _codec; }
+
+    // encodes a mix for this node, called by the worker mixing for it
+    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer);
+
+    // time spent encoding mixes and decoding the microphone stream for this node, since the last reset
+    float getAverageEncodeUsecs() const { return _numEncodes > 0 ? (float)_encodeNsecs / (_numEncodes * NSECS_PER_USEC) : 0.0f; }
+    float getAverageDecodeUsecs();
+    void resetCodecStats();
+
 signals:
     void injectorStreamFinished(const QUuid& streamIdentifier);
 
@@ -65,13 +102,16 @@ private:
     QReadWriteLock _streamsLock;
     AudioStreamMap _audioStreams; // microphone stream from avatar is stored under key of null UUID
 
-    using HRTFMap = std::unordered_map<QUuid, AudioHRTF>;
-    using NodeSourcesHRTFMap = std::unordered_map<QUuid, HRTFMap>;
-    NodeSourcesHRTFMap _nodeSourcesHRTFMap;
+    ListenerHRTFs _hrtfs;
 
     quint16 _outgoingMixedAudioSequenceNumber;
 
     AudioStreamStats _downstreamAudioStreamStats;
+
+    AudioCodecPointer _codec;
+    std::unique_ptr<AudioEncoder> _encoder;
+    quint64 _encodeNsecs { 0 };
+    int _numEncodes { 0 };
 };
 
 #endif // hifi_AudioMixerClientData_h
@@ -0,0 +1,79 @@
+//
+//  AudioMixerListenerCluster.h
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerListenerCluster_h
+#define hifi_AudioMixerListenerCluster_h
+
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+#include <UUIDHasher.h>
+
+#include "AudioMixerClientData.h"
+
+/// Listeners standing close together and facing the same way, whose mix is rendered once for all of them.
+/// A cluster outlives the frame it was formed in for as long as it keeps members, so the HRTFs its sources are
+/// rendered with carry their state from frame to frame like those of a single listener.
+class AudioMixerListenerCluster {
+public:
+    // listeners with the same key share a cluster
+    struct Key {
+        glm::ivec3 cell;
+        int yawBucket;
+        int pitchBucket;
+        QString zone;
+        QString codec;
+
+        bool operator==(const Key& other) const {
+            return cell == other.cell && yawBucket == other.yawBucket && pitchBucket == other.pitchBucket
+                && zone == other.zone && codec == other.codec;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const {
+            size_t hash = qHash(key.zone) ^ (qHash(key.codec) << 1);
+            hash = hash * 31 + (size_t)key.cell.x;
+            hash = hash * 31 + (size_t)key.cell.y;
+            hash = hash * 31 + (size_t)key.cell.z;
+            hash = hash * 31 + (size_t)key.yawBucket;
+            hash = hash * 31 + (size_t)key.pitchBucket;
+            return hash;
+        }
+    };
+
+    ListenerHRTFs& getHRTFs() { return _hrtfs; }
+
+    // the following are set by the mixer every frame, before the cluster is mixed
+
+    // the members are listeners [firstListener, firstListener + numListeners) of the frame
+    size_t firstListener { 0 };
+    size_t numListeners { 0 };
+
+    // maps the node ID of each member to its index in the cluster
+    std::unordered_map<QUuid, int> memberIndices;
+
+    // the mix is heard from the middle of the members, facing the way the first member faces
+    glm::vec3 position;
+    glm::quat orientation;
+
+    // true when every member can be sent the same encoded frame
+    bool canShareEncodedFrames { false };
+
+private:
+    ListenerHRTFs _hrtfs;
+};
+
+#endif // hifi_AudioMixerListenerCluster_h
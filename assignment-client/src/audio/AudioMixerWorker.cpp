@@ -0,0 +1,537 @@
+//
+//  AudioMixerWorker.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+#include <limits>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/norm.hpp>
+#include <glm/gtx/vector_angle.hpp>
+
+#include <AudioMixKernels.h>
+#include <udt/PacketHeaders.h>
+#include <SharedUtil.h>
+
+#include "AudioMixer.h"
+#include "AvatarAudioStream.h"
+#include "InjectedAudioStream.h"
+
+#include "AudioMixerWorker.h"
+
+void AudioMixerStats::reset() {
+    sumListeners = 0;
+    totalMixes = 0;
+    hrtfRenders = 0;
+    hrtfSilentRenders = 0;
+    hrtfStruggleRenders = 0;
+    manualStereoMixes = 0;
+    manualEchoMixes = 0;
+    clusterMixes = 0;
+    clusteredListeners = 0;
+    culledStreams = 0;
+    hrtfFadeOuts = 0;
+}
+
+void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
+    sumListeners += otherStats.sumListeners;
+    totalMixes += otherStats.totalMixes;
+    hrtfRenders += otherStats.hrtfRenders;
+    hrtfSilentRenders += otherStats.hrtfSilentRenders;
+    hrtfStruggleRenders += otherStats.hrtfStruggleRenders;
+    manualStereoMixes += otherStats.manualStereoMixes;
+    manualEchoMixes += otherStats.manualEchoMixes;
+    clusterMixes += otherStats.clusterMixes;
+    clusteredListeners += otherStats.clusteredListeners;
+    culledStreams += otherStats.culledStreams;
+    hrtfFadeOuts += otherStats.hrtfFadeOuts;
+}
+
+const float ATTENUATION_BEGINS_AT_DISTANCE = 1.0f;
+
+static const int HRTF_DATASET_INDEX = 1;
+
+float AudioMixerWorker::attenuationPerDoublingForSource(const PositionalAudioStream& streamToAdd,
+                                                        const ListenerPose& listener) {
+    for (int i = 0; i < _mixer._zonesSettings.length(); ++i) {
+        if (_mixer._audioZones[_mixer._zonesSettings[i].source].contains(streamToAdd.getPosition()) &&
+            _mixer._audioZones[_mixer._zonesSettings[i].listener].contains(listener.position)) {
+            return _mixer._zonesSettings[i].coefficient;
+        }
+    }
+    return _mixer._attenuationPerDoublingInDistance;
+}
+
+float AudioMixerWorker::audibilityForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener,
+                                            bool isEcho) {
+    if (isEcho) {
+        // a listener always hears itself when it asked to
+        return std::numeric_limits<float>::max();
+    }
+
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listener.position;
+    float distanceSquared = glm::max(glm::length2(relativePosition),
+                                     ATTENUATION_BEGINS_AT_DISTANCE * ATTENUATION_BEGINS_AT_DISTANCE);
+
+    // sources heard through a zone that attenuates them faster rank lower
+    float distanceCoefficient = 1.0f - (0.5f * logf(distanceSquared) / logf(2.0f)
+                                        * attenuationPerDoublingForSource(streamToAdd, listener));
+    distanceCoefficient = glm::max(distanceCoefficient, 0.0f);
+
+    return streamToAdd.getLastPopOutputTrailingLoudness() * distanceCoefficient / distanceSquared;
+}
+
+size_t AudioMixerWorker::cullInaudibleStreams(StreamsToMix& streams, const ListenerPose& listener) {
+    size_t maxStreams = (size_t)_mixer._maxSourcesPerListener;
+    if (maxStreams == 0 || streams.size() <= maxStreams) {
+        return streams.size();
+    }
+
+    for (auto& streamToMix : streams) {
+        streamToMix.audibility = audibilityForSource(*streamToMix.stream, listener, streamToMix.isEcho);
+    }
+
+    std::nth_element(streams.begin(), streams.begin() + maxStreams, streams.end(),
+                     [](const StreamToMix& a, const StreamToMix& b) { return a.audibility > b.audibility; });
+
+    stats.culledStreams += (int)(streams.size() - maxStreams);
+
+    return maxStreams;
+}
+
+void AudioMixerWorker::fadeOutStream(ListenerHRTFs& listenerHRTFs, const StreamToMix& streamToFade,
+                                     const ListenerPose& listener, float* mixedSamples) {
+    const PositionalAudioStream& stream = *streamToFade.stream;
+
+    // stereo and echo streams are mixed without an HRTF, so there is nothing to fade
+    AudioHRTF* hrtf = listenerHRTFs.findHRTFForStream(streamToFade.nodeID, stream.getStreamIdentifier());
+    if (!hrtf) {
+        return;
+    }
+
+    glm::vec3 relativePosition = stream.getPosition() - listener.position;
+    float azimuth = azimuthForSource(stream, listener, relativePosition);
+
+    // the HRTF ramps its gain over the block, from the gain it last rendered with down to zero
+    if (stream.lastPopSucceeded()) {
+        stream.getLastPopOutput().readSamples(_streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    } else {
+        memset(_streamBlock, 0, sizeof(_streamBlock));
+    }
+    hrtf->render(_streamBlock, mixedSamples, HRTF_DATASET_INDEX, azimuth, 0.0f,
+                 AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    listenerHRTFs.removeHRTFForStream(streamToFade.nodeID, stream.getStreamIdentifier());
+
+    ++stats.hrtfFadeOuts;
+}
+
+float AudioMixerWorker::gainForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener,
+                                      const glm::vec3& relativePosition, bool isEcho) {
+    float gain = 1.0f;
+
+    float distanceBetween = glm::length(relativePosition);
+
+    if (distanceBetween < EPSILON) {
+        distanceBetween = EPSILON;
+    }
+
+    if (streamToAdd.getType() == PositionalAudioStream::Injector) {
+        gain *= reinterpret_cast<const InjectedAudioStream*>(&streamToAdd)->getAttenuationRatio();
+    }
+
+    if (!isEcho && (streamToAdd.getType() == PositionalAudioStream::Microphone)) {
+        //  source is another avatar, apply fixed off-axis attenuation to make them quieter as they turn away from listener
+        glm::vec3 rotatedListenerPosition = glm::inverse(streamToAdd.getOrientation()) * relativePosition;
+
+        float angleOfDelivery = glm::angle(glm::vec3(0.0f, 0.0f, -1.0f),
+                                           glm::normalize(rotatedListenerPosition));
+
+        const float MAX_OFF_AXIS_ATTENUATION = 0.2f;
+        const float OFF_AXIS_ATTENUATION_FORMULA_STEP = (1 - MAX_OFF_AXIS_ATTENUATION) / 2.0f;
+
+        float offAxisCoefficient = MAX_OFF_AXIS_ATTENUATION +
+        (OFF_AXIS_ATTENUATION_FORMULA_STEP * (angleOfDelivery / PI_OVER_TWO));
+
+        // multiply the current attenuation coefficient by the calculated off axis coefficient
+        gain *= offAxisCoefficient;
+    }
+
+    float attenuationPerDoublingInDistance = attenuationPerDoublingForSource(streamToAdd, listener);
+
+    if (distanceBetween >= ATTENUATION_BEGINS_AT_DISTANCE) {
+        // calculate the distance coefficient using the distance to this node
+        float distanceCoefficient = 1.0f - (logf(distanceBetween / ATTENUATION_BEGINS_AT_DISTANCE) / logf(2.0f)
+                                            * attenuationPerDoublingInDistance);
+
+        if (distanceCoefficient < 0) {
+            distanceCoefficient = 0;
+        }
+
+        // multiply the current attenuation coefficient by the distance coefficient
+        gain *= distanceCoefficient;
+    }
+
+    return gain;
+}
+
+float AudioMixerWorker::azimuthForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener,
+                                         const glm::vec3& relativePosition) {
+    glm::quat inverseOrientation = glm::inverse(listener.orientation);
+
+    //  Compute sample delay for the two ears to create phase panning
+    glm::vec3 rotatedSourcePosition = inverseOrientation * relativePosition;
+
+    // project the rotated source position vector onto the XZ plane
+    rotatedSourcePosition.y = 0.0f;
+
+    static const float SOURCE_DISTANCE_THRESHOLD = 1e-30f;
+
+    if (glm::length2(rotatedSourcePosition) > SOURCE_DISTANCE_THRESHOLD) {
+        // produce an oriented angle about the y-axis
+        return glm::orientedAngle(glm::vec3(0.0f, 0.0f, -1.0f), glm::normalize(rotatedSourcePosition), glm::vec3(0.0f, -1.0f, 0.0f));
+    } else {
+        // there is no distance between listener and source - return no azimuth
+        return 0;
+    }
+}
+
+void AudioMixerWorker::addStreamToMix(ListenerHRTFs& listenerHRTFs, const PositionalAudioStream& streamToAdd,
+                                      const QUuid& sourceNodeID, const ListenerPose& listener, bool isEcho,
+                                      float* mixedSamples) {
+
+
+    // to reduce artifacts we calculate the gain and azimuth for every source for this listener
+    // even if we are not going to end up mixing in this source
+
+    ++stats.totalMixes;
+
+    // this ensures that the tail of any previously mixed audio or the first block of new audio sounds correct
+
+    // figure out the gain for this source at the listener
+    glm::vec3 relativePosition = streamToAdd.getPosition() - listener.position;
+    float gain = gainForSource(streamToAdd, listener, relativePosition, isEcho);
+
+    // figure out the azimuth to this source at the listener
+    float azimuth = isEcho ? 0.0f : azimuthForSource(streamToAdd, listener, relativePosition);
+
+    float repeatedFrameFadeFactor = 1.0f;
+
+    if (!streamToAdd.lastPopSucceeded()) {
+        bool forceSilentBlock = true;
+
+        if (AudioMixer::getStreamSettings()._repetitionWithFade && !streamToAdd.getLastPopOutput().isNull()) {
+
+            // reptition with fade is enabled, and we do have a valid previous frame to repeat
+            // so we mix the previously-mixed block
+
+            // this is preferable to not mixing it at all to avoid the harsh jump to silence
+
+            // we'll repeat the last block until it has a block to mix
+            // and we'll gradually fade that repeated block into silence.
+
+            // calculate its fade factor, which depends on how many times it's already been repeated.
+
+            repeatedFrameFadeFactor = calculateRepeatedFrameFadeFactor(streamToAdd.getConsecutiveNotMixedCount() - 1);
+            if (repeatedFrameFadeFactor > 0.0f) {
+                // apply the repeatedFrameFadeFactor to the gain
+                gain *= repeatedFrameFadeFactor;
+
+                forceSilentBlock = false;
+            }
+        }
+
+        if (forceSilentBlock) {
+            // we're deciding not to repeat either since we've already done it enough times or repetition with fade is disabled
+            // in this case we will call renderSilent with a forced silent block
+            // this ensures the correct tail from the previously mixed block and the correct spatialization of first block
+            // of any upcoming audio
+
+            if (!streamToAdd.isStereo() && !isEcho) {
+                // get the existing listener-source HRTF object, or create a new one
+                auto& hrtf = listenerHRTFs.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+
+                // this is not done for stereo streams since they do not go through the HRTF
+                // the silent block is only ever read, so it is safe to share between workers
+                static const int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
+                hrtf.renderSilent(const_cast<int16_t*>(silentMonoBlock), mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
+                                  AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+                ++stats.hrtfSilentRenders;
+            }
+
+            return;
+        }
+    }
+
+    // grab the stream from the ring buffer
+    AudioRingBuffer::ConstIterator streamPopOutput = streamToAdd.getLastPopOutput();
+
+    if (streamToAdd.isStereo() || isEcho) {
+        // this is a stereo source or server echo so we do not pass it through the HRTF
+        // simply apply our calculated gain to each sample
+        if (streamToAdd.isStereo()) {
+            streamPopOutput.readSamples(_streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+            mixInt16ToFloat(_streamBlock, mixedSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+            ++stats.manualStereoMixes;
+        } else {
+            streamPopOutput.readSamples(_streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            mixMonoInt16ToStereoFloat(_streamBlock, mixedSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+            ++stats.manualEchoMixes;
+        }
+
+        return;
+    }
+
+    // get the existing listener-source HRTF object, or create a new one
+    auto& hrtf = listenerHRTFs.hrtfForStream(sourceNodeID, streamToAdd.getStreamIdentifier());
+
+    streamPopOutput.readSamples(_streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+    // if the frame we're about to mix is silent, simply call render silent and move on
+    if (streamToAdd.getLastPopOutputLoudness() == 0.0f) {
+        // silent frame from source
+
+        // we still need to call renderSilent via the HRTF for mono source
+        hrtf.renderSilent(_streamBlock, mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        ++stats.hrtfSilentRenders;
+
+        return;
+    }
+
+    if (_mixer._performanceThrottlingRatio > 0.0f
+        && streamToAdd.getLastPopOutputTrailingLoudness() / glm::length(relativePosition) <= _mixer._minAudibilityThreshold) {
+        // the mixer is struggling so we're going to drop off some streams
+
+        // we call renderSilent via the HRTF with the actual frame data and a gain of 0.0
+        hrtf.renderSilent(_streamBlock, mixedSamples, HRTF_DATASET_INDEX, azimuth, 0.0f,
+                          AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        ++stats.hrtfStruggleRenders;
+
+        return;
+    }
+
+    ++stats.hrtfRenders;
+
+    // mono stream, call the HRTF with our block and calculated azimuth and gain
+    hrtf.render(_streamBlock, mixedSamples, HRTF_DATASET_INDEX, azimuth, gain,
+                AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+}
+
+bool AudioMixerWorker::prepareMixForListeningNode(Node* node, const Sources& sources) {
+    AudioMixerClientData* listenerNodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+    AvatarAudioStream* nodeAudioStream = listenerNodeData->getAvatarAudioStream();
+    ListenerPose listener { nodeAudioStream->getPosition(), nodeAudioStream->getOrientation() };
+
+    // zero out the client mix for this node
+    memset(_mixedSamples, 0, sizeof(_mixedSamples));
+
+    // loop through all other nodes that have sufficient audio to mix
+    _streamsToMix.clear();
+    for (auto& source : sources) {
+        const SharedNodePointer& otherNode = source.node;
+
+        // enumerate the ARBs attached to the otherNode and add all that should be added to mix
+        for (auto& streamPair : source.streams) {
+
+            auto otherNodeStream = streamPair.second;
+
+            if (*otherNode != *node || otherNodeStream->shouldLoopbackForNode()) {
+                // check if this is a server echo of a source back to itself
+                bool isEcho = (otherNodeStream.get() == nodeAudioStream);
+
+                _streamsToMix.push_back({ otherNodeStream.get(), otherNode->getUUID(), isEcho, 0.0f });
+            }
+        }
+    }
+
+    size_t numStreamsToMix = cullInaudibleStreams(_streamsToMix, listener);
+
+    // the reverb of the zone the listener is in, rendered once for everyone in it
+    auto zoneReverb = _mixer.zoneReverbForPosition(listener.position);
+    if (zoneReverb) {
+        zoneReverb->addWetToMix(_mixedSamples);
+    }
+
+    for (size_t i = 0; i < _streamsToMix.size(); ++i) {
+        auto& streamToMix = _streamsToMix[i];
+        if (i < numStreamsToMix) {
+            addStreamToMix(listenerNodeData->getHRTFs(), *streamToMix.stream, streamToMix.nodeID, listener,
+                           streamToMix.isEcho, _mixedSamples);
+        } else {
+            fadeOutStream(listenerNodeData->getHRTFs(), streamToMix, listener, _mixedSamples);
+        }
+    }
+
+    return clampMix(_mixedSamples, _clampedSamples);
+}
+
+bool AudioMixerWorker::clampMix(const float* mixedSamples, int16_t* clampedSamples) {
+    // clamp any samples outside the min/max, and check if we ended up with a silent frame
+    return convertMixToInt16(mixedSamples, clampedSamples, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+}
+
+std::unique_ptr<NLPacket> AudioMixerWorker::mixForListener(const SharedNodePointer& listener, const Sources& sources) {
+    AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
+
+    bool mixHasAudio = prepareMixForListeningNode(listener.data(), sources);
+
+    std::unique_ptr<NLPacket> mixPacket;
+
+    if (mixHasAudio) {
+        // encode the mix with the codec negotiated with this listener, if any
+        nodeData->encode(clampedMixBuffer(_clampedSamples), _encodedBuffer);
+        mixPacket = createMixPacket(*nodeData, _encodedBuffer);
+    } else {
+        mixPacket = createSilentPacket(*nodeData);
+    }
+
+    ++stats.sumListeners;
+
+    return mixPacket;
+}
+
+void AudioMixerWorker::mixForCluster(AudioMixerListenerCluster& cluster, const SharedNodePointer* members,
+                                     std::unique_ptr<NLPacket>* mixPackets, const Sources& sources) {
+    const int numMembers = (int)cluster.numListeners;
+    const int MIX_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    ListenerPose listener { cluster.position, cluster.orientation };
+
+    // each member's own streams are rendered apart from the rest, so they can be left out of the mix that member hears
+    _memberMixedSamples.resize(numMembers * MIX_SAMPLES);
+    _hasMemberMix.assign(numMembers, false);
+
+    // render every source once, from the middle of the cluster
+    memset(_mixedSamples, 0, sizeof(_mixedSamples));
+
+    _streamsToMix.clear();
+    for (auto& source : sources) {
+        for (auto& streamPair : source.streams) {
+            _streamsToMix.push_back({ streamPair.second.get(), source.node->getUUID(), false, 0.0f });
+        }
+    }
+
+    size_t numStreamsToMix = cullInaudibleStreams(_streamsToMix, listener);
+
+    for (size_t i = 0; i < _streamsToMix.size(); ++i) {
+        auto& streamToMix = _streamsToMix[i];
+        auto memberIt = cluster.memberIndices.find(streamToMix.nodeID);
+
+        float* mixedSamples = _mixedSamples;
+        if (memberIt != cluster.memberIndices.end()) {
+            int memberIndex = memberIt->second;
+            mixedSamples = &_memberMixedSamples[memberIndex * MIX_SAMPLES];
+
+            if (!_hasMemberMix[memberIndex]) {
+                memset(mixedSamples, 0, MIX_SAMPLES * sizeof(float));
+                _hasMemberMix[memberIndex] = true;
+            }
+        }
+
+        if (i < numStreamsToMix) {
+            addStreamToMix(cluster.getHRTFs(), *streamToMix.stream, streamToMix.nodeID, listener, false, mixedSamples);
+        } else {
+            fadeOutStream(cluster.getHRTFs(), streamToMix, listener, mixedSamples);
+        }
+    }
+
+    auto zoneReverb = _mixer.zoneReverbForPosition(listener.position);
+    if (zoneReverb) {
+        zoneReverb->addWetToMix(_mixedSamples);
+    }
+
+    // the members hear each other, so their streams go in the shared mix too
+    for (int member = 0; member < numMembers; ++member) {
+        if (_hasMemberMix[member]) {
+            const float* memberMixedSamples = &_memberMixedSamples[member * MIX_SAMPLES];
+            for (int i = 0; i < MIX_SAMPLES; ++i) {
+                _mixedSamples[i] += memberMixedSamples[i];
+            }
+        }
+    }
+
+    bool sharedMixHasAudio = clampMix(_mixedSamples, _clampedSamples);
+    bool isSharedMixEncoded = false;
+
+    for (int member = 0; member < numMembers; ++member) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(members[member]->getLinkedData());
+
+        if (_hasMemberMix[member]) {
+            // take the member's own streams back out of the shared mix
+            float memberMix[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+            const float* memberMixedSamples = &_memberMixedSamples[member * MIX_SAMPLES];
+            for (int i = 0; i < MIX_SAMPLES; ++i) {
+                memberMix[i] = _mixedSamples[i] - memberMixedSamples[i];
+            }
+
+            if (clampMix(memberMix, _memberClampedSamples)) {
+                nodeData->encode(clampedMixBuffer(_memberClampedSamples), _encodedBuffer);
+                mixPackets[member] = createMixPacket(*nodeData, _encodedBuffer);
+            } else {
+                mixPackets[member] = createSilentPacket(*nodeData);
+            }
+        } else if (!sharedMixHasAudio) {
+            mixPackets[member] = createSilentPacket(*nodeData);
+        } else if (cluster.canShareEncodedFrames) {
+            // encoded once, with the encoder of the first member that needs it
+            if (!isSharedMixEncoded) {
+                nodeData->encode(clampedMixBuffer(_clampedSamples), _sharedEncodedBuffer);
+                isSharedMixEncoded = true;
+            }
+            mixPackets[member] = createMixPacket(*nodeData, _sharedEncodedBuffer);
+        } else {
+            nodeData->encode(clampedMixBuffer(_clampedSamples), _encodedBuffer);
+            mixPackets[member] = createMixPacket(*nodeData, _encodedBuffer);
+        }
+
+        ++stats.sumListeners;
+    }
+
+    ++stats.clusterMixes;
+    stats.clusteredListeners += numMembers;
+}
+
+QByteArray AudioMixerWorker::clampedMixBuffer(int16_t* clampedSamples) {
+    return QByteArray::fromRawData(reinterpret_cast<char*>(clampedSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+}
+
+std::unique_ptr<NLPacket> AudioMixerWorker::createMixPacket(AudioMixerClientData& listenerData,
+                                                            const QByteArray& encodedMix) {
+    int mixPacketBytes = sizeof(quint16) + encodedMix.size();
+    auto mixPacket = NLPacket::create(PacketType::MixedAudio, mixPacketBytes);
+
+    // pack sequence number
+    quint16 sequence = listenerData.getOutgoingSequenceNumber();
+    mixPacket->writePrimitive(sequence);
+
+    // pack mixed audio samples
+    mixPacket->write(encodedMix.constData(), encodedMix.size());
+
+    return mixPacket;
+}
+
+std::unique_ptr<NLPacket> AudioMixerWorker::createSilentPacket(AudioMixerClientData& listenerData) {
+    int silentPacketBytes = sizeof(quint16) + sizeof(quint16);
+    auto mixPacket = NLPacket::create(PacketType::SilentAudioFrame, silentPacketBytes);
+
+    // pack sequence number
+    quint16 sequence = listenerData.getOutgoingSequenceNumber();
+    mixPacket->writePrimitive(sequence);
+
+    // pack number of silent audio samples
+    quint16 numSilentSamples = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    mixPacket->writePrimitive(numSilentSamples);
+
+    return mixPacket;
+}
@@ -0,0 +1,138 @@
+//
+//  AudioMixerWorker.h
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerWorker_h
+#define hifi_AudioMixerWorker_h
+
+#include <memory>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <NLPacket.h>
+#include <Node.h>
+
+#include "AudioMixerClientData.h"
+#include "AudioMixerListenerCluster.h"
+
+class AudioMixer;
+
+// counters for the different kinds of mixes performed, accumulated by each worker and summed by the mixer
+struct AudioMixerStats {
+    int sumListeners { 0 };
+    int totalMixes { 0 };
+
+    int hrtfRenders { 0 };
+    int hrtfSilentRenders { 0 };
+    int hrtfStruggleRenders { 0 };
+    int manualStereoMixes { 0 };
+    int manualEchoMixes { 0 };
+
+    int clusterMixes { 0 };
+    int clusteredListeners { 0 };
+
+    int culledStreams { 0 };
+    int hrtfFadeOuts { 0 };
+
+    void reset();
+    void accumulate(const AudioMixerStats& otherStats);
+};
+
+/// Mixes audio for one listener at a time.
+/// Each worker owns its own scratch buffers so that several workers can mix different listeners in parallel.
+class AudioMixerWorker {
+public:
+    // a source node and the copy of its streams taken once per frame, after the streams have been popped
+    struct Source {
+        SharedNodePointer node;
+        AudioMixerClientData::AudioStreamMap streams;
+    };
+    using Sources = std::vector<Source>;
+
+    AudioMixerWorker(const AudioMixer& mixer) : _mixer(mixer) {}
+
+    /// prepares the mix for the given listener, returns the packet that should be sent to it
+    std::unique_ptr<NLPacket> mixForListener(const SharedNodePointer& listener, const Sources& sources);
+
+    /// renders one mix for all the members of a cluster, mixPackets[i] receives the packet for members[i]
+    void mixForCluster(AudioMixerListenerCluster& cluster, const SharedNodePointer* members,
+                       std::unique_ptr<NLPacket>* mixPackets, const Sources& sources);
+
+    AudioMixerStats stats;
+
+    // time spent mixing in each frame
+    quint64 frameUsecs { 0 };
+    quint64 sumFrameUsecs { 0 };
+    quint64 maxFrameUsecs { 0 };
+    int numFrames { 0 };
+
+    void resetTimingStats() { sumFrameUsecs = 0; maxFrameUsecs = 0; numFrames = 0; }
+
+private:
+    // where a mix is heard from, a listener's avatar or the middle of a cluster of listeners
+    struct ListenerPose {
+        glm::vec3 position;
+        glm::quat orientation;
+    };
+
+    // a stream that may be added to a mix, with how loud it is at the listener
+    struct StreamToMix {
+        const PositionalAudioStream* stream;
+        QUuid nodeID;
+        bool isEcho;
+        float audibility;
+    };
+    using StreamsToMix = std::vector<StreamToMix>;
+
+    /// moves the most audible streams to the front of the given streams, keeping as many as the mixer allows for
+    /// one listener, returns the number of streams that should be mixed
+    size_t cullInaudibleStreams(StreamsToMix& streams, const ListenerPose& listener);
+
+    /// fades out a culled stream and frees its HRTF, so it costs nothing until it becomes audible again
+    void fadeOutStream(ListenerHRTFs& listenerHRTFs, const StreamToMix& streamToFade, const ListenerPose& listener,
+                       float* mixedSamples);
+
+    float audibilityForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener, bool isEcho);
+
+    /// adds one stream to a mix, rendered with the listener's HRTF for that stream
+    void addStreamToMix(ListenerHRTFs& listenerHRTFs, const PositionalAudioStream& streamToAdd,
+                        const QUuid& sourceNodeID, const ListenerPose& listener, bool isEcho, float* mixedSamples);
+
+    float attenuationPerDoublingForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener);
+    float gainForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener,
+                        const glm::vec3& relativePosition, bool isEcho);
+    float azimuthForSource(const PositionalAudioStream& streamToAdd, const ListenerPose& listener,
+                           const glm::vec3& relativePosition);
+
+    /// prepares a mix for one Node, returns true if the mix has audio
+    bool prepareMixForListeningNode(Node* node, const Sources& sources);
+
+    /// clamps a mix to samples, returns true if the mix has audio
+    static bool clampMix(const float* mixedSamples, int16_t* clampedSamples);
+    static QByteArray clampedMixBuffer(int16_t* clampedSamples);
+
+    static std::unique_ptr<NLPacket> createMixPacket(AudioMixerClientData& listenerData, const QByteArray& encodedMix);
+    static std::unique_ptr<NLPacket> createSilentPacket(AudioMixerClientData& listenerData);
+
+    const AudioMixer& _mixer;
+
+    float _mixedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t _clampedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    int16_t _streamBlock[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO]; // holds a mono or a stereo frame
+    QByteArray _encodedBuffer;
+    StreamsToMix _streamsToMix;
+
+    // scratch buffers for cluster mixes
+    std::vector<float> _memberMixedSamples;
+    std::vector<bool> _hasMemberMix;
+    int16_t _memberClampedSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    QByteArray _sharedEncodedBuffer;
+};
+
+#endif // hifi_AudioMixerWorker_h
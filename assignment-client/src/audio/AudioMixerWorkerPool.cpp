@@ -0,0 +1,154 @@
+//
+//  AudioMixerWorkerPool.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+#include <SharedUtil.h>
+
+#include "AudioMixerWorkerPool.h"
+
+AudioMixerWorkerPool::AudioMixerWorkerPool(const AudioMixer& mixer, int numThreads) :
+    _mixer(mixer)
+{
+    start(numThreads);
+}
+
+AudioMixerWorkerPool::~AudioMixerWorkerPool() {
+    stop();
+}
+
+void AudioMixerWorkerPool::setNumThreads(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    if (numThreads != this->numThreads()) {
+        stop();
+        start(numThreads);
+    }
+}
+
+void AudioMixerWorkerPool::start(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    for (int i = 0; i < numThreads; ++i) {
+        _workers.emplace_back(new AudioMixerWorker(_mixer));
+    }
+
+    // a single worker is run directly on the mixer thread, so there is nothing to spin up
+    if (numThreads > 1) {
+        _stopping = false;
+
+        // threads wait for the frame after the current one, so none of them can miss the first mix() call
+        quint64 startFrame = _frame;
+
+        for (auto& worker : _workers) {
+            AudioMixerWorker* threadWorker = worker.get();
+            _threads.emplace_back([this, threadWorker, startFrame] { run(*threadWorker, startFrame); });
+        }
+    }
+
+    qDebug() << "Audio mixer will mix listeners with" << numThreads << (numThreads == 1 ? "thread" : "threads");
+}
+
+void AudioMixerWorkerPool::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _frameReady.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+
+    _threads.clear();
+    _workers.clear();
+}
+
+void AudioMixerWorkerPool::mix(const Listeners& listeners, size_t numSoloListeners, const Clusters& clusters,
+                               const AudioMixerWorker::Sources& sources, MixPackets& mixPackets) {
+    mixPackets.clear();
+    mixPackets.resize(listeners.size());
+
+    _listeners = &listeners;
+    _numSoloListeners = numSoloListeners;
+    _clusters = &clusters;
+    _sources = &sources;
+    _mixPackets = &mixPackets;
+    _nextJob = 0;
+
+    if (_threads.empty()) {
+        mixFrame(*_workers.front());
+    } else {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        // wake the workers for this frame and wait for all of them to finish it
+        _numWorkersDone = 0;
+        ++_frame;
+        _frameReady.notify_all();
+
+        _frameDone.wait(lock, [this] { return _numWorkersDone == (int)_threads.size(); });
+    }
+
+    _listeners = nullptr;
+    _clusters = nullptr;
+    _sources = nullptr;
+    _mixPackets = nullptr;
+}
+
+void AudioMixerWorkerPool::run(AudioMixerWorker& worker, quint64 lastFrame) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _frameReady.wait(lock, [&] { return _stopping || _frame != lastFrame; });
+
+            if (_stopping) {
+                return;
+            }
+
+            lastFrame = _frame;
+        }
+
+        mixFrame(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            ++_numWorkersDone;
+        }
+        _frameDone.notify_one();
+    }
+}
+
+void AudioMixerWorkerPool::mixFrame(AudioMixerWorker& worker) {
+    quint64 frameStart = usecTimestampNow();
+
+    // clusters and then listeners are handed out one at a time so that a worker stuck on a heavy job doesn't hold up
+    // the rest, clusters go first since they are the heaviest
+    const size_t numClusters = _clusters->size();
+    const size_t numJobs = numClusters + _numSoloListeners;
+
+    size_t job;
+    while ((job = _nextJob++) < numJobs) {
+        if (job < numClusters) {
+            AudioMixerListenerCluster& cluster = *(*_clusters)[job];
+            worker.mixForCluster(cluster, &(*_listeners)[cluster.firstListener],
+                                 &(*_mixPackets)[cluster.firstListener], *_sources);
+        } else {
+            size_t listenerIndex = job - numClusters;
+            (*_mixPackets)[listenerIndex] = worker.mixForListener((*_listeners)[listenerIndex], *_sources);
+        }
+    }
+
+    worker.frameUsecs = usecTimestampNow() - frameStart;
+    worker.sumFrameUsecs += worker.frameUsecs;
+    worker.maxFrameUsecs = std::max(worker.maxFrameUsecs, worker.frameUsecs);
+    ++worker.numFrames;
+}
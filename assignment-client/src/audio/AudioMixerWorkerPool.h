@@ -0,0 +1,80 @@
+//
+//  AudioMixerWorkerPool.h
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerWorkerPool_h
+#define hifi_AudioMixerWorkerPool_h
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AudioMixerWorker.h"
+
+/// Mixes the listeners of one frame in parallel.
+/// With a single thread the mix runs directly on the calling (mixer) thread, otherwise the calling thread
+/// blocks in mix() until every listener has been handed out to, and mixed by, one of the pool threads.
+class AudioMixerWorkerPool {
+public:
+    using Listeners = std::vector<SharedNodePointer>;
+    using MixPackets = std::vector<std::unique_ptr<NLPacket>>;
+    using Clusters = std::vector<AudioMixerListenerCluster*>;
+
+    AudioMixerWorkerPool(const AudioMixer& mixer, int numThreads = 1);
+    ~AudioMixerWorkerPool();
+
+    // stops any running threads and starts the requested number of them
+    void setNumThreads(int numThreads);
+    int numThreads() const { return (int)_workers.size(); }
+
+    // mixes each listener against the given sources, mixPackets[i] receives the mix for listeners[i]
+    // the first numSoloListeners listeners are mixed on their own, the rest are members of the given clusters
+    void mix(const Listeners& listeners, size_t numSoloListeners, const Clusters& clusters,
+             const AudioMixerWorker::Sources& sources, MixPackets& mixPackets);
+
+    // calls the functor with each worker, should only be called from the mixer thread between frames
+    template <typename F>
+    void each(F functor) {
+        for (auto& worker : _workers) {
+            functor(*worker);
+        }
+    }
+
+private:
+    void start(int numThreads);
+    void stop();
+
+    void run(AudioMixerWorker& worker, quint64 lastFrame);
+    void mixFrame(AudioMixerWorker& worker);
+
+    const AudioMixer& _mixer;
+
+    std::vector<std::unique_ptr<AudioMixerWorker>> _workers;
+    std::vector<std::thread> _threads;
+
+    std::mutex _mutex;
+    std::condition_variable _frameReady;
+    std::condition_variable _frameDone;
+    quint64 _frame { 0 };
+    int _numWorkersDone { 0 };
+    bool _stopping { false };
+
+    // the job for the current frame, only valid while mix() is running
+    const Listeners* _listeners { nullptr };
+    size_t _numSoloListeners { 0 };
+    const Clusters* _clusters { nullptr };
+    const AudioMixerWorker::Sources* _sources { nullptr };
+    MixPackets* _mixPackets { nullptr };
+    std::atomic<size_t> _nextJob { 0 };
+};
+
+#endif // hifi_AudioMixerWorkerPool_h
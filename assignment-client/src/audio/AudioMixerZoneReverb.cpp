@@ -0,0 +1,102 @@
+//
+//  AudioMixerZoneReverb.cpp
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <math.h>
+#include <string.h>
+
+#include <AudioMixKernels.h>
+#include <SharedUtil.h>
+
+#include "PositionalAudioStream.h"
+
+#include "AudioMixerZoneReverb.h"
+
+AudioMixerZoneReverb::AudioMixerZoneReverb(const QString& zone, float reverbTime, float wetLevel) :
+    _zone(zone),
+    _reverb(AudioConstants::SAMPLE_RATE),
+    _wetGain(wetLevel / 100.0f),
+    _tailFrames((int)ceilf(reverbTime / AudioConstants::NETWORK_FRAME_SECS))
+{
+    // the reverb renders only the wet signal, the listeners hear the dry signal in their own mix
+    ReverbParameters parameters;
+    _reverb.getParameters(&parameters);
+    parameters.reverbTime = reverbTime;
+    parameters.wetDryMix = 100.0f;
+    _reverb.setParameters(&parameters);
+
+    memset(_input, 0, sizeof(_input));
+    memset(_wet, 0, sizeof(_wet));
+}
+
+void AudioMixerZoneReverb::addSource(const PositionalAudioStream& stream, float gain) {
+    if (!stream.lastPopSucceeded() || stream.getLastPopOutputLoudness() == 0.0f) {
+        return;
+    }
+
+    AudioRingBuffer::ConstIterator streamPopOutput = stream.getLastPopOutput();
+
+    if (stream.isStereo()) {
+        streamPopOutput.readSamples(_streamBlock, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO);
+
+        float scale = gain / AudioConstants::MAX_SAMPLE_VALUE;
+        for (int i = 0; i < FRAME_SAMPLES; i++) {
+            _input[0][i] += _streamBlock[2 * i + 0] * scale;
+            _input[1][i] += _streamBlock[2 * i + 1] * scale;
+        }
+    } else {
+        streamPopOutput.readSamples(_streamBlock, FRAME_SAMPLES);
+
+        mixInt16ToFloat(_streamBlock, _input[0], gain, FRAME_SAMPLES);
+        mixInt16ToFloat(_streamBlock, _input[1], gain, FRAME_SAMPLES);
+    }
+
+    _hasInput = true;
+}
+
+void AudioMixerZoneReverb::render() {
+    if (_hasInput) {
+        _silentFrames = 0;
+    } else if (_silentFrames <= _tailFrames) {
+        ++_silentFrames;
+    }
+
+    if (_silentFrames > _tailFrames) {
+        // the tail has died out, start from a clean state when a source comes back
+        if (_hasWet) {
+            _reverb.reset();
+            _hasWet = false;
+        }
+        return;
+    }
+
+    quint64 renderStart = usecTimestampNow();
+
+    float* inputs[AudioConstants::STEREO] = { _input[0], _input[1] };
+    float* outputs[AudioConstants::STEREO] = { _wet[0], _wet[1] };
+    _reverb.render(inputs, outputs, FRAME_SAMPLES);
+
+    _renderUsecs += usecTimestampNow() - renderStart;
+    ++_numRenders;
+
+    memset(_input, 0, sizeof(_input));
+    _hasInput = false;
+    _hasWet = true;
+}
+
+void AudioMixerZoneReverb::addWetToMix(float* mixedSamples) const {
+    if (!_hasWet) {
+        return;
+    }
+
+    for (int i = 0; i < FRAME_SAMPLES; i++) {
+        mixedSamples[2 * i + 0] += _wet[0][i] * _wetGain;
+        mixedSamples[2 * i + 1] += _wet[1][i] * _wetGain;
+    }
+}
@@ -0,0 +1,64 @@
+//
+//  AudioMixerZoneReverb.h
+//  assignment-client/src/audio
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerZoneReverb_h
+#define hifi_AudioMixerZoneReverb_h
+
+#include <QtCore/QString>
+
+#include <AudioConstants.h>
+#include <AudioReverb.h>
+
+class PositionalAudioStream;
+
+/// The reverb of one audio zone, rendered by the mixer once per frame from the sum of the sources in the zone.
+/// Every listener in the zone hears the same wet signal, added to its own mix.
+class AudioMixerZoneReverb {
+public:
+    AudioMixerZoneReverb(const QString& zone, float reverbTime, float wetLevel);
+
+    const QString& getZone() const { return _zone; }
+
+    // adds a source in the zone to the input of this frame
+    void addSource(const PositionalAudioStream& stream, float gain);
+
+    // renders the wet signal of this frame, and clears the input for the next one
+    void render();
+
+    // adds the wet signal of this frame to an interleaved stereo mix
+    void addWetToMix(float* mixedSamples) const;
+
+    // time spent rendering since the last reset
+    float getAverageRenderUsecs() const { return _numRenders > 0 ? (float)_renderUsecs / _numRenders : 0.0f; }
+    int getNumRenders() const { return _numRenders; }
+    void resetStats() { _renderUsecs = 0; _numRenders = 0; }
+
+private:
+    static const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    QString _zone;
+    AudioReverb _reverb;
+    float _wetGain;
+
+    // once the input has been silent for longer than the reverb tail, rendering stops until a source comes back
+    int _tailFrames;
+    int _silentFrames { 0 };
+    bool _hasInput { false };
+    bool _hasWet { false };
+
+    float _input[AudioConstants::STEREO][FRAME_SAMPLES];
+    float _wet[AudioConstants::STEREO][FRAME_SAMPLES];
+    int16_t _streamBlock[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+
+    quint64 _renderUsecs { 0 };
+    int _numRenders { 0 };
+};
+
+#endif // hifi_AudioMixerZoneReverb_h
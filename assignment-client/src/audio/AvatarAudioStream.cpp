@@ -44,6 +44,11 @@ int AvatarAudioStream::parseStreamProperties(PacketType type, const QByteArray&
                                            ? AudioConstants::NETWORK_FRAME_SAMPLES_STEREO
                                            : AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
             _isStereo = isStereo;
+
+            // the decoder is set up for a channel count
+            if (_codec) {
+                setupCodec(_codec, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
+            }
         }
 
         // read the positional data
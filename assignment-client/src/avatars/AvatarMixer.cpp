@@ -68,6 +68,24 @@ AvatarMixer::~AvatarMixer() {
 // assuming 60 htz update rate.
 const float BILLBOARD_AND_IDENTITY_SEND_PROBABILITY = 1.0f / 187.0f;
 
+// avatars beyond the full rate distance are still sent at least this often
+const float MAX_DISTANT_AVATAR_SEND_INTERVAL_FRAMES = 5.0f * AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
+
+// Sends once every ceil(distance / fullRateDistance) frames, which matches the fullRateDistance / distance
+// send probability on average but spreads the sends deterministically. The phase keeps different senders
+// (or cells) from all landing on the same frame.
+bool AvatarMixer::shouldSendAtDistance(float distance, float fullRateDistance, uint phase) const {
+    if (distance <= fullRateDistance) {
+        return true;
+    }
+
+    float framesPerSend = fullRateDistance > 0.0f
+        ? std::min(distance / fullRateDistance, MAX_DISTANT_AVATAR_SEND_INTERVAL_FRAMES)
+        : MAX_DISTANT_AVATAR_SEND_INTERVAL_FRAMES;
+
+    return (_broadcastFrameNumber + phase) % (quint64)ceilf(framesPerSend) == 0;
+}
+
 // NOTE: some additional optimizations to consider.
 //    1) use the view frustum to cull those avatars that are out of view. Since avatar data doesn't need to be present
 //       if the avatar is not in view or in the keyhole.
@@ -75,6 +93,7 @@ void AvatarMixer::broadcastAvatarData() {
     int idleTime = QDateTime::currentMSecsSinceEpoch() - _lastFrameTimestamp;
 
     ++_numStatFrames;
+    ++_broadcastFrameNumber;
 
     const float STRUGGLE_TRIGGER_SLEEP_PERCENTAGE_THRESHOLD = 0.10f;
     const float BACK_OFF_TRIGGER_SLEEP_PERCENTAGE_THRESHOLD = 0.20f;
@@ -135,6 +154,23 @@ void AvatarMixer::broadcastAvatarData() {
     std::mt19937 generator(randomDevice());
     std::uniform_real_distribution<float> distribution;
 
+    // rebuild the grid of avatar positions for this frame
+    _avatarGrid.clear();
+    nodeList->eachMatchingNode(
+        [&](const SharedNodePointer& otherNode)->bool {
+            return otherNode->getLinkedData() != nullptr;
+        },
+        [&](const SharedNodePointer& otherNode) {
+            AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
+            MutexTryLocker lock(otherNodeData->getMutex());
+            if (!lock.isLocked()) {
+                // the avatar is being updated right now, keep it where it was last frame rather than dropping it
+                _avatarGrid.insertAtLastKnownPosition(otherNode, otherNodeData);
+                return;
+            }
+            _avatarGrid.insert(otherNode, otherNodeData, otherNodeData->getAvatar().getClientGlobalPosition());
+        });
+
     nodeList->eachMatchingNode(
         [&](const SharedNodePointer& node)->bool {
             if (!node->getLinkedData()) {
@@ -225,124 +261,180 @@ void AvatarMixer::broadcastAvatarData() {
 
             // this is an AGENT we have received head data from
             // send back a packet with other active node data to this node
-            nodeList->eachMatchingNode(
-                [&](const SharedNodePointer& otherNode)->bool {
-                    if (!otherNode->getLinkedData()) {
-                        return false;
-                    }
-                    if (otherNode->getUUID() == node->getUUID()) {
-                        return false;
-                    }
+            float fullRateDistance = nodeData->getFullRateDistance();
+
+            auto sendOtherAvatar = [&](const AvatarSpatialGrid::Entry& other, bool isInNearCell) {
+                const SharedNodePointer& otherNode = other.node;
+                AvatarMixerClientData* otherNodeData = other.nodeData;
+                MutexTryLocker lock(otherNodeData->getMutex());
+                if (!lock.isLocked()) {
+                    return;
+                }
 
-                    return true;
-                },
-                [&](const SharedNodePointer& otherNode) {
-                    ++numOtherAvatars;
+                // make sure we send out identity and billboard packets to and from new arrivals.
+                bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
 
-                    AvatarMixerClientData* otherNodeData = reinterpret_cast<AvatarMixerClientData*>(otherNode->getLinkedData());
-                    MutexTryLocker lock(otherNodeData->getMutex());
-                    if (!lock.isLocked()) {
-                        return;
-                    }
+                // we will also force a send of billboard or identity packet
+                // if either has changed in the last frame
+                if (otherNodeData->getBillboardChangeTimestamp() > 0
+                    && (forceSend
+                        || otherNodeData->getBillboardChangeTimestamp() > _lastFrameTimestamp
+                        || distribution(generator) < BILLBOARD_AND_IDENTITY_SEND_PROBABILITY)) {
 
-                    // make sure we send out identity and billboard packets to and from new arrivals.
-                    bool forceSend = !otherNodeData->checkAndSetHasReceivedFirstPacketsFrom(node->getUUID());
+                    QByteArray rfcUUID = otherNode->getUUID().toRfc4122();
+                    QByteArray billboard = otherNodeData->getAvatar().getBillboard();
 
-                    // we will also force a send of billboard or identity packet
-                    // if either has changed in the last frame
-                    if (otherNodeData->getBillboardChangeTimestamp() > 0
-                        && (forceSend
-                            || otherNodeData->getBillboardChangeTimestamp() > _lastFrameTimestamp
-                            || distribution(generator) < BILLBOARD_AND_IDENTITY_SEND_PROBABILITY)) {
+                    auto billboardPacket = NLPacket::create(PacketType::AvatarBillboard, rfcUUID.size() + billboard.size());
+                    billboardPacket->write(rfcUUID);
+                    billboardPacket->write(billboard);
 
-                        QByteArray rfcUUID = otherNode->getUUID().toRfc4122();
-                        QByteArray billboard = otherNodeData->getAvatar().getBillboard();
+                    nodeList->sendPacket(std::move(billboardPacket), *node);
 
-                        auto billboardPacket = NLPacket::create(PacketType::AvatarBillboard, rfcUUID.size() + billboard.size());
-                        billboardPacket->write(rfcUUID);
-                        billboardPacket->write(billboard);
+                    ++_sumBillboardPackets;
+                }
 
-                        nodeList->sendPacket(std::move(billboardPacket), *node);
+                if (otherNodeData->getIdentityChangeTimestamp() > 0
+                    && (forceSend
+                        || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
+                        || distribution(generator) < BILLBOARD_AND_IDENTITY_SEND_PROBABILITY)) {
 
-                        ++_sumBillboardPackets;
-                    }
+                    QByteArray individualData = otherNodeData->getAvatar().identityByteArray();
 
-                    if (otherNodeData->getIdentityChangeTimestamp() > 0
-                        && (forceSend
-                            || otherNodeData->getIdentityChangeTimestamp() > _lastFrameTimestamp
-                            || distribution(generator) < BILLBOARD_AND_IDENTITY_SEND_PROBABILITY)) {
+                    auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
 
-                        QByteArray individualData = otherNodeData->getAvatar().identityByteArray();
+                    individualData.replace(0, NUM_BYTES_RFC4122_UUID, otherNode->getUUID().toRfc4122());
 
-                        auto identityPacket = NLPacket::create(PacketType::AvatarIdentity, individualData.size());
+                    identityPacket->write(individualData);
 
-                        individualData.replace(0, NUM_BYTES_RFC4122_UUID, otherNode->getUUID().toRfc4122());
+                    nodeList->sendPacket(std::move(identityPacket), *node);
 
-                        identityPacket->write(individualData);
+                    ++_sumIdentityPackets;
+                }
 
-                        nodeList->sendPacket(std::move(identityPacket), *node);
+                AvatarData& otherAvatar = otherNodeData->getAvatar();
+                //  Decide whether to send this avatar's data based on it's distance from us
 
-                        ++_sumIdentityPackets;
-                    }
+                //  The full rate distance is the distance at which EVERY update will be sent for this avatar
+                //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
+                glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
+                float distanceToAvatar = glm::length(myPosition - otherPosition);
+
+                // potentially update the max full rate distance for this frame
+                maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
 
-                    AvatarData& otherAvatar = otherNodeData->getAvatar();
-                    //  Decide whether to send this avatar's data based on it's distance from us
+                // avatars in distant cells have already been sampled by cell, the others are sampled here
+                if (isInNearCell && distanceToAvatar != 0.0f
+                    && !shouldSendAtDistance(distanceToAvatar, fullRateDistance, qHash(otherNode->getUUID()))) {
+                    return;
+                }
 
-                    //  The full rate distance is the distance at which EVERY update will be sent for this avatar
-                    //  at twice the full rate distance, there will be a 50% chance of sending this avatar's update
-                    glm::vec3 otherPosition = otherAvatar.getClientGlobalPosition();
-                    float distanceToAvatar = glm::length(myPosition - otherPosition);
+                AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
+                AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
 
-                    // potentially update the max full rate distance for this frame
-                    maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distanceToAvatar);
+                if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
+                    // we got out out of order packets from the sender, track it
+                    otherNodeData->incrementNumOutOfOrderSends();
+                }
 
-                    if (distanceToAvatar != 0.0f
-                        && distribution(generator) > (nodeData->getFullRateDistance() / distanceToAvatar)) {
-                        return;
-                    }
+                // make sure we haven't already sent this data from this sender to this receiver
+                // or that somehow we haven't sent
+                if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
+                    ++numAvatarsHeldBack;
+                    return;
+                } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
+                    // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
+                    ++numAvatarsWithSkippedFrames;
+                }
 
-                    AvatarDataSequenceNumber lastSeqToReceiver = nodeData->getLastBroadcastSequenceNumber(otherNode->getUUID());
-                    AvatarDataSequenceNumber lastSeqFromSender = otherNodeData->getLastReceivedSequenceNumber();
+                // we're going to send this avatar
 
-                    if (lastSeqToReceiver > lastSeqFromSender && lastSeqToReceiver != UINT16_MAX) {
-                        // we got out out of order packets from the sender, track it
-                        otherNodeData->incrementNumOutOfOrderSends();
-                    }
+                // increment the number of avatars sent to this reciever
+                nodeData->incrementNumAvatarsSentLastFrame();
 
-                    // make sure we haven't already sent this data from this sender to this receiver
-                    // or that somehow we haven't sent
-                    if (lastSeqToReceiver == lastSeqFromSender && lastSeqToReceiver != 0) {
-                        ++numAvatarsHeldBack;
-                        return;
-                    } else if (lastSeqFromSender - lastSeqToReceiver > 1) {
-                        // this is a skip - we still send the packet but capture the presence of the skip so we see it happening
-                        ++numAvatarsWithSkippedFrames;
-                    }
+                // set the last sent sequence number for this sender on the receiver
+                nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
+                                                         otherNodeData->getLastReceivedSequenceNumber());
 
-                    // we're going to send this avatar
+                // start a new segment in the PacketList for this avatar
+                avatarPacketList->startSegment();
 
-                    // increment the number of avatars sent to this reciever
-                    nodeData->incrementNumAvatarsSentLastFrame();
+                numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
 
-                    // set the last sent sequence number for this sender on the receiver
-                    nodeData->setLastBroadcastSequenceNumber(otherNode->getUUID(),
-                                                             otherNodeData->getLastReceivedSequenceNumber());
+                // the encoded data only depends on the sender and whether this is a full update,
+                // so only encode it if no other receiver has caused it to be encoded this frame
+                bool sendAll = distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO;
+                const QByteArray* avatarByteArray = otherNodeData->getCachedAvatarData(_broadcastFrameNumber, sendAll);
 
-                    // start a new segment in the PacketList for this avatar
-                    avatarPacketList->startSegment();
+                if (!avatarByteArray) {
+                    avatarByteArray = &otherNodeData->cacheAvatarData(_broadcastFrameNumber, sendAll,
+                                                                      otherAvatar.toByteArray(false, sendAll));
+                    ++_sumAvatarDataEncodes;
+                }
+
+                numAvatarDataBytes += avatarPacketList->write(*avatarByteArray);
+                ++_sumAvatarDataSends;
+
+                avatarPacketList->endSegment();
+            };
+
+            // visit the other avatars cell by cell - cells within the full rate distance are visited every frame,
+            // while distant cells are visited as a whole, region by region, at a rate proportional to their distance
+            auto visitCell = [&](const AvatarSpatialGrid::Cell& cell, bool isNearCell) {
+                for (int entryIndex : cell.entries) {
+                    auto& other = _avatarGrid.getEntries()[entryIndex];
+
+                    if (other.node->getUUID() != node->getUUID()) {
+                        ++numOtherAvatars;
+                        sendOtherAvatar(other, isNearCell);
+                    }
+                }
+            };
 
-                    numAvatarDataBytes += avatarPacketList->write(otherNode->getUUID().toRfc4122());
-                    numAvatarDataBytes +=
-                        avatarPacketList->write(otherAvatar.toByteArray(false, distribution(generator) < AVATAR_SEND_FULL_UPDATE_RATIO));
+            auto skipAtDistance = [&](int numEntries, float distance) {
+                // skip these avatars this frame, but account for them as if we had looked at them
+                numOtherAvatars += numEntries;
+                maxAvatarDistanceThisFrame = std::max(maxAvatarDistanceThisFrame, distance);
+            };
 
-                    avatarPacketList->endSegment();
+            // cells within the full rate distance are looked up directly around this avatar
+            _avatarGrid.forEachCellInRange(myPosition, fullRateDistance, [&](const AvatarSpatialGrid::Cell& cell) {
+                visitCell(cell, true);
             });
 
+            // everything further away is throttled, a whole region at a time unless it straddles the full rate distance
+            for (auto& region : _avatarGrid.getRegions()) {
+                float distanceToRegion = _avatarGrid.distanceToRegion(myPosition, region);
+
+                if (distanceToRegion > fullRateDistance) {
+                    if (!shouldSendAtDistance(distanceToRegion, fullRateDistance, region.phase)) {
+                        skipAtDistance(region.numEntries, distanceToRegion);
+                        continue;
+                    }
+                    for (int cellIndex : region.cells) {
+                        visitCell(_avatarGrid.getCells()[cellIndex], false);
+                    }
+                    continue;
+                }
+
+                for (int cellIndex : region.cells) {
+                    auto& cell = _avatarGrid.getCells()[cellIndex];
+                    float distanceToCell = _avatarGrid.distanceToCell(myPosition, cell);
+                    if (distanceToCell <= fullRateDistance) {
+                        continue; // already visited above
+                    }
+                    if (!shouldSendAtDistance(distanceToCell, fullRateDistance, cell.phase)) {
+                        skipAtDistance((int)cell.entries.size(), distanceToCell);
+                        continue;
+                    }
+                    visitCell(cell, false);
+                }
+            }
+
             // close the current packet so that we're always sending something
             avatarPacketList->closeCurrentPacket(true);
 
-            // send the avatar data PacketList
-            nodeList->sendPacketList(std::move(avatarPacketList), *node);
+            // batch the avatar data PacketList, it goes out with those of every other receiver once we're done
+            nodeList->batchPacketList(_sendBatch, std::move(avatarPacketList), *node);
 
             // record the bytes sent for other avatar data in the AvatarMixerClientData
             nodeData->recordSentAvatarData(numAvatarDataBytes);
@@ -360,6 +452,9 @@ void AvatarMixer::broadcastAvatarData() {
         }
     );
 
+    // put the avatar data for every receiver on the wire together
+    nodeList->sendBatch(_sendBatch);
+
     // We're done encoding this version of the otherAvatars.  Update their "lastSent" joint-states so
     // that we can notice differences, next time around.
     nodeList->eachMatchingNode(
@@ -469,6 +564,11 @@ void AvatarMixer::sendStatsPacket() {
     statsObject["average_billboard_packets_per_frame"] = (float) _sumBillboardPackets / (float) _numStatFrames;
     statsObject["average_identity_packets_per_frame"] = (float) _sumIdentityPackets / (float) _numStatFrames;
 
+    statsObject["average_avatar_data_encodes_per_frame"] = (float) _sumAvatarDataEncodes / (float) _numStatFrames;
+    statsObject["average_avatar_data_sends_per_frame"] = (float) _sumAvatarDataSends / (float) _numStatFrames;
+    statsObject["average_datagrams_per_send_syscall"] = _sendBatch.getNumWriteSyscalls() > 0 ?
+        (float) _sendBatch.getNumWrittenDatagrams() / (float) _sendBatch.getNumWriteSyscalls() : 0.0f;
+
     statsObject["trailing_sleep_percentage"] = _trailingSleepRatio * 100;
     statsObject["performance_throttling_ratio"] = _performanceThrottlingRatio;
 
@@ -509,6 +609,9 @@ void AvatarMixer::sendStatsPacket() {
     _sumListeners = 0;
     _sumBillboardPackets = 0;
     _sumIdentityPackets = 0;
+    _sumAvatarDataEncodes = 0;
+    _sumAvatarDataSends = 0;
+    _sendBatch.resetStats();
     _numStatFrames = 0;
 }
 
@@ -16,6 +16,9 @@
 #define hifi_AvatarMixer_h
 
 #include <ThreadedAssignment.h>
+#include <udt/SendBatch.h>
+
+#include "AvatarSpatialGrid.h"
 
 /// Handles assignments of type AvatarMixer - distribution of avatar data to various clients
 class AvatarMixer : public ThreadedAssignment {
@@ -41,6 +44,8 @@ private slots:
 private:
     void broadcastAvatarData();
     void parseDomainServerSettings(const QJsonObject& domainSettings);
+
+    bool shouldSendAtDistance(float distance, float fullRateDistance, uint phase) const;
     
     QThread _broadcastThread;
     
@@ -54,6 +59,14 @@ private:
     int _sumBillboardPackets;
     int _sumIdentityPackets;
 
+    quint64 _broadcastFrameNumber { 0 };
+    AvatarSpatialGrid _avatarGrid;
+
+    int _sumAvatarDataEncodes { 0 };
+    int _sumAvatarDataSends { 0 };
+
+    udt::SendBatch _sendBatch; // the avatar data for every receiver in a frame, sent together
+
     float _maxKbpsPerNode = 0.0f;
 
     QTimer* _broadcastTimer = nullptr;
@@ -39,6 +39,29 @@ uint16_t AvatarMixerClientData::getLastBroadcastSequenceNumber(const QUuid& node
     }
 }
 
+const QByteArray* AvatarMixerClientData::getCachedAvatarData(quint64 frameNumber, bool sendAll) const {
+    const CachedAvatarData& cached = sendAll ? _cachedFullAvatarData : _cachedTerseAvatarData;
+
+    // the cached data is only good for the frame it was encoded in, and only if we haven't parsed
+    // newer avatar data from this node since it was encoded
+    if (cached.isValid && cached.frameNumber == frameNumber && cached.sequenceNumber == _lastReceivedSequenceNumber) {
+        return &cached.data;
+    } else {
+        return nullptr;
+    }
+}
+
+const QByteArray& AvatarMixerClientData::cacheAvatarData(quint64 frameNumber, bool sendAll, const QByteArray& avatarData) {
+    CachedAvatarData& cached = sendAll ? _cachedFullAvatarData : _cachedTerseAvatarData;
+
+    cached.data = avatarData;
+    cached.frameNumber = frameNumber;
+    cached.sequenceNumber = _lastReceivedSequenceNumber;
+    cached.isValid = true;
+
+    return cached.data;
+}
+
 void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject["display_name"] = _avatar->getDisplayName();
     jsonObject["full_rate_distance"] = _fullRateDistance;
@@ -78,8 +78,19 @@ public:
     float getOutboundAvatarDataKbps() const
         { return _avgOtherAvatarDataRate.getAverageSampleValuePerSecond() / (float) BYTES_PER_KILOBIT; }
 
+    // the encoded avatar data is cached per broadcast frame so that each of the terse and full variants
+    // is encoded at most once per frame, no matter how many receivers it is sent to
+    const QByteArray* getCachedAvatarData(quint64 frameNumber, bool sendAll) const;
+    const QByteArray& cacheAvatarData(quint64 frameNumber, bool sendAll, const QByteArray& avatarData);
+
     void loadJSONStats(QJsonObject& jsonObject) const;
 private:
+    struct CachedAvatarData {
+        QByteArray data;
+        quint64 frameNumber { 0 };
+        uint16_t sequenceNumber { 0 };
+        bool isValid { false };
+    };
     AvatarSharedPointer _avatar { new AvatarData() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
@@ -100,6 +111,9 @@ private:
     int _numOutOfOrderSends = 0;
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
+
+    CachedAvatarData _cachedTerseAvatarData;
+    CachedAvatarData _cachedFullAvatarData;
 };
 
 #endif // hifi_AvatarMixerClientData_h
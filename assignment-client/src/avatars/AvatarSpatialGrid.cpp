@@ -0,0 +1,96 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QHash>
+
+#include "AvatarSpatialGrid.h"
+
+void AvatarSpatialGrid::clear() {
+    _lastKnownPositions.clear();
+    for (auto& entry : _entries) {
+        _lastKnownPositions[entry.node->getUUID()] = entry.position;
+    }
+
+    _entries.clear();
+    _cells.clear();
+    _regions.clear();
+    _cellIndices.clear();
+    _regionIndices.clear();
+}
+
+void AvatarSpatialGrid::insert(const SharedNodePointer& node, AvatarMixerClientData* nodeData, const glm::vec3& position) {
+    glm::ivec3 coordinates = cellCoordinatesForPosition(position);
+    quint64 key = keyForCoordinates(coordinates);
+
+    auto it = _cellIndices.find(key);
+    if (it == _cellIndices.end()) {
+        Cell cell;
+        cell.coordinates = coordinates;
+        cell.phase = qHash(key);
+
+        it = _cellIndices.emplace(key, (int)_cells.size()).first;
+        _cells.push_back(cell);
+
+        // file the new cell under its region
+        glm::ivec3 regionCoordinates = glm::ivec3(glm::floor(glm::vec3(coordinates) / (float)AVATAR_GRID_REGION_CELLS));
+        quint64 regionKey = keyForCoordinates(regionCoordinates);
+        auto regionIt = _regionIndices.find(regionKey);
+        if (regionIt == _regionIndices.end()) {
+            Region region;
+            region.coordinates = regionCoordinates;
+            region.phase = qHash(regionKey);
+
+            regionIt = _regionIndices.emplace(regionKey, (int)_regions.size()).first;
+            _regions.push_back(region);
+        }
+        _regions[regionIt->second].cells.push_back(it->second);
+    }
+
+    Cell& cell = _cells[it->second];
+    cell.entries.push_back((int)_entries.size());
+    _entries.push_back({ node, nodeData, position });
+
+    glm::ivec3 regionCoordinates = glm::ivec3(glm::floor(glm::vec3(cell.coordinates) / (float)AVATAR_GRID_REGION_CELLS));
+    _regions[_regionIndices[keyForCoordinates(regionCoordinates)]].numEntries++;
+}
+
+bool AvatarSpatialGrid::insertAtLastKnownPosition(const SharedNodePointer& node, AvatarMixerClientData* nodeData) {
+    auto it = _lastKnownPositions.find(node->getUUID());
+    if (it == _lastKnownPositions.end()) {
+        return false;
+    }
+    insert(node, nodeData, it->second);
+    return true;
+}
+
+float AvatarSpatialGrid::distanceToCell(const glm::vec3& position, const Cell& cell) const {
+    glm::vec3 minimumCorner = glm::vec3(cell.coordinates) * _cellSize;
+    glm::vec3 closestPoint = glm::clamp(position, minimumCorner, minimumCorner + glm::vec3(_cellSize));
+    return glm::length(position - closestPoint);
+}
+
+float AvatarSpatialGrid::distanceToRegion(const glm::vec3& position, const Region& region) const {
+    float regionSize = _cellSize * AVATAR_GRID_REGION_CELLS;
+    glm::vec3 minimumCorner = glm::vec3(region.coordinates) * regionSize;
+    glm::vec3 closestPoint = glm::clamp(position, minimumCorner, minimumCorner + glm::vec3(regionSize));
+    return glm::length(position - closestPoint);
+}
+
+glm::ivec3 AvatarSpatialGrid::cellCoordinatesForPosition(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor(position / _cellSize));
+}
+
+quint64 AvatarSpatialGrid::keyForCoordinates(const glm::ivec3& coordinates) {
+    // pack 21 bits of each coordinate, which covers +/- 16000 km of domain with the default cell size
+    const quint64 COORDINATE_MASK = (1 << 21) - 1;
+    return ((quint64)(coordinates.x & COORDINATE_MASK) << 42)
+        | ((quint64)(coordinates.y & COORDINATE_MASK) << 21)
+        | (quint64)(coordinates.z & COORDINATE_MASK);
+}
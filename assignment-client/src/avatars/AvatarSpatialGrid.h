@@ -0,0 +1,117 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <Node.h>
+#include <UUIDHasher.h>
+
+class AvatarMixerClientData;
+
+const float DEFAULT_AVATAR_GRID_CELL_SIZE = 16.0f; // meters
+const int AVATAR_GRID_REGION_CELLS = 4; // cells along each side of a region
+
+/// Uniform grid of avatar positions, rebuilt by the AvatarMixer once per broadcast frame.
+/// Only occupied cells are stored, so the cost of the grid is proportional to the number of avatars
+/// and not to the size of the domain. Occupied cells are also grouped into coarser regions, so that distant cells
+/// can be skipped a region at a time.
+class AvatarSpatialGrid {
+public:
+    struct Entry {
+        SharedNodePointer node;
+        AvatarMixerClientData* nodeData;
+        glm::vec3 position;
+    };
+
+    struct Cell {
+        glm::ivec3 coordinates;
+        uint phase; // spreads the frames in which distant cells are visited
+        std::vector<int> entries;
+    };
+
+    struct Region {
+        glm::ivec3 coordinates;
+        uint phase;
+        std::vector<int> cells;
+        int numEntries { 0 };
+    };
+
+    AvatarSpatialGrid(float cellSize = DEFAULT_AVATAR_GRID_CELL_SIZE) : _cellSize(cellSize) {}
+
+    /// empties the grid, remembering where each avatar was for insertAtLastKnownPosition()
+    void clear();
+    void insert(const SharedNodePointer& node, AvatarMixerClientData* nodeData, const glm::vec3& position);
+
+    /// inserts an avatar where it was before the last clear(), returns false if it wasn't in the grid then
+    bool insertAtLastKnownPosition(const SharedNodePointer& node, AvatarMixerClientData* nodeData);
+
+    const std::vector<Cell>& getCells() const { return _cells; }
+    const std::vector<Region>& getRegions() const { return _regions; }
+    const std::vector<Entry>& getEntries() const { return _entries; }
+    int getNumEntries() const { return (int)_entries.size(); }
+
+    float getCellSize() const { return _cellSize; }
+
+    /// returns the shortest distance from the given position to any point in the cell
+    float distanceToCell(const glm::vec3& position, const Cell& cell) const;
+    float distanceToRegion(const glm::vec3& position, const Region& region) const;
+
+    /// calls function(cell) for each occupied cell within range of the given position
+    template <typename F>
+    void forEachCellInRange(const glm::vec3& position, float range, F function) const;
+
+private:
+    glm::ivec3 cellCoordinatesForPosition(const glm::vec3& position) const;
+    static quint64 keyForCoordinates(const glm::ivec3& coordinates);
+
+    float _cellSize;
+
+    std::vector<Entry> _entries;
+    std::vector<Cell> _cells;
+    std::vector<Region> _regions;
+    std::unordered_map<quint64, int> _cellIndices;
+    std::unordered_map<quint64, int> _regionIndices;
+    std::unordered_map<QUuid, glm::vec3> _lastKnownPositions;
+};
+
+template <typename F>
+void AvatarSpatialGrid::forEachCellInRange(const glm::vec3& position, float range, F function) const {
+    // look up the cells around the position, unless there are fewer occupied cells than that to check
+    float cellsAcross = 2.0f * range / _cellSize + 2.0f;
+    if (cellsAcross * cellsAcross * cellsAcross >= (float)_cells.size()) {
+        for (auto& cell : _cells) {
+            if (distanceToCell(position, cell) <= range) {
+                function(cell);
+            }
+        }
+        return;
+    }
+
+    glm::ivec3 minimum = cellCoordinatesForPosition(position - glm::vec3(range));
+    glm::ivec3 maximum = cellCoordinatesForPosition(position + glm::vec3(range));
+    for (int x = minimum.x; x <= maximum.x; x++) {
+        for (int y = minimum.y; y <= maximum.y; y++) {
+            for (int z = minimum.z; z <= maximum.z; z++) {
+                auto it = _cellIndices.find(keyForCoordinates(glm::ivec3(x, y, z)));
+                if (it != _cellIndices.end() && distanceToCell(position, _cells[it->second]) <= range) {
+                    function(_cells[it->second]);
+                }
+            }
+        }
+    }
+}
+
+#endif // hifi_AvatarSpatialGrid_h
@@ -0,0 +1,45 @@
+//
+//  EntityNodeData.cpp
+//  assignment-client/src/entities
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityNodeData.h"
+
+// how often the send thread publishes its records for the stats page
+const quint64 SENT_ENTITIES_PUBLISH_INTERVAL_USECS = USECS_PER_SECOND;
+
+void EntityNodeData::trackSend(const QUuid& entityID, quint64 lastEdited) {
+    quint64 now = usecTimestampNow();
+    _unpublishedSends[entityID] = { now, lastEdited };
+
+    // records sent since the last publish show up once the viewer is sent anything after the interval
+    if (now - _sentEntitiesPublishedAt > SENT_ENTITIES_PUBLISH_INTERVAL_USECS) {
+        publishSentEntities(now);
+    }
+
+    _sendTrackingUsecs += usecTimestampNow() - now;
+    _sendTrackingCount++;
+}
+
+void EntityNodeData::publishSentEntities(quint64 now) {
+    // only the records that changed since the last publish are merged in, an entity sent many times in between
+    // is merged once
+    {
+        std::lock_guard<std::mutex> lock(_sentEntitiesMutex);
+        for (auto& entry : _unpublishedSends) {
+            _sentEntities[entry.first] = entry.second;
+        }
+    }
+    _unpublishedSends.clear();
+    _sentEntitiesPublishedAt = now;
+}
+
+EntityNodeData::SentEntities EntityNodeData::getSentEntities() const {
+    std::lock_guard<std::mutex> lock(_sentEntitiesMutex);
+    return _sentEntities;
+}
@@ -12,19 +12,52 @@
 #ifndef hifi_EntityNodeData_h
 #define hifi_EntityNodeData_h
 
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
 #include <udt/PacketHeaders.h>
+#include <UUIDHasher.h>
 
 #include "../octree/OctreeQueryNode.h"
 
 class EntityNodeData : public OctreeQueryNode {
 public:
+    struct SentEntityStats {
+        quint64 lastSent;
+        quint64 lastEdited;
+    };
+    using SentEntities = std::unordered_map<QUuid, SentEntityStats>;
+
     virtual PacketType getMyPacketType() const { return PacketType::EntityData; }
 
     quint64 getLastDeletedEntitiesSentAt() const { return _lastDeletedEntitiesSentAt; }
     void setLastDeletedEntitiesSentAt(quint64 sentAt) { _lastDeletedEntitiesSentAt = sentAt; }
 
+    // records that an entity was sent to this viewer, only to be called from this viewer's send thread
+    void trackSend(const QUuid& entityID, quint64 lastEdited);
+
+    // a copy of the records as of the last time the send thread published them, safe to call from any thread
+    SentEntities getSentEntities() const;
+    quint64 getSentEntitiesPublishedAt() const { return _sentEntitiesPublishedAt; }
+
+    // time the send thread has spent in trackSend, including any wait on the records lock, and the number of calls
+    quint64 getSendTrackingUsecs() const { return _sendTrackingUsecs; }
+    quint64 getSendTrackingCount() const { return _sendTrackingCount; }
+
 private:
+    void publishSentEntities(quint64 now);
+
     quint64 _lastDeletedEntitiesSentAt { usecTimestampNow() };
+
+    SentEntities _unpublishedSends; // sent since the last publish, only touched by the send thread
+
+    mutable std::mutex _sentEntitiesMutex;
+    SentEntities _sentEntities; // guarded by _sentEntitiesMutex
+    std::atomic<quint64> _sentEntitiesPublishedAt { 0 };
+
+    std::atomic<quint64> _sendTrackingUsecs { 0 };
+    std::atomic<quint64> _sendTrackingCount { 0 };
 };
 
 #endif // hifi_EntityNodeData_h
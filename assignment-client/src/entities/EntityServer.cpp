@@ -285,18 +285,13 @@ void EntityServer::nodeKilled(SharedNodePointer node) {
     OctreeServer::nodeKilled(node);
 }
 
-// FIXME - this stats tracking is somewhat temporary to debug the Whiteboard issues. It's not a bad
-// set of stats to have, but we'd probably want a different data structure if we keep it very long.
-// Since this version uses a single shared QMap for all senders, there could be some lock contention 
-// on this QWriteLocker
-void EntityServer::trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) {
-    QWriteLocker locker(&_viewerSendingStatsLock);
-    _viewerSendingStats[sessionID][dataID] = { usecTimestampNow(), dataLastEdited };
+// each viewer keeps the records of what was sent to it in its own node data, which only its send thread writes to,
+// so senders never contend with each other here, and the records go away along with the viewer's node
+void EntityServer::trackSend(const QUuid& dataID, quint64 dataLastEdited, OctreeQueryNode* viewerData) {
+    static_cast<EntityNodeData*>(viewerData)->trackSend(dataID, dataLastEdited);
 }
 
 void EntityServer::trackViewerGone(const QUuid& sessionID) {
-    QWriteLocker locker(&_viewerSendingStatsLock);
-    _viewerSendingStats.remove(sessionID);
     if (_entitySimulation) {
         _entitySimulation->clearOwnership(sessionID);
     }
@@ -312,23 +307,57 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    // entities sent whole reuse the encoding from the last time any viewer was sent them, unless they've changed
+    quint64 encodedHits = EntityItem::getEncodedDataHits();
+    quint64 encodedMisses = EntityItem::getEncodedDataMisses();
+    quint64 encodedLookups = encodedHits + encodedMisses;
+    float encodedHitRate = encodedLookups > 0 ? (float)encodedHits / (float)encodedLookups : 0.0f;
+    statsString += "<b>Entity Server Encoded Entity Cache</b>\r\n";
+    statsString += QString("           Hits: %1 of %2 (%3%)\r\n")
+        .arg(locale.toString((qulonglong)encodedHits))
+        .arg(locale.toString((qulonglong)encodedLookups))
+        .arg(locale.toString(encodedHitRate * 100.0f, 'f', 2));
+    statsString += QString("    Bytes saved: %1 bytes\r\n")
+        .arg(locale.toString((qulonglong)EntityItem::getEncodedDataBytesSaved()));
+    statsString += "\r\n\r\n";
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
 
     int viewers = 0;
     const int COLUMN_WIDTH = 24;
+    quint64 totalTrackingUsecs = 0;
+    quint64 totalTrackingCount = 0;
 
     {
-        QReadLocker locker(&_viewerSendingStatsLock);
-        quint64 now = usecTimestampNow();
+        // the records are copied from what each viewer's send thread last published, the send threads only wait on
+        // that copy when they publish, once a second
+        DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+            EntityNodeData* nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
+            if (!nodeData) {
+                return;
+            }
+
+            EntityNodeData::SentEntities sentEntities = nodeData->getSentEntities();
+            totalTrackingUsecs += nodeData->getSendTrackingUsecs();
+            totalTrackingCount += nodeData->getSendTrackingCount();
+            if (sentEntities.empty()) {
+                return;
+            }
+
+            // taken after the copy, so that nothing in it is more recent
+            quint64 now = usecTimestampNow();
 
-        for (auto viewerID : _viewerSendingStats.keys()) {
-            statsString += viewerID.toString() + "\r\n";
+            double publishedMsecsAgo = (double)((now - nodeData->getSentEntitiesPublishedAt()) / USECS_PER_MSEC);
+            statsString += node->getUUID().toString();
+            statsString += QString(" - %1 entities, as of %2 msecs ago\r\n")
+                .arg(locale.toString((uint)sentEntities.size()))
+                .arg(locale.toString(publishedMsecsAgo));
 
-            auto viewerData = _viewerSendingStats[viewerID];
-            for (auto entityID : viewerData.keys()) {
-                ViewerSendingStats stats = viewerData[entityID];
+            for (auto& entry : sentEntities) {
+                const QUuid& entityID = entry.first;
+                const EntityNodeData::SentEntityStats& stats = entry.second;
 
                 quint64 elapsedSinceSent = now - stats.lastSent;
                 double sentMsecsAgo = (double)(elapsedSinceSent / USECS_PER_MSEC);
@@ -346,11 +375,19 @@ QString EntityServer::serverSubclassStats() {
                 statsString += "\r\n";
             }
             viewers++;
-        }
+        });
     }
     if (viewers < 1) {
         statsString += "    no viewers... \r\n";
     }
+    statsString += "\r\n";
+    // the time the send threads spend recording what they sent, which used to include waiting on one lock shared by
+    // every send thread
+    double averageTrackingUsecs = totalTrackingCount > 0 ? (double)totalTrackingUsecs / (double)totalTrackingCount : 0.0;
+    statsString += QString("Send tracking time (all viewers): %1 usecs for %2 sends, %3 usecs per send\r\n")
+        .arg(locale.toString((qulonglong)totalTrackingUsecs))
+        .arg(locale.toString((qulonglong)totalTrackingCount))
+        .arg(locale.toString(averageTrackingUsecs, 'f', 3));
     statsString += "\r\n\r\n";
 
     return statsString;
@@ -22,11 +22,6 @@
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
 
-struct ViewerSendingStats {
-    quint64 lastSent;
-    quint64 lastEdited;
-};
-
 class SimpleEntitySimulation;
 
 class EntityServer : public OctreeServer, public NewlyCreatedEntityHook {
@@ -54,7 +49,7 @@ public:
     virtual void readAdditionalConfiguration(const QJsonObject& settingsSectionObject) override;
     virtual QString serverSubclassStats() override;
 
-    virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) override;
+    virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, OctreeQueryNode* viewerData) override;
     virtual void trackViewerGone(const QUuid& sessionID) override;
 
 public slots:
@@ -71,9 +66,6 @@ private slots:
 private:
     SimpleEntitySimulation* _entitySimulation;
     QTimer* _pruneDeletedEntitiesTimer = nullptr;
-
-    QReadWriteLock _viewerSendingStatsLock;
-    QMap<QUuid, QMap<QUuid, ViewerSendingStats>> _viewerSendingStats;
 };
 
 #endif // hifi_EntityServer_h
@@ -9,6 +9,7 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <algorithm>
 #include <limits>
 
 #include <NumericalConstants.h>
@@ -22,14 +23,25 @@
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
 
+// Decoded edits are applied once a processing pass is done, or sooner if this many are waiting. While applying them we
+// let go of the write lock after MAX_EDIT_LOCK_HOLD_USECS so the send threads' readers aren't held off for too long.
+const size_t MAX_PENDING_EDITS = 1000;
+const quint64 MAX_EDIT_LOCK_HOLD_USECS = 5 * USECS_PER_MSEC;
+
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
     _receivedPacketCount(0),
     _totalTransitTime(0),
     _totalProcessTime(0),
     _totalLockWaitTime(0),
+    _maxLockWaitTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
+    _totalEditLocks(0),
+    _totalEditsApplied(0),
+    _totalLockHoldTime(0),
+    _maxLockHoldTime(0),
+    _totalEditQueueTime(0),
     _lastNackTime(usecTimestampNow()),
     _shuttingDown(false)
 {
@@ -39,8 +51,14 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalTransitTime = 0;
     _totalProcessTime = 0;
     _totalLockWaitTime = 0;
+    _maxLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalEditLocks = 0;
+    _totalEditsApplied = 0;
+    _totalLockHoldTime = 0;
+    _maxLockHoldTime = 0;
+    _totalEditQueueTime = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -75,6 +93,10 @@ void OctreeInboundPacketProcessor::midProcess() {
     }
 }
 
+void OctreeInboundPacketProcessor::postProcess() {
+    applyPendingEdits();
+}
+
 void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (_shuttingDown) {
         qDebug() << "OctreeInboundPacketProcessor::processPacket() while shutting down... ignoring incoming packet";
@@ -113,8 +135,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
 
         quint64 transitTime = arrivedAt - sentAt;
         int editsInPacket = 0;
-        quint64 processTime = 0;
-        quint64 lockWaitTime = 0;
+        quint64 decodeTime = 0;
 
         if (debugProcessPacket || _myServer->wantsDebugReceiving()) {
             qDebug() << "PROCESSING THREAD: got '" << packetType << "' packet - " << _receivedPacketCount << " command from client";
@@ -157,33 +178,35 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
-            quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
-                startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
-            });
-            quint64 endProcess = usecTimestampNow();
+            // decode and validate without the tree lock, the edit is applied later along with the rest of its batch
+            quint64 startDecode = usecTimestampNow();
+            int editDataBytesRead = 0;
+            OctreeEditPointer edit =
+                _myServer->getOctree()->decodeEditPacketData(*message, editData, maxSize, sendingNode, editDataBytesRead);
+            quint64 endDecode = usecTimestampNow();
 
             if (debugProcessPacket) {
-                qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
+                qDebug() << "OctreeInboundPacketProcessor::processPacket() after decodeEditPacketData()..."
                     << "editDataBytesRead=" << editDataBytesRead;
             }
 
-            editsInPacket++;
-            quint64 thisProcessTime = endProcess - startProcess;
-            quint64 thisLockWaitTime = startProcess - startLock;
-            processTime += thisProcessTime;
-            lockWaitTime += thisLockWaitTime;
+            decodeTime += endDecode - startDecode;
+            if (edit) {
+                editsInPacket++;
+                _pendingEdits.push_back({ std::move(edit), endDecode });
+            }
+
+            if (editDataBytesRead <= 0) {
+                break; // the tree couldn't make sense of the rest of the packet
+            }
 
             // skip to next edit record in the packet
             message->seek(message->getPosition() + editDataBytesRead);
 
             if (debugProcessPacket) {
                 qDebug() << "    editDataBytesRead=" << editDataBytesRead;
-                qDebug() << "    AFTER processEditPacketData payload position=" << message->getPosition();
-                qDebug() << "    AFTER processEditPacketData payload size=" << message->getSize();
+                qDebug() << "    AFTER decodeEditPacketData payload position=" << message->getPosition();
+                qDebug() << "    AFTER decodeEditPacketData payload size=" << message->getSize();
             }
 
         }
@@ -206,18 +229,81 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                 qDebug() << "sender has no known nodeUUID.";
             }
         }
-        trackInboundPacket(nodeUUID, sequence, transitTime, editsInPacket, processTime, lockWaitTime);
+        _pendingPackets.push_back({ nodeUUID, sequence, transitTime, editsInPacket, decodeTime });
+
+        if (_pendingEdits.size() >= MAX_PENDING_EDITS) {
+            applyPendingEdits();
+        }
     } else {
         qDebug("unknown packet ignored... packetType=%hhu", packetType);
     }
 }
 
+void OctreeInboundPacketProcessor::applyPendingEdits() {
+    if (_pendingPackets.empty()) {
+        return;
+    }
+
+    auto tree = _myServer->getOctree();
+    quint64 batchLockWaitTime = 0;
+    quint64 batchApplyTime = 0;
+
+    size_t applied = 0;
+    while (applied < _pendingEdits.size()) {
+        quint64 startLock = usecTimestampNow();
+        quint64 startApply = 0;
+        quint64 editQueueTime = 0;
+        size_t editsThisLock = 0;
+
+        tree->withWriteLock([&] {
+            startApply = usecTimestampNow();
+            quint64 now = startApply;
+            do {
+                PendingEdit& pending = _pendingEdits[applied + editsThisLock];
+                editQueueTime += now - pending.decodedAt;
+                tree->applyEdit(*pending.edit);
+                editsThisLock++;
+                now = usecTimestampNow();
+            } while (applied + editsThisLock < _pendingEdits.size() && now - startApply < MAX_EDIT_LOCK_HOLD_USECS);
+        });
+        quint64 endApply = usecTimestampNow();
+
+        quint64 lockHoldTime = endApply - startApply;
+        _totalEditLocks++;
+        _totalEditsApplied += editsThisLock;
+        _totalLockHoldTime += lockHoldTime;
+        if (lockHoldTime > _maxLockHoldTime) {
+            _maxLockHoldTime = lockHoldTime; // edits are only applied from the processing thread
+        }
+        _totalEditQueueTime += editQueueTime;
+
+        batchLockWaitTime += startApply - startLock;
+        batchApplyTime += lockHoldTime;
+        applied += editsThisLock;
+    }
+
+    // share the batch's lock wait and apply time out between its packets by how many edits each contributed
+    size_t totalEdits = std::max((size_t)1, _pendingEdits.size());
+    for (auto& packet : _pendingPackets) {
+        quint64 lockWaitTime = batchLockWaitTime * packet.editsInPacket / totalEdits;
+        quint64 processTime = packet.decodeTime + batchApplyTime * packet.editsInPacket / totalEdits;
+        trackInboundPacket(packet.nodeUUID, packet.sequence, packet.transitTime, packet.editsInPacket,
+                           processTime, lockWaitTime);
+    }
+
+    _pendingEdits.clear();
+    _pendingPackets.clear();
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
     _totalTransitTime += transitTime;
     _totalProcessTime += processTime;
     _totalLockWaitTime += lockWaitTime;
+    if (lockWaitTime > _maxLockWaitTime) {
+        _maxLockWaitTime = lockWaitTime; // packets are only tracked from the processing thread
+    }
     _totalElementsInPacket += editsInPacket;
     _totalPackets++;
 
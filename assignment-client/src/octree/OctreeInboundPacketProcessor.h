@@ -14,6 +14,9 @@
 #ifndef hifi_OctreeInboundPacketProcessor_h
 #define hifi_OctreeInboundPacketProcessor_h
 
+#include <vector>
+
+#include <Octree.h>
 #include <ReceivedPacketProcessor.h>
 
 #include "SequenceNumberStats.h"
@@ -63,6 +66,7 @@ public:
     quint64 getAverageTransitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalTransitTime / _totalPackets; }
     quint64 getAverageProcessTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalProcessTime / _totalPackets; }
     quint64 getAverageLockWaitTimePerPacket() const { return _totalPackets == 0 ? 0 : _totalLockWaitTime / _totalPackets; }
+    quint64 getMaxLockWaitTimePerPacket() const { return _maxLockWaitTime; }
     quint64 getTotalElementsProcessed() const { return _totalElementsInPacket; }
     quint64 getTotalPacketsProcessed() const { return _totalPackets; }
     quint64 getAverageProcessTimePerElement() const
@@ -70,6 +74,11 @@ public:
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
 
+    float getAverageEditsPerLock() const { return _totalEditLocks == 0 ? 0.0f : (float)_totalEditsApplied / _totalEditLocks; }
+    quint64 getAverageLockHoldTime() const { return _totalEditLocks == 0 ? 0 : _totalLockHoldTime / _totalEditLocks; }
+    quint64 getMaxLockHoldTime() const { return _maxLockHoldTime; }
+    quint64 getAverageEditQueueTime() const { return _totalEditsApplied == 0 ? 0 : _totalEditQueueTime / _totalEditsApplied; }
+
     void resetStats();
 
     NodeToSenderStatsMap getSingleSenderStats() { QReadLocker locker(&_senderStatsLock); return _singleSenderStats; }
@@ -83,10 +92,25 @@ protected:
     virtual unsigned long getMaxWait() const;
     virtual void preProcess();
     virtual void midProcess();
+    virtual void postProcess();
 
 private:
     int sendNackPackets();
 
+    // Edits are decoded as packets are processed, then applied in batches under a single write lock
+    struct PendingEdit {
+        OctreeEditPointer edit;
+        quint64 decodedAt;
+    };
+    struct PendingPacket {
+        QUuid nodeUUID;
+        unsigned short int sequence;
+        quint64 transitTime;
+        int editsInPacket;
+        quint64 decodeTime;
+    };
+    void applyPendingEdits();
+
 private:
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
@@ -97,8 +121,18 @@ private:
     std::atomic<uint64_t> _totalTransitTime;
     std::atomic<uint64_t> _totalProcessTime;
     std::atomic<uint64_t> _totalLockWaitTime;
+    std::atomic<uint64_t> _maxLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+
+    std::vector<PendingEdit> _pendingEdits;
+    std::vector<PendingPacket> _pendingPackets;
+
+    std::atomic<uint64_t> _totalEditLocks;
+    std::atomic<uint64_t> _totalEditsApplied;
+    std::atomic<uint64_t> _totalLockHoldTime;
+    std::atomic<uint64_t> _maxLockHoldTime;
+    std::atomic<uint64_t> _totalEditQueueTime;
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
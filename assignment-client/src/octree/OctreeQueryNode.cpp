@@ -300,3 +300,8 @@ void OctreeQueryNode::parseNackPacket(ReceivedMessage& message) {
         _nackedSequenceNumbers.enqueue(sequenceNumber);
     }
 }
+
+void OctreeQueryNode::trackSchedulingLatency(quint64 latency) {
+    _lastSchedulingLatency = latency;
+    _averageSchedulingLatency.updateAverage((float)latency);
+}
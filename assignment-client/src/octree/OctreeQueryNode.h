@@ -12,6 +12,7 @@
 #ifndef hifi_OctreeQueryNode_h
 #define hifi_OctreeQueryNode_h
 
+#include <atomic>
 #include <iostream>
 
 #include <NodeData.h>
@@ -20,10 +21,10 @@
 #include <OctreePacketData.h>
 #include <OctreeQuery.h>
 #include <OctreeSceneStats.h>
+#include <SimpleMovingAverage.h>
 #include "SentPacketHistory.h"
 #include <qqueue.h>
 
-class OctreeSendThread;
 class OctreeServer;
 
 class OctreeQueryNode : public OctreeQuery {
@@ -55,6 +56,7 @@ public:
 
     OctreeElementBag elementBag;
     OctreeElementExtraEncodeData extraEncodeData;
+    OctreePacketData packetData; // encode buffer for whichever send worker is currently serving this viewer
 
     ViewFrustum& getCurrentViewFrustum() { return _currentViewFrustum; }
     ViewFrustum& getLastKnownViewFrustum() { return _lastKnownViewFrustum; }
@@ -100,6 +102,11 @@ public:
     bool hasNextNackedPacket() const;
     const NLPacket* getNextNackedPacket();
 
+    // how late, in usecs, sends to this viewer are handed to a send worker
+    void trackSchedulingLatency(quint64 latency);
+    quint64 getLastSchedulingLatency() const { return _lastSchedulingLatency; }
+    float getAverageSchedulingLatency() const { return _averageSchedulingLatency.getAverage(); }
+
 private:
     OctreeQueryNode(const OctreeQueryNode &);
     OctreeQueryNode& operator= (const OctreeQueryNode&);
@@ -120,8 +127,6 @@ private:
     bool _viewFrustumChanging { false };
     bool _viewFrustumJustStoppedChanging { true };
 
-    OctreeSendThread* _octreeSendThread { nullptr };
-
     // watch for LOD changes
     int _lastClientBoundaryLevelAdjust { 0 };
     float _lastClientOctreeSizeScale { DEFAULT_OCTREE_SIZE_SCALE };
@@ -141,6 +146,9 @@ private:
     quint64 _sceneSendStartTime = 0;
     
     std::array<char, udt::MAX_PACKET_SIZE> _lastOctreePayload;
+
+    std::atomic<quint64> _lastSchedulingLatency { 0 };
+    SimpleMovingAverage _averageSchedulingLatency;
 };
 
 #endif // hifi_OctreeQueryNode_h
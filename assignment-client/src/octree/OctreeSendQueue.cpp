@@ -0,0 +1,128 @@
+//
+//  OctreeSendQueue.cpp
+//  assignment-client/src/octree
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendQueue.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+bool OctreeSendQueue::addViewer(const SharedNodePointer& node) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _viewers.find(node->getUUID());
+    if (it != _viewers.end()) {
+        // the viewer may have reconnected since it was removed, in which case it stays with whoever was sending to it
+        it->second.node = node;
+        if (!it->second.isRemoved) {
+            return false;
+        }
+        it->second.isRemoved = false;
+        _viewerCount++;
+        return true;
+    }
+
+    _viewerCount++;
+    Viewer& viewer = _viewers[node->getUUID()];
+    viewer.node = node;
+    enqueue(node->getUUID(), viewer, usecTimestampNow());
+    return true;
+}
+
+void OctreeSendQueue::removeViewer(const QUuid& viewerID) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _viewers.find(viewerID);
+    if (it == _viewers.end() || it->second.isRemoved) {
+        return;
+    }
+
+    _viewerCount--;
+    if (it->second.isTaken) {
+        it->second.isRemoved = true;
+    } else {
+        _dueViewers.erase(DueViewer(it->second.sendTime, it->second.order, viewerID));
+        _viewers.erase(it);
+    }
+}
+
+SharedNodePointer OctreeSendQueue::takeNextViewer(quint64 maxWaitUsecs, quint64& schedulingLatency) {
+    QMutexLocker locker(&_mutex);
+
+    quint64 giveUpAt = usecTimestampNow() + maxWaitUsecs;
+    while (!_isStopped) {
+        quint64 now = usecTimestampNow();
+        quint64 wakeAt = giveUpAt;
+
+        if (!_dueViewers.empty()) {
+            quint64 sendTime = std::get<0>(*_dueViewers.begin());
+            if (sendTime <= now) {
+                QUuid viewerID = std::get<2>(*_dueViewers.begin());
+                _dueViewers.erase(_dueViewers.begin());
+
+                auto it = _viewers.find(viewerID);
+                SharedNodePointer node = it->second.node.lock();
+                if (!node) {
+                    // the node went away without being removed, forget about it
+                    _viewers.erase(it);
+                    _viewerCount--;
+                    continue;
+                }
+
+                it->second.isTaken = true;
+                schedulingLatency = now - sendTime;
+                return node;
+            }
+            wakeAt = std::min(wakeAt, sendTime);
+        }
+
+        if (now >= giveUpAt) {
+            break;
+        }
+
+        // round up, so we don't spin on a sub-millisecond wait
+        unsigned long waitMsecs = (unsigned long)((wakeAt - now + USECS_PER_MSEC - 1) / USECS_PER_MSEC);
+        _viewerDue.wait(&_mutex, waitMsecs);
+    }
+
+    return SharedNodePointer();
+}
+
+void OctreeSendQueue::returnViewer(const QUuid& viewerID, quint64 nextSendTime) {
+    QMutexLocker locker(&_mutex);
+
+    auto it = _viewers.find(viewerID);
+    if (it == _viewers.end()) {
+        return;
+    }
+
+    it->second.isTaken = false;
+    if (it->second.isRemoved) {
+        _viewers.erase(it);
+    } else {
+        enqueue(viewerID, it->second, nextSendTime);
+    }
+}
+
+void OctreeSendQueue::stop() {
+    QMutexLocker locker(&_mutex);
+    _isStopped = true;
+    _viewerDue.wakeAll();
+}
+
+void OctreeSendQueue::enqueue(const QUuid& viewerID, Viewer& viewer, quint64 sendTime) {
+    viewer.sendTime = sendTime;
+    viewer.order = _enqueueCount++;
+    _dueViewers.emplace(viewer.sendTime, viewer.order, viewerID);
+
+    // a waiting worker may be sleeping until a later viewer is due
+    _viewerDue.wakeOne();
+}
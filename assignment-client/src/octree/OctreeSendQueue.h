@@ -0,0 +1,74 @@
+//
+//  OctreeSendQueue.h
+//  assignment-client/src/octree
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSendQueue_h
+#define hifi_OctreeSendQueue_h
+
+#include <atomic>
+#include <set>
+#include <tuple>
+#include <unordered_map>
+
+#include <QMutex>
+#include <QUuid>
+#include <QWaitCondition>
+
+#include <Node.h>
+#include <UUIDHasher.h>
+
+/// Run queue of the viewers an octree server is sending to, shared by its pool of send workers. Viewers are handed out
+/// in order of the time their next send is due (ties go to whoever was queued first), and a viewer that has been taken
+/// is not handed to another worker until it is returned, so at most one worker is ever sending to a given viewer.
+class OctreeSendQueue {
+public:
+    /// Queues a viewer to be sent to right away. Returns false if it was already queued, in which case only the node
+    /// it is sent through is updated.
+    bool addViewer(const SharedNodePointer& node);
+
+    /// Stops sending to a viewer. If a worker is currently sending to it, it is dropped when that worker returns it.
+    void removeViewer(const QUuid& viewerID);
+
+    /// Blocks for up to maxWaitUsecs until a viewer's send is due and hands it out, along with how late it is being
+    /// handed out. Returns a null pointer if nothing came due in time or the queue has been stopped.
+    SharedNodePointer takeNextViewer(quint64 maxWaitUsecs, quint64& schedulingLatency);
+
+    /// Hands a viewer taken with takeNextViewer() back to the queue, due again at nextSendTime.
+    void returnViewer(const QUuid& viewerID, quint64 nextSendTime);
+
+    int getViewerCount() const { return _viewerCount; }
+
+    /// Wakes all waiting workers and stops handing out viewers.
+    void stop();
+    bool isStopped() const { return _isStopped; }
+
+private:
+    struct Viewer {
+        QWeakPointer<Node> node;
+        quint64 sendTime { 0 };
+        quint64 order { 0 };
+        bool isTaken { false };
+        bool isRemoved { false };
+    };
+
+    // next send time, order queued, viewer
+    using DueViewer = std::tuple<quint64, quint64, QUuid>;
+
+    void enqueue(const QUuid& viewerID, Viewer& viewer, quint64 sendTime);
+
+    mutable QMutex _mutex;
+    QWaitCondition _viewerDue;
+    std::unordered_map<QUuid, Viewer> _viewers;
+    std::set<DueViewer> _dueViewers; // viewers not currently taken by a worker
+    quint64 _enqueueCount { 0 };
+    std::atomic<int> _viewerCount { 0 }; // not counting removed viewers a worker still holds
+    std::atomic<bool> _isStopped { false };
+};
+
+#endif // hifi_OctreeSendQueue_h
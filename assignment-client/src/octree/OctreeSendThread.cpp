@@ -12,50 +12,24 @@
 #include <NodeList.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
-#include <PerfStat.h>
 
 #include "OctreeQueryNode.h"
+#include "OctreeSendQueue.h"
 #include "OctreeSendThread.h"
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
 #include "OctreeLogging.h"
 
-quint64 startSceneSleepTime = 0;
-quint64 endSceneSleepTime = 0;
-
-OctreeSendThread::OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
+OctreeSendThread::OctreeSendThread(OctreeServer* myServer, OctreeSendQueue& sendQueue, int workerIndex) :
     _myServer(myServer),
-    _node(node),
-    _nodeUuid(node->getUUID())
+    _sendQueue(sendQueue)
 {
-    QString safeServerName("Octree");
-
     // set our QThread object name so we can identify this thread while debugging
-    setObjectName(QString("Octree Send Thread (%1)").arg(uuidStringWithoutCurlyBraces(_nodeUuid)));
-
-    if (_myServer) {
-        safeServerName = _myServer->getMyServerName();
-    }
-
-    qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client connected "
-                                            "- starting sending thread [" << this << "]";
-
-    OctreeServer::clientConnected();
+    setObjectName(QString("Octree Send Thread %1").arg(workerIndex));
 }
 
 OctreeSendThread::~OctreeSendThread() {
     setIsShuttingDown();
-    
-    QString safeServerName("Octree");
-    if (_myServer) {
-        safeServerName = _myServer->getMyServerName();
-    }
-
-    qDebug() << qPrintable(safeServerName)  << "server [" << _myServer << "]: client disconnected "
-                                            "- ending sending thread [" << this << "]";
-
-    OctreeServer::clientDisconnected();
-    OctreeServer::stopTrackingThread(this);
 }
 
 void OctreeSendThread::setIsShuttingDown() {
@@ -64,57 +38,50 @@ void OctreeSendThread::setIsShuttingDown() {
 
 
 bool OctreeSendThread::process() {
-    if (_isShuttingDown) {
+    if (_isShuttingDown || _sendQueue.isStopped()) {
         return false; // exit early if we're shutting down
     }
 
-    OctreeServer::didProcess(this);
+    // wait for the next viewer that's due a send, giving up after an interval so we notice being terminated
+    quint64 schedulingLatency = 0;
+    SharedNodePointer node = _sendQueue.takeNextViewer(OCTREE_SEND_INTERVAL_USECS, schedulingLatency);
+    if (!node) {
+        return isStillRunning();
+    }
+
+    quint64 start = usecTimestampNow();
+    QUuid viewerID = node->getUUID();
 
-    quint64  start = usecTimestampNow();
+    OctreeServer::didProcess(viewerID);
+    OctreeServer::trackSchedulingLatency((float)schedulingLatency);
 
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
-    // don't do any send processing until the initial load of the octree is complete...
-    if (_myServer->isInitialLoadComplete()) {
-        if (auto node = _node.lock()) {
-            _nodeMissingCount = 0;
-            OctreeQueryNode* nodeData = static_cast<OctreeQueryNode*>(node->getLinkedData());
+    OctreeQueryNode* nodeData = static_cast<OctreeQueryNode*>(node->getLinkedData());
 
-            // Sometimes the node data has not yet been linked, in which case we can't really do anything
-            if (nodeData && !nodeData->isShuttingDown()) {
-                bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
-                packetDistributor(node, nodeData, viewFrustumChanged);
-            }
-        } else {
-            return false; // exit early if we're shutting down
-        }
-    }
-
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
-    }
+    // Sometimes the node data has not yet been linked, in which case we can't really do anything
+    if (nodeData) {
+        nodeData->trackSchedulingLatency(schedulingLatency);
 
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
+        // don't do any send processing until the initial load of the octree is complete...
+        if (_myServer->isInitialLoadComplete() && !nodeData->isShuttingDown()) {
+            bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
+            packetDistributor(node, nodeData, viewFrustumChanged);
+        }
 
-        if (usecToSleep > 0) {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            usleep(usecToSleep);
-        } else {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usleep(MIN_USEC_TO_SLEEP);
+        if (nodeData->isShuttingDown()) {
+            _sendQueue.removeViewer(viewerID);
+            OctreeServer::stopTrackingViewer(viewerID);
         }
     }
 
+    // the viewer is next due one send interval after this one started
+    _sendQueue.returnViewer(viewerID, start + OCTREE_SEND_INTERVAL_USECS);
+
     return isStillRunning();  // keep running till they terminate us
 }
 
-AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
-AtomicUIntStat OctreeSendThread::_usleepCalls { 0 };
 AtomicUIntStat OctreeSendThread::_totalBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalWastedBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalPackets { 0 };
@@ -125,7 +92,7 @@ AtomicUIntStat OctreeSendThread::_totalSpecialPackets { 0 };
 
 int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, int& trueBytesSent,
                                        int& truePacketsSent, bool dontSuppressDuplicate) {
-    OctreeServer::didHandlePacketSend(this);
+    OctreeServer::didHandlePacketSend(node->getUUID());
 
     // if we're shutting down, then exit early
     if (nodeData->isShuttingDown()) {
@@ -183,12 +150,12 @@ int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode*
             }
 
             // actually send it
-            OctreeServer::didCallWriteDatagram(this);
+            OctreeServer::didCallWriteDatagram(node->getUUID());
             DependencyManager::get<NodeList>()->sendUnreliablePacket(statsPacket, *node);
             packetSent = true;
         } else {
             // not enough room in the packet, send two packets
-            OctreeServer::didCallWriteDatagram(this);
+            OctreeServer::didCallWriteDatagram(node->getUUID());
             DependencyManager::get<NodeList>()->sendUnreliablePacket(statsPacket, *node);
 
             // since a stats message is only included on end of scene, don't consider any of these bytes "wasted", since
@@ -219,7 +186,7 @@ int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode*
             truePacketsSent++;
             packetsSent++;
 
-            OctreeServer::didCallWriteDatagram(this);
+            OctreeServer::didCallWriteDatagram(node->getUUID());
             DependencyManager::get<NodeList>()->sendUnreliablePacket(nodeData->getPacket(), *node);
             packetSent = true;
 
@@ -251,7 +218,7 @@ int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode*
         // If there's actually a packet waiting, then send it.
         if (nodeData->isPacketWaiting() && !nodeData->isShuttingDown()) {
             // just send the octree packet
-            OctreeServer::didCallWriteDatagram(this);
+            OctreeServer::didCallWriteDatagram(node->getUUID());
             DependencyManager::get<NodeList>()->sendUnreliablePacket(nodeData->getPacket(), *node);
             packetSent = true;
 
@@ -296,7 +263,7 @@ int OctreeSendThread::handlePacketSend(SharedNodePointer node, OctreeQueryNode*
 /// Version of octree element distributor that sends the deepest LOD level at once
 int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged) {
 
-    OctreeServer::didPacketDistributor(this);
+    OctreeServer::didPacketDistributor(node->getUUID());
 
     // if shutting down, exit early
     if (nodeData->isShuttingDown()) {
@@ -330,7 +297,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
     int targetSize = MAX_OCTREE_PACKET_DATA_SIZE;
     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
-    _packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
+    nodeData->packetData.changeSettings(true, targetSize); // FIXME - eventually support only compressed packets
 
     const ViewFrustum* lastViewFrustum = viewFrustumChanged ? &nodeData->getLastKnownViewFrustum() : NULL;
 
@@ -431,9 +398,10 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                                                  &nodeData->extraEncodeData);
 
                     // Our trackSend() function is implemented by the server subclass, and will be called back
-                    // during the encodeTreeBitstream() as new entities/data elements are sent 
-                    params.trackSend = [this, node](const QUuid& dataID, quint64 dataEdited) {
-                        _myServer->trackSend(dataID, dataEdited, node->getUUID());
+                    // during the encodeTreeBitstream() as new entities/data elements are sent. It is handed the
+                    // viewer's node data so it can keep its records there, without locking against other senders
+                    params.trackSend = [this, nodeData](const QUuid& dataID, quint64 dataEdited) {
+                        _myServer->trackSend(dataID, dataEdited, nodeData);
                     };
 
                     // TODO: should this include the lock time or not? This stat is sent down to the client,
@@ -441,7 +409,7 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                     // are reported to client. Since you can encode without the lock
                     nodeData->stats.encodeStarted();
 
-                    bytesWritten = _myServer->getOctree()->encodeTreeBitstream(subTree, &_packetData, nodeData->elementBag, params);
+                    bytesWritten = _myServer->getOctree()->encodeTreeBitstream(subTree, &nodeData->packetData, nodeData->elementBag, params);
 
                     quint64 encodeEnd = usecTimestampNow();
                     encodeElapsedUsec = (float)(encodeEnd - encodeStart);
@@ -468,24 +436,24 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
             // little bit more in this packet. To do this we write into the packet, but don't send it yet, we'll
             // keep attempting to write in compressed mode to add more compressed segments
 
-            // We only consider sending anything if there is something in the _packetData to send... But
+            // We only consider sending anything if there is something in the packetData to send... But
             // if bytesWritten == 0 it means either the subTree couldn't fit or we had an empty bag... Both cases
             // mean we should send the previous packet contents and reset it.
             if (completedScene || lastNodeDidntFit) {
 
-                if (_packetData.hasContent()) {
+                if (nodeData->packetData.hasContent()) {
                     quint64 compressAndWriteStart = usecTimestampNow();
 
                     // if for some reason the finalized size is greater than our available size, then probably the "compressed"
                     // form actually inflated beyond our padding, and in this case we will send the current packet, then
                     // write to out new packet...
-                    unsigned int writtenSize = _packetData.getFinalizedSize() + sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
+                    unsigned int writtenSize = nodeData->packetData.getFinalizedSize() + sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE);
 
                     if (writtenSize > nodeData->getAvailable()) {
                         packetsSentThisInterval += handlePacketSend(node, nodeData, trueBytesSent, truePacketsSent);
                     }
 
-                    nodeData->writeToPacket(_packetData.getFinalizedData(), _packetData.getFinalizedSize());
+                    nodeData->writeToPacket(nodeData->packetData.getFinalizedData(), nodeData->packetData.getFinalizedSize());
                     quint64 compressAndWriteEnd = usecTimestampNow();
                     compressAndWriteElapsedUsec = (float)(compressAndWriteEnd - compressAndWriteStart);
                 }
@@ -510,14 +478,14 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
                     extraPackingAttempts = 0;
                 } else {
                     // If we're in compressed mode, then we want to see if we have room for more in this wire packet.
-                    // but we've finalized the _packetData, so we want to start a new section, we will do that by
+                    // but we've finalized the packetData, so we want to start a new section, we will do that by
                     // resetting the packet settings with the max uncompressed size of our current available space
                     // in the wire packet. We also include room for our section header, and a little bit of padding
                     // to account for the fact that whenc compressing small amounts of data, we sometimes end up with
                     // a larger compressed size then uncompressed size
                     targetSize = nodeData->getAvailable() - sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE) - COMPRESS_PADDING;
                 }
-                _packetData.changeSettings(true, targetSize); // will do reset - NOTE: Always compressed
+                nodeData->packetData.changeSettings(true, targetSize); // will do reset - NOTE: Always compressed
 
             }
             OctreeServer::trackTreeWaitTime(lockWaitElapsedUsec);
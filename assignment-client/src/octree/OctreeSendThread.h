@@ -19,21 +19,22 @@
 #include <GenericThread.h>
 
 class OctreeQueryNode;
+class OctreeSendQueue;
 class OctreeServer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
+/// One of an octree server's pool of threads for sending octree packets. Each pass takes the viewer whose send is due
+/// soonest from the server's OctreeSendQueue and sends it one interval's worth of packets. All of a viewer's sending
+/// state lives in its OctreeQueryNode, so any worker can serve any viewer.
 class OctreeSendThread : public GenericThread {
     Q_OBJECT
 public:
-    OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
+    OctreeSendThread(OctreeServer* myServer, OctreeSendQueue& sendQueue, int workerIndex);
     virtual ~OctreeSendThread();
 
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
-    
-    QUuid getNodeUuid() const { return _nodeUuid; }
 
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
@@ -42,9 +43,6 @@ public:
     static AtomicUIntStat _totalSpecialBytes;
     static AtomicUIntStat _totalSpecialPackets;
 
-    static AtomicUIntStat _usleepTime;
-    static AtomicUIntStat _usleepCalls;
-
 protected:
     /// Implements generic processing behavior for this thread.
     virtual bool process();
@@ -52,15 +50,10 @@ protected:
 private:
     int handlePacketSend(SharedNodePointer node, OctreeQueryNode* nodeData, int& trueBytesSent, int& truePacketsSent, bool dontSuppressDuplicate = false);
     int packetDistributor(SharedNodePointer node, OctreeQueryNode* nodeData, bool viewFrustumChanged);
-    
-    
-    OctreeServer* _myServer { nullptr };
-    QWeakPointer<Node> _node;
-    QUuid _nodeUuid;
 
-    OctreePacketData _packetData;
+    OctreeServer* _myServer { nullptr };
+    OctreeSendQueue& _sendQueue;
 
-    int _nodeMissingCount { 0 };
     bool _isShuttingDown { false };
 };
 
@@ -12,6 +12,7 @@
 #include "OctreeServer.h"
 
 #include <QJsonObject>
+#include <QThread>
 #include <QTimer>
 
 #include <time.h>
@@ -31,7 +32,6 @@
 #include <ServerPathUtils.h>
 #include <QtCore/QDir>
 
-int OctreeServer::_clientCount = 0;
 const int MOVING_AVERAGE_SAMPLE_COUNTS = 1000000;
 
 float OctreeServer::SKIP_TIME = -1.0f; // use this for trackXXXTime() calls for non-times
@@ -52,6 +52,7 @@ SimpleMovingAverage OctreeServer::_averageTreeWaitTime(MOVING_AVERAGE_SAMPLE_COU
 SimpleMovingAverage OctreeServer::_averageTreeShortWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 SimpleMovingAverage OctreeServer::_averageTreeLongWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
 SimpleMovingAverage OctreeServer::_averageTreeExtraLongWaitTime(MOVING_AVERAGE_SAMPLE_COUNTS);
+float OctreeServer::_maxTreeWaitTime = 0.0f;
 int OctreeServer::_extraLongTreeWait = 0;
 int OctreeServer::_longTreeWait = 0;
 int OctreeServer::_shortTreeWait = 0;
@@ -80,6 +81,9 @@ int OctreeServer::_longProcessWait = 0;
 int OctreeServer::_shortProcessWait = 0;
 int OctreeServer::_noProcessWait = 0;
 
+SimpleMovingAverage OctreeServer::_averageSchedulingLatency(MOVING_AVERAGE_SAMPLE_COUNTS);
+float OctreeServer::_maxSchedulingLatency = 0.0f;
+
 
 void OctreeServer::resetSendingStats() {
     _averageLoopTime.reset();
@@ -98,6 +102,7 @@ void OctreeServer::resetSendingStats() {
     _averageTreeShortWaitTime.reset();
     _averageTreeLongWaitTime.reset();
     _averageTreeExtraLongWaitTime.reset();
+    _maxTreeWaitTime = 0.0f;
     _extraLongTreeWait = 0;
     _longTreeWait = 0;
     _shortTreeWait = 0;
@@ -125,6 +130,9 @@ void OctreeServer::resetSendingStats() {
     _longProcessWait = 0;
     _shortProcessWait = 0;
     _noProcessWait = 0;
+
+    _averageSchedulingLatency.reset();
+    _maxSchedulingLatency = 0.0f;
 }
 
 void OctreeServer::trackEncodeTime(float time) {
@@ -164,6 +172,9 @@ void OctreeServer::trackTreeWaitTime(float time) {
         _averageTreeExtraLongWaitTime.updateAverage(time);
     }
     _averageTreeWaitTime.updateAverage(time);
+    if (time > _maxTreeWaitTime) {
+        _maxTreeWaitTime = time;
+    }
 }
 
 void OctreeServer::trackCompressAndWriteTime(float time) {
@@ -213,6 +224,13 @@ void OctreeServer::trackProcessWaitTime(float time) {
     _averageProcessWaitTime.updateAverage(time);
 }
 
+void OctreeServer::trackSchedulingLatency(float time) {
+    _averageSchedulingLatency.updateAverage(time);
+    if (time > _maxSchedulingLatency) {
+        _maxSchedulingLatency = time;
+    }
+}
+
 OctreeServer::OctreeServer(ReceivedMessage& message) :
     ThreadedAssignment(message),
     _argc(0),
@@ -222,6 +240,7 @@ OctreeServer::OctreeServer(ReceivedMessage& message) :
     _statusPort(0),
     _packetsPerClientPerInterval(10),
     _packetsTotalPerInterval(DEFAULT_PACKETS_PER_INTERVAL),
+    _sendWorkerCount(std::max(1, QThread::idealThreadCount())),
     _tree(NULL),
     _wantPersist(true),
     _debugSending(false),
@@ -370,6 +389,13 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             statsString += getFileLoadTime();
             statsString += "\r\n";
 
+            if (getLastSaveTime() > 0) {
+                statsString += QString("%1 File Last Save Took %2 usecs, holding the tree lock for %3 usecs\r\n")
+                    .arg(getMyServerName())
+                    .arg(getLastSaveTime())
+                    .arg(getLastSaveLockTime());
+            }
+
             if (_persistFileDownload) {
                 statsString += QString("Persist file: <a href='%1'>Click to Download</a>\r\n").arg(PERSIST_FILE_DOWNLOAD_PATH);
             } else {
@@ -441,6 +467,17 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString("      writeDatagram() last second: %1 clients\r\n\r\n")
             .arg(locale.toString((uint)howManyThreadsDidCallWriteDatagram(oneSecondAgo)).rightJustified(COLUMN_WIDTH, ' '));
 
+        statsString += QString("                     Send workers: %1 threads\r\n")
+            .arg(locale.toString((uint)getSendWorkerCount()).rightJustified(COLUMN_WIDTH, ' '));
+
+        statsString += QString().sprintf("      Average scheduling latency:    %9.2f usecs"
+                                         "                 samples: %12d \r\n",
+                                         (double)getAverageSchedulingLatency(), _averageSchedulingLatency.getSampleCount());
+        statsString += QString().sprintf("          Max scheduling latency:    %9.2f usecs\r\n",
+                                         (double)getMaxSchedulingLatency());
+        statsString += getViewerSchedulingStats();
+        statsString += "\r\n";
+
         float averageLoopTime = getAverageLoopTime();
         statsString += QString().sprintf("           Average packetLoop() time:      %7.2f msecs"
                                          "                 samples: %12d \r\n",
@@ -492,6 +529,9 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         statsString += QString().sprintf("         Average tree lock wait time:"
                                          "    %9.2f usecs                 samples: %12d \r\n",
                                          (double)averageTreeWaitTime, allWaitTimes);
+        statsString += QString().sprintf("             Max tree lock wait time:"
+                                         "    %9.2f usecs\r\n",
+                                         (double)getMaxTreeWaitTime());
 
         float zeroVsTotal = (allWaitTimes > 0) ? ((float)_noTreeWait / (float)allWaitTimes) : 0.0f;
         statsString += QString().sprintf("                        No Lock Wait:"
@@ -649,10 +689,15 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageTransitTimePerPacket = _octreeInboundPacketProcessor->getAverageTransitTimePerPacket();
         quint64 averageProcessTimePerPacket = _octreeInboundPacketProcessor->getAverageProcessTimePerPacket();
         quint64 averageLockWaitTimePerPacket = _octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
+        quint64 maxLockWaitTimePerPacket = _octreeInboundPacketProcessor->getMaxLockWaitTimePerPacket();
         quint64 averageProcessTimePerElement = _octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        float averageEditsPerLock = _octreeInboundPacketProcessor->getAverageEditsPerLock();
+        quint64 averageLockHoldTime = _octreeInboundPacketProcessor->getAverageLockHoldTime();
+        quint64 maxLockHoldTime = _octreeInboundPacketProcessor->getMaxLockHoldTime();
+        quint64 averageEditQueueTime = _octreeInboundPacketProcessor->getAverageEditQueueTime();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -683,10 +728,20 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)averageProcessTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("   Average Wait Lock Time/Packet: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("       Max Wait Lock Time/Packet: %1 usecs\r\n")
+            .arg(locale.toString((uint)maxLockWaitTimePerPacket).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("    Average Process Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageProcessTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("              Average Edits/Lock: %1 edits\r\n")
+            .arg(locale.toString(averageEditsPerLock, 'f', FLOAT_PRECISION).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("          Average Lock Hold Time: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageLockHoldTime).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("              Max Lock Hold Time: %1 usecs\r\n")
+            .arg(locale.toString((uint)maxLockHoldTime).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("         Average Edit Queue Time: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageEditQueueTime).rightJustified(COLUMN_WIDTH, ' '));
 
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
@@ -868,21 +923,12 @@ void OctreeServer::parsePayload() {
     }
 }
 
-OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePointer& node) {
-    auto sendThread = std::unique_ptr<OctreeSendThread>(new OctreeSendThread(this, node));
-    
-    // we want to be notified when the thread finishes
-    connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+void OctreeServer::startSendWorkers() {
+    qDebug() << qPrintable(_safeServerName) << "server starting" << _sendWorkerCount << "send workers";
 
-    return sendThread;
-}
-
-void OctreeServer::removeSendThread() {
-    // If the object has been deleted since the event was queued, sender() will return nullptr
-    if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+    for (int i = 0; i < _sendWorkerCount; i++) {
+        _sendWorkers.emplace_back(new OctreeSendThread(this, _sendQueue, i));
+        _sendWorkers.back()->initialize(true);
     }
 }
 
@@ -893,13 +939,9 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
         auto nodeList = DependencyManager::get<NodeList>();
         nodeList->updateNodeWithDataFromPacket(message, senderNode);
         
-        auto it = _sendThreads.find(senderNode->getUUID());
-        if (it == _sendThreads.end()) {
-            _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
-        } else if (it->second->isShuttingDown()) {
-            _sendThreads.erase(it); // Remove right away and wait on thread to be
-            
-            _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
+        // make sure our send workers are serving this viewer
+        if (_sendQueue.addViewer(senderNode)) {
+            qDebug() << qPrintable(_safeServerName) << "server: client connected, queued for sending:" << *senderNode;
         }
     }
 }
@@ -1035,6 +1077,12 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
 
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString(QString("persistFileType"), settingsSectionObject, persistFileType)
+            && (persistFileType == "json.gz" || persistFileType == "bin")) {
+            _persistAsFileType = persistFileType;
+        }
+        qDebug() << "persistFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         readOptionInt(QString("persistInterval"), settingsSectionObject, _persistInterval);
@@ -1072,6 +1120,13 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondPerClientMax=%d _packetsPerClientPerInterval=%d",
                     packetsPerSecondPerClientMax, _packetsPerClientPerInterval);
 
+    // a pool of send workers serves all viewers, by default one per core
+    int sendWorkerThreads = 0;
+    if (readOptionInt(QString("sendWorkerThreads"), settingsSectionObject, sendWorkerThreads) && sendWorkerThreads > 0) {
+        _sendWorkerCount = sendWorkerThreads;
+    }
+    qDebug("sendWorkerThreads=%d", _sendWorkerCount);
+
     // Check to see if the user passed in a command line option for setting packet send rate
     int packetsPerSecondTotalMax = -1;
     if (readOptionInt(QString("packetsPerSecondTotalMax"), settingsSectionObject, packetsPerSecondTotalMax)) {
@@ -1218,6 +1273,8 @@ void OctreeServer::domainSettingsRequestComplete() {
     // set up our OctreeServerPacketProcessor
     _octreeInboundPacketProcessor = new OctreeInboundPacketProcessor(this);
     _octreeInboundPacketProcessor->initialize(true);
+
+    startSendWorkers();
     
     // Convert now to tm struct for local timezone
     tm* localtm = localtime(&_started);
@@ -1242,12 +1299,9 @@ void OctreeServer::nodeAdded(SharedNodePointer node) {
 void OctreeServer::nodeKilled(SharedNodePointer node) {
     quint64 start  = usecTimestampNow();
     
-    // Shutdown send thread
-    auto it = _sendThreads.find(node->getUUID());
-    if (it != _sendThreads.end()) {
-        auto& sendThread = *it->second;
-        sendThread.setIsShuttingDown();
-    }
+    // stop sending to this viewer, if a worker is sending to it right now it's dropped once that send is done
+    _sendQueue.removeViewer(node->getUUID());
+    stopTrackingViewer(node->getUUID());
 
     // calling this here since nodeKilled slot in ReceivedPacketProcessor can't be triggered by signals yet!!
     _octreeInboundPacketProcessor->nodeKilled(node);
@@ -1288,15 +1342,15 @@ void OctreeServer::aboutToFinish() {
         _jurisdictionSender->terminating();
     }
     
-    // Shut down all the send threads
-    for (auto& it : _sendThreads) {
-        auto& sendThread = *it.second;
-        sendThread.setIsShuttingDown();
+    // Shut down all the send workers, stopping the queue wakes any that are waiting on a viewer
+    _sendQueue.stop();
+    for (auto& sendWorker : _sendWorkers) {
+        sendWorker->setIsShuttingDown();
     }
     
     // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
     // which waits on the thread to be done before returning
-    _sendThreads.clear(); // Cleans up all the send threads.
+    _sendWorkers.clear(); // Cleans up all the send workers.
 
     if (_persistThread) {
         _persistThread->aboutToFinish();
@@ -1394,6 +1448,20 @@ QString OctreeServer::getConfiguration() {
     return result;
 }
 
+QString OctreeServer::getViewerSchedulingStats() {
+    QString result;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        OctreeQueryNode* nodeData = dynamic_cast<OctreeQueryNode*>(node->getLinkedData());
+        if (nodeData && !nodeData->isShuttingDown()) {
+            result += QString().sprintf("    %s: average %9.2f usecs, last %9llu usecs\r\n",
+                                        qPrintable(uuidStringWithoutCurlyBraces(node->getUUID())),
+                                        (double)nodeData->getAverageSchedulingLatency(),
+                                        (unsigned long long)nodeData->getLastSchedulingLatency());
+        }
+    });
+    return result;
+}
+
 QString OctreeServer::getStatusLink() {
     QString result;
     if (_statusPort > 0) {
@@ -1413,6 +1481,15 @@ void OctreeServer::sendStatsPacket() {
     threadsStats["2. packetDistributor"] = (double)howManyThreadsDidPacketDistributor(oneSecondAgo);
     threadsStats["3. handlePacektSend"] = (double)howManyThreadsDidHandlePacketSend(oneSecondAgo);
     threadsStats["4. writeDatagram"] = (double)howManyThreadsDidCallWriteDatagram(oneSecondAgo);
+    threadsStats["5. sendWorkers"] = (double)getSendWorkerCount();
+
+    QJsonObject viewerLatencies;
+    DependencyManager::get<NodeList>()->eachNode([&](const SharedNodePointer& node) {
+        OctreeQueryNode* nodeData = dynamic_cast<OctreeQueryNode*>(node->getLinkedData());
+        if (nodeData && !nodeData->isShuttingDown()) {
+            viewerLatencies[uuidStringWithoutCurlyBraces(node->getUUID())] = nodeData->getAverageSchedulingLatency();
+        }
+    });
     
     QJsonObject statsArray1;
     statsArray1["1. configuration"] = getConfiguration();
@@ -1421,6 +1498,8 @@ void OctreeServer::sendStatsPacket() {
     statsArray1["4. persistFileLoadTime"] = getFileLoadTime();
     statsArray1["5. clients"] = getCurrentClientCount();
     statsArray1["6. threads"] = threadsStats;
+    statsArray1["7. persistFileSaveTime"] = (double)getLastSaveTime();
+    statsArray1["8. persistFileSaveLockTime"] = (double)getLastSaveLockTime();
     
     // Octree Stats
     QJsonObject octreeStats;
@@ -1445,6 +1524,10 @@ void OctreeServer::sendStatsPacket() {
     timingArray1["5. avgCompressAndWriteTime"] = getAverageCompressAndWriteTime();
     timingArray1["6. avgSendTime"] = getAveragePacketSendingTime();
     timingArray1["7. nodeWaitTime"] = getAverageNodeWaitTime();
+    timingArray1["8. maxTreeLockTime"] = getMaxTreeWaitTime();
+    timingArray1["9. avgSchedulingLatency"] = getAverageSchedulingLatency();
+    timingArray1["10. maxSchedulingLatency"] = getMaxSchedulingLatency();
+    timingArray1["11. viewerSchedulingLatency"] = viewerLatencies;
     
     QJsonObject statsObject2;
     statsObject2["data"] = dataObject1;
@@ -1464,6 +1547,11 @@ void OctreeServer::sendStatsPacket() {
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. maxLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getMaxLockWaitTimePerPacket();
+        timingArray2["7. avgEditsPerLock"] = (double)_octreeInboundPacketProcessor->getAverageEditsPerLock();
+        timingArray2["8. avgLockHoldTime"] = (double)_octreeInboundPacketProcessor->getAverageLockHoldTime();
+        timingArray2["9. maxLockHoldTime"] = (double)_octreeInboundPacketProcessor->getMaxLockHoldTime();
+        timingArray2["10. avgEditQueueTime"] = (double)_octreeInboundPacketProcessor->getAverageEditQueueTime();
     }
     
     QJsonObject statsObject3;
@@ -1482,10 +1570,10 @@ void OctreeServer::sendStatsPacket() {
     addPacketStatsAndSendStatsPacket(statsObject);
 }
 
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidProcess;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidPacketDistributor;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidHandlePacketSend;
-QMap<OctreeSendThread*, quint64> OctreeServer::_threadsDidCallWriteDatagram;
+QMap<QUuid, quint64> OctreeServer::_threadsDidProcess;
+QMap<QUuid, quint64> OctreeServer::_threadsDidPacketDistributor;
+QMap<QUuid, quint64> OctreeServer::_threadsDidHandlePacketSend;
+QMap<QUuid, quint64> OctreeServer::_threadsDidCallWriteDatagram;
 
 QMutex OctreeServer::_threadsDidProcessMutex;
 QMutex OctreeServer::_threadsDidPacketDistributorMutex;
@@ -1493,53 +1581,53 @@ QMutex OctreeServer::_threadsDidHandlePacketSendMutex;
 QMutex OctreeServer::_threadsDidCallWriteDatagramMutex;
 
 
-void OctreeServer::didProcess(OctreeSendThread* thread) {
+void OctreeServer::didProcess(const QUuid& viewerID) {
     QMutexLocker locker(&_threadsDidProcessMutex);
-    _threadsDidProcess[thread] = usecTimestampNow();
+    _threadsDidProcess[viewerID] = usecTimestampNow();
 }
 
-void OctreeServer::didPacketDistributor(OctreeSendThread* thread) {
+void OctreeServer::didPacketDistributor(const QUuid& viewerID) {
     QMutexLocker locker(&_threadsDidPacketDistributorMutex);
-    _threadsDidPacketDistributor[thread] = usecTimestampNow();
+    _threadsDidPacketDistributor[viewerID] = usecTimestampNow();
 }
 
-void OctreeServer::didHandlePacketSend(OctreeSendThread* thread) {
+void OctreeServer::didHandlePacketSend(const QUuid& viewerID) {
     QMutexLocker locker(&_threadsDidHandlePacketSendMutex);
-    _threadsDidHandlePacketSend[thread] = usecTimestampNow();
+    _threadsDidHandlePacketSend[viewerID] = usecTimestampNow();
 }
 
-void OctreeServer::didCallWriteDatagram(OctreeSendThread* thread) {
+void OctreeServer::didCallWriteDatagram(const QUuid& viewerID) {
     QMutexLocker locker(&_threadsDidCallWriteDatagramMutex);
-    _threadsDidCallWriteDatagram[thread] = usecTimestampNow();
+    _threadsDidCallWriteDatagram[viewerID] = usecTimestampNow();
 }
 
 
-void OctreeServer::stopTrackingThread(OctreeSendThread* thread) {
+void OctreeServer::stopTrackingViewer(const QUuid& viewerID) {
     {
         QMutexLocker locker(&_threadsDidProcessMutex);
-        _threadsDidProcess.remove(thread);
+        _threadsDidProcess.remove(viewerID);
     }
     {
         QMutexLocker locker(&_threadsDidPacketDistributorMutex);
-        _threadsDidPacketDistributor.remove(thread);
+        _threadsDidPacketDistributor.remove(viewerID);
     }
     {
         QMutexLocker locker(&_threadsDidHandlePacketSendMutex);
-        _threadsDidHandlePacketSend.remove(thread);
+        _threadsDidHandlePacketSend.remove(viewerID);
     }
     {
         QMutexLocker locker(&_threadsDidCallWriteDatagramMutex);
-        _threadsDidCallWriteDatagram.remove(thread);
+        _threadsDidCallWriteDatagram.remove(viewerID);
     }
 }
 
-int howManyThreadsDidSomething(QMutex& mutex, QMap<OctreeSendThread*, quint64>& something, quint64 since) {
+int howManyThreadsDidSomething(QMutex& mutex, QMap<QUuid, quint64>& something, quint64 since) {
     int count = 0;
     if (mutex.tryLock()) {
         if (since == 0) {
             count = something.size();
         } else {
-            QMap<OctreeSendThread*, quint64>::const_iterator i = something.constBegin();
+            QMap<QUuid, quint64>::const_iterator i = something.constBegin();
             while (i != something.constEnd()) {
                 if (i.value() > since) {
                     count++;
@@ -13,6 +13,7 @@
 #define hifi_OctreeServer_h
 
 #include <memory>
+#include <vector>
 
 #include <QStringList>
 #include <QDateTime>
@@ -23,6 +24,7 @@
 #include <ThreadedAssignment.h>
 
 #include "OctreePersistThread.h"
+#include "OctreeSendQueue.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
@@ -53,13 +55,14 @@ public:
     int getPacketsTotalPerInterval() const { return _packetsTotalPerInterval; }
     int getPacketsTotalPerSecond() const { return getPacketsTotalPerInterval() * INTERVALS_PER_SECOND; }
 
-    static int getCurrentClientCount() { return _clientCount; }
-    static void clientConnected() { _clientCount++; }
-    static void clientDisconnected() { _clientCount--; }
+    int getCurrentClientCount() const { return _sendQueue.getViewerCount(); }
+    int getSendWorkerCount() const { return (int)_sendWorkers.size(); }
 
     bool isInitialLoadComplete() const { return (_persistThread) ? _persistThread->isInitialLoadComplete() : true; }
     bool isPersistEnabled() const { return (_persistThread) ? true : false; }
     quint64 getLoadElapsedTime() const { return (_persistThread) ? _persistThread->getLoadElapsedTime() : 0; }
+    quint64 getLastSaveTime() const { return (_persistThread) ? _persistThread->getLastSaveTime() : 0; }
+    quint64 getLastSaveLockTime() const { return (_persistThread) ? _persistThread->getLastSaveLockTime() : 0; }
     QString getPersistFilename() const { return (_persistThread) ? _persistThread->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistThread) ? _persistThread->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistThread) ? _persistThread->getPersistFileContents() : QByteArray(); }
@@ -79,7 +82,7 @@ public:
     virtual bool hasSpecialPacketsToSend(const SharedNodePointer& node) { return false; }
     virtual int sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) { return 0; }
     virtual QString serverSubclassStats() { return QString(); }
-    virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& viewerNode) { }
+    virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, OctreeQueryNode* viewerData) { }
     virtual void trackViewerGone(const QUuid& viewerNode) { }
 
     static float SKIP_TIME; // use this for trackXXXTime() calls for non-times
@@ -95,6 +98,7 @@ public:
 
     static void trackTreeWaitTime(float time);
     static float getAverageTreeWaitTime() { return _averageTreeWaitTime.getAverage(); }
+    static float getMaxTreeWaitTime() { return _maxTreeWaitTime; }
 
     static void trackNodeWaitTime(float time) { _averageNodeWaitTime.updateAverage(time); }
     static float getAverageNodeWaitTime() { return _averageNodeWaitTime.getAverage(); }
@@ -108,12 +112,16 @@ public:
     static void trackProcessWaitTime(float time);
     static float getAverageProcessWaitTime() { return _averageProcessWaitTime.getAverage(); }
 
-    // these methods allow us to track which threads got to various states
-    static void didProcess(OctreeSendThread* thread);
-    static void didPacketDistributor(OctreeSendThread* thread);
-    static void didHandlePacketSend(OctreeSendThread* thread);
-    static void didCallWriteDatagram(OctreeSendThread* thread);
-    static void stopTrackingThread(OctreeSendThread* thread);
+    static void trackSchedulingLatency(float time);
+    static float getAverageSchedulingLatency() { return _averageSchedulingLatency.getAverage(); }
+    static float getMaxSchedulingLatency() { return _maxSchedulingLatency; }
+
+    // these methods allow us to track which viewers got to various states
+    static void didProcess(const QUuid& viewerID);
+    static void didPacketDistributor(const QUuid& viewerID);
+    static void didHandlePacketSend(const QUuid& viewerID);
+    static void didCallWriteDatagram(const QUuid& viewerID);
+    static void stopTrackingViewer(const QUuid& viewerID);
 
     static int howManyThreadsDidProcess(quint64 since = 0);
     static int howManyThreadsDidPacketDistributor(quint64 since = 0);
@@ -136,12 +144,10 @@ private slots:
     void handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleOctreeDataNackPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleJurisdictionRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
-    void removeSendThread();
 
 protected:
     using UniqueSendThread = std::unique_ptr<OctreeSendThread>;
-    using SendThreads = std::unordered_map<QUuid, UniqueSendThread>;
-    
+
     virtual OctreePointer createTree() = 0;
     bool readOptionBool(const QString& optionName, const QJsonObject& settingsSectionObject, bool& result);
     bool readOptionInt(const QString& optionName, const QJsonObject& settingsSectionObject, int& result);
@@ -155,8 +161,9 @@ protected:
     QString getFileLoadTime();
     QString getConfiguration();
     QString getStatusLink();
-    
-    UniqueSendThread createSendThread(const SharedNodePointer& node);
+    QString getViewerSchedulingStats();
+
+    void startSendWorkers();
 
     int _argc;
     const char** _argv;
@@ -173,6 +180,7 @@ protected:
     QString _persistAsFileType;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    int _sendWorkerCount;
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
@@ -195,9 +203,9 @@ protected:
     quint64 _startedUSecs;
     QString _safeServerName;
     
-    SendThreads _sendThreads;
+    OctreeSendQueue _sendQueue;
+    std::vector<UniqueSendThread> _sendWorkers;
 
-    static int _clientCount;
     static SimpleMovingAverage _averageLoopTime;
 
     static SimpleMovingAverage _averageEncodeTime;
@@ -215,6 +223,7 @@ protected:
     static SimpleMovingAverage _averageTreeShortWaitTime;
     static SimpleMovingAverage _averageTreeLongWaitTime;
     static SimpleMovingAverage _averageTreeExtraLongWaitTime;
+    static float _maxTreeWaitTime;
     static int _extraLongTreeWait;
     static int _longTreeWait;
     static int _shortTreeWait;
@@ -243,10 +252,13 @@ protected:
     static int _shortProcessWait;
     static int _noProcessWait;
 
-    static QMap<OctreeSendThread*, quint64> _threadsDidProcess;
-    static QMap<OctreeSendThread*, quint64> _threadsDidPacketDistributor;
-    static QMap<OctreeSendThread*, quint64> _threadsDidHandlePacketSend;
-    static QMap<OctreeSendThread*, quint64> _threadsDidCallWriteDatagram;
+    static SimpleMovingAverage _averageSchedulingLatency;
+    static float _maxSchedulingLatency;
+
+    static QMap<QUuid, quint64> _threadsDidProcess;
+    static QMap<QUuid, quint64> _threadsDidPacketDistributor;
+    static QMap<QUuid, quint64> _threadsDidHandlePacketSend;
+    static QMap<QUuid, quint64> _threadsDidCallWriteDatagram;
 
     static QMutex _threadsDidProcessMutex;
     static QMutex _threadsDidPacketDistributorMutex;
@@ -656,15 +656,26 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     QDataStream packetStream(message->getMessage());
     NodeConnectionData nodeRequestData = NodeConnectionData::fromDataStream(packetStream, message->getSenderSockAddr(), false);
 
-    // update this node's sockets in case they have changed
-    sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
-    sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+    // update this node's sockets in case they have changed, the other nodes will need to hear about it
+    if (sendingNode->getPublicSocket() != nodeRequestData.publicSockAddr
+        || sendingNode->getLocalSocket() != nodeRequestData.localSockAddr) {
+        sendingNode->setPublicSocket(nodeRequestData.publicSockAddr);
+        sendingNode->setLocalSocket(nodeRequestData.localSockAddr);
+        recordDomainListChange(sendingNode);
+    }
     
     // update the NodeInterestSet in case there have been any changes
     DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(sendingNode->getLinkedData());
-    nodeData->setNodeInterestSet(nodeRequestData.interestList.toSet());
+    NodeSet nodeInterestSet = nodeRequestData.interestList.toSet();
+    quint32 lastDomainListVersion = nodeRequestData.lastDomainListVersion;
+    if (nodeInterestSet != nodeData->getNodeInterestSet()) {
+        nodeData->setNodeInterestSet(nodeInterestSet);
+
+        // what changed since the last list doesn't cover the nodes it is now interested in
+        lastDomainListVersion = 0;
+    }
 
-    sendDomainListToNode(sendingNode, message->getSenderSockAddr());
+    sendDomainListToNode(sendingNode, message->getSenderSockAddr(), lastDomainListVersion);
 }
 
 unsigned int DomainServer::countConnectedUsers() {
@@ -720,6 +731,9 @@ QUrl DomainServer::oauthAuthorizationURL(const QUuid& stateUUID) {
 void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     
     DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(newNode->getLinkedData());
+
+    // the nodes that are already connected will find this one in the changes to their domain lists
+    recordDomainListChange(newNode);
     
     // reply back to the user with a PacketType::DomainList
     sendDomainListToNode(newNode, nodeData->getSendingSockAddr());
@@ -728,8 +742,27 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode) {
     broadcastNewNode(newNode);
 }
 
-void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr) {
-    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2;
+// nodes that aren't sent a full list for this long are sent one anyway, in case they missed part of a delta
+const quint64 FULL_DOMAIN_LIST_INTERVAL_USECS = 30 * USECS_PER_SECOND;
+
+// the changes kept for building deltas, nodes that are further behind than this are sent a full list
+const size_t MAX_DOMAIN_LIST_CHANGES = 1000;
+
+void DomainServer::recordDomainListChange(const SharedNodePointer& node) {
+    _domainListChanges.push_back({ ++_domainListVersion, node->getUUID(), node->getType() });
+
+    if (_domainListChanges.size() > MAX_DOMAIN_LIST_CHANGES) {
+        _oldestDomainListDeltaVersion = _domainListChanges.front().version;
+        _domainListChanges.pop_front();
+    }
+}
+
+void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr &senderSockAddr,
+                                        quint32 lastDomainListVersion) {
+    quint64 start = usecTimestampNow();
+
+    const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NUM_BYTES_RFC4122_UUID + 2
+        + sizeof(quint32);
     
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -742,6 +775,7 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     extendedHeaderStream << node->getUUID();
     extendedHeaderStream << (quint8) node->isAllowedEditor();
     extendedHeaderStream << (quint8) node->getCanRez();
+    extendedHeaderStream << _domainListVersion;
 
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
@@ -753,35 +787,114 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, const Hif
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
-    if (nodeInterestSet.size() > 0) {
+    // send only what changed since the version the node last saw, unless we no longer have all of those changes
+    bool sendDelta = lastDomainListVersion != 0
+        && lastDomainListVersion >= _oldestDomainListDeltaVersion
+        && lastDomainListVersion <= _domainListVersion
+        && start - nodeData->getLastFullDomainListSentAt() < FULL_DOMAIN_LIST_INTERVAL_USECS;
 
-        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
-        if (nodeData->isAuthenticated()) {
-            // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([&](const SharedNodePointer& otherNode){
-                if (otherNode->getUUID() != node->getUUID() && nodeInterestSet.contains(otherNode->getType())) {
-                    
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+    auto appendNode = [&](const SharedNodePointer& otherNode) {
+        // since we're about to add a node to the packet we start a segment
+        domainListPackets->startSegment();
 
-                    // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+        domainListStream << DomainListEntry::Node;
 
-                    // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+        // don't send avatar nodes to other avatars, that will come from avatar mixer
+        domainListStream << *otherNode.data();
 
-                    // we've added the node we wanted so end the segment now
-                    domainListPackets->endSegment();
+        // pack the secret that these two nodes will use to communicate with each other
+        domainListStream << connectionSecretForNodes(node, otherNode);
+
+        // we've added the node we wanted so end the segment now
+        domainListPackets->endSegment();
+    };
+
+    if (nodeInterestSet.size() > 0) {
+
+        // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
+        if (nodeData->isAuthenticated()) {
+            if (sendDelta) {
+                // the changes are in version order, so the ones this node hasn't seen are at the back
+                QSet<QUuid> changedNodes;
+                for (auto change = _domainListChanges.rbegin();
+                     change != _domainListChanges.rend() && change->version > lastDomainListVersion; ++change) {
+
+                    if (change->nodeUUID == node->getUUID() || !nodeInterestSet.contains(change->nodeType)
+                        || changedNodes.contains(change->nodeUUID)) {
+                        continue;
+                    }
+                    changedNodes.insert(change->nodeUUID);
+
+                    // send the node as it is now, or that it is gone
+                    SharedNodePointer otherNode = limitedNodeList->nodeWithUUID(change->nodeUUID);
+                    if (otherNode) {
+                        appendNode(otherNode);
+                    } else {
+                        domainListPackets->startSegment();
+                        domainListStream << DomainListEntry::RemovedNode << change->nodeUUID;
+                        domainListPackets->endSegment();
+                    }
                 }
-            });
+            } else {
+                // if this authenticated node has any interest types, send back those nodes as well
+                limitedNodeList->eachNode([&](const SharedNodePointer& otherNode){
+                    if (otherNode->getUUID() != node->getUUID() && nodeInterestSet.contains(otherNode->getType())) {
+                        appendNode(otherNode);
+                    }
+                });
+            }
         }
     }
+
+    if (!sendDelta) {
+        nodeData->setLastFullDomainListSentAt(start);
+    }
     
     // send an empty list to the node, in case there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
+    size_t numPackets = domainListPackets->getNumPackets();
+    size_t numBytes = domainListPackets->getDataSize();
+
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+
+    quint64 end = usecTimestampNow();
+    updateDomainListStats(end);
+    if (sendDelta) {
+        ++_domainListStats.deltaLists;
+    } else {
+        ++_domainListStats.fullLists;
+    }
+    _domainListStats.packets += numPackets;
+    _domainListStats.bytes += numBytes;
+    _domainListStats.usecs += end - start;
+}
+
+void DomainServer::updateDomainListStats(quint64 now) {
+    const quint64 DOMAIN_LIST_STATS_INTERVAL_USECS = USECS_PER_SECOND;
+
+    if (_domainListStatsIntervalStart == 0) {
+        _domainListStatsIntervalStart = now;
+    }
+
+    quint64 interval = now - _domainListStatsIntervalStart;
+    if (interval >= DOMAIN_LIST_STATS_INTERVAL_USECS) {
+        double seconds = (double)interval / USECS_PER_SECOND;
+
+        QJsonObject statsJSON;
+        statsJSON["full_lists_per_second"] = _domainListStats.fullLists / seconds;
+        statsJSON["delta_lists_per_second"] = _domainListStats.deltaLists / seconds;
+        statsJSON["packets_per_second"] = _domainListStats.packets / seconds;
+        statsJSON["bytes_per_second"] = _domainListStats.bytes / seconds;
+        statsJSON["usecs_per_second"] = _domainListStats.usecs / seconds;
+        statsJSON["version"] = (double)_domainListVersion;
+        statsJSON["changes_kept"] = (double)_domainListChanges.size();
+        _domainListStatsJSON = statsJSON;
+
+        _domainListStats = DomainListStats();
+        _domainListStatsIntervalStart = now;
+    }
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -1370,6 +1483,17 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             QJsonDocument transactionsDocument(rootObject);
             connection->respond(HTTPConnection::StatusCode200, transactionsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == "/domain-list-stats.json") {
+            // the rates at which domain lists have recently been sent to the nodes
+            updateDomainListStats(usecTimestampNow());
+
+            QJsonObject rootObject;
+            rootObject["domain_lists"] = _domainListStatsJSON;
+
+            QJsonDocument statsDocument(rootObject);
+            connection->respond(HTTPConnection::StatusCode200, statsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
             // setup the JSON
@@ -1786,6 +1910,9 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     DomainServerNodeData* nodeData = reinterpret_cast<DomainServerNodeData*>(node->getLinkedData());
 
     if (nodeData) {
+        // let the other nodes know this one is gone the next time they're sent a domain list
+        recordDomainListChange(node);
+
         // if this node's UUID matches a static assignment we need to throw it back in the assignment queue
         if (!nodeData->getAssignmentUUID().isNull()) {
             SharedAssignmentPointer matchedAssignment = _allAssignments.take(nodeData->getAssignmentUUID());
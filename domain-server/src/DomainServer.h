@@ -12,6 +12,8 @@
 #ifndef hifi_DomainServer_h
 #define hifi_DomainServer_h
 
+#include <deque>
+
 #include <QtCore/QCoreApplication>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
@@ -97,7 +99,10 @@ private:
 
     unsigned int countConnectedUsers();
 
-    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr);
+    void sendDomainListToNode(const SharedNodePointer& node, const HifiSockAddr& senderSockAddr,
+                              quint32 lastDomainListVersion = 0);
+    void recordDomainListChange(const SharedNodePointer& node);
+    void updateDomainListStats(quint64 now);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
     void broadcastNewNode(const SharedNodePointer& node);
@@ -157,6 +162,28 @@ private:
     std::unique_ptr<NLPacket> _iceServerHeartbeatPacket;
 
     QTimer* _iceHeartbeatTimer { nullptr }; // this looks like it dangles when created but it's parented to the DomainServer
+
+    // every change to a node that other nodes are sent in their domain lists (added, moved, or gone) bumps the version,
+    // so nodes that report the version they last saw can be sent only what changed since
+    struct DomainListChange {
+        quint32 version;
+        QUuid nodeUUID;
+        NodeType_t nodeType;
+    };
+    quint32 _domainListVersion { 0 };
+    quint32 _oldestDomainListDeltaVersion { 0 }; // deltas can't be built from before this, those changes are gone
+    std::deque<DomainListChange> _domainListChanges;
+
+    struct DomainListStats {
+        quint64 fullLists { 0 };
+        quint64 deltaLists { 0 };
+        quint64 packets { 0 };
+        quint64 bytes { 0 };
+        quint64 usecs { 0 };
+    };
+    DomainListStats _domainListStats; // for the current interval
+    QJsonObject _domainListStatsJSON; // per second, over the last complete interval
+    quint64 _domainListStatsIntervalStart { 0 };
     
     friend class DomainGatekeeper;
 };
@@ -50,6 +50,9 @@ public:
 
     const NodeSet& getNodeInterestSet() const { return _nodeInterestSet; }
     void setNodeInterestSet(const NodeSet& nodeInterestSet) { _nodeInterestSet = nodeInterestSet; }
+
+    quint64 getLastFullDomainListSentAt() const { return _lastFullDomainListSentAt; }
+    void setLastFullDomainListSentAt(quint64 sentAt) { _lastFullDomainListSentAt = sentAt; }
     
     void setNodeVersion(const QString& nodeVersion) { _nodeVersion = nodeVersion; }
     const QString& getNodeVersion() { return _nodeVersion; }
@@ -75,6 +78,7 @@ private:
     bool _isAuthenticated = true;
     NodeSet _nodeInterestSet;
     QString _nodeVersion;
+    quint64 _lastFullDomainListSentAt { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -27,6 +27,7 @@ public:
     HifiSockAddr localSockAddr;
     HifiSockAddr senderSockAddr;
     QList<NodeType_t> interestList;
+    quint32 lastDomainListVersion { 0 }; // the last version of the domain list this node saw, for list requests
 };
 
 
@@ -12,6 +12,8 @@
 #include "SoftAttachmentModel.h"
 #include "InterfaceLogging.h"
 
+#include <ModelKernels.h>
+
 SoftAttachmentModel::SoftAttachmentModel(RigPointer rig, QObject* parent, RigPointer rigOverride) :
     Model(rig, parent),
     _rigOverride(rigOverride) {
@@ -50,19 +52,23 @@ void SoftAttachmentModel::updateClusterMatrices(glm::vec3 modelPosition, glm::qu
         MeshState& state = _meshStates[i];
         const FBXMesh& mesh = geometry.meshes.at(i);
 
-        for (int j = 0; j < mesh.clusters.size(); j++) {
+        int numClusters = mesh.clusters.size();
+
+        // gather the clusters' joints, from the override rig where it has them, then compute all of the mesh's
+        // cluster matrices in one batch
+        for (int j = 0; j < numClusters; j++) {
             const FBXCluster& cluster = mesh.clusters.at(j);
 
             // TODO: cache these look ups as an optimization
             int jointIndexOverride = getJointIndexOverride(cluster.jointIndex);
-            glm::mat4 jointMatrix(glm::mat4::_null);
             if (jointIndexOverride >= 0 && jointIndexOverride < _rigOverride->getJointStateCount()) {
-                jointMatrix = _rigOverride->getJointTransform(jointIndexOverride);
+                state.jointMatrices[j] = _rigOverride->getJointTransform(jointIndexOverride);
             } else {
-                jointMatrix = _rig->getJointTransform(cluster.jointIndex);
+                state.jointMatrices[j] = _rig->getJointTransform(cluster.jointIndex);
             }
-            state.clusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
         }
+        composeClusterMatrices(modelToWorld, state.jointMatrices.constData(), state.inverseBindMatrices.constData(),
+                               state.clusterMatrices.data(), numClusters);
 
         // Once computed the cluster matrices, update the buffer(s)
         if (mesh.clusters.size() > 1) {
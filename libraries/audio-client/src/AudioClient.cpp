@@ -134,6 +134,9 @@ AudioClient::AudioClient() :
     packetReceiver.registerListener(PacketType::MixedAudio, this, "handleAudioDataPacket");
     packetReceiver.registerListener(PacketType::NoisyMute, this, "handleNoisyMutePacket");
     packetReceiver.registerListener(PacketType::MuteEnvironment, this, "handleMuteEnvironmentPacket");
+    packetReceiver.registerListener(PacketType::SelectedAudioFormat, this, "handleSelectedAudioFormat");
+
+    connect(DependencyManager::get<NodeList>().data(), &LimitedNodeList::nodeActivated, this, &AudioClient::nodeActivated);
 }
 
 AudioClient::~AudioClient() {
@@ -151,9 +154,78 @@ void AudioClient::audioMixerKilled() {
     _hasReceivedFirstPacket = false;
     _outgoingAvatarAudioSequenceNumber = 0;
     _stats.reset();
+
+    // the next mixer we connect to negotiates its own codec, until then we send and receive uncompressed audio
+    {
+        QMutexLocker lock(&_encoderMutex);
+        _codec.reset();
+        _encoder.reset();
+    }
+    _receivedAudioStream.cleanupCodec();
+
     emit disconnected();
 }
 
+void AudioClient::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AudioMixer) {
+        negotiateAudioFormat();
+    }
+}
+
+void AudioClient::negotiateAudioFormat() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    SharedNodePointer audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer) {
+        return;
+    }
+
+    QStringList codecNames = AudioCodecs::getCodecNames();
+
+    // sent reliably, a lost negotiation would leave the node on uncompressed audio until it reconnects
+    auto negotiateFormatPacket = NLPacket::create(PacketType::NegotiateAudioFormat, -1, true);
+    quint8 numberOfCodecs = (quint8)codecNames.size();
+    negotiateFormatPacket->writePrimitive(numberOfCodecs);
+    for (auto& codecName : codecNames) {
+        negotiateFormatPacket->writeString(codecName);
+    }
+
+    nodeList->sendPacket(std::move(negotiateFormatPacket), *audioMixer);
+}
+
+void AudioClient::handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message) {
+    QString selectedCodecName = message->readString();
+    AudioCodecPointer selectedCodec = AudioCodecs::getCodec(selectedCodecName);
+
+    qCDebug(audioclient) << "Mixer selected codec" << (selectedCodec ? selectedCodecName : QString("none"));
+
+    {
+        QMutexLocker lock(&_encoderMutex);
+        _codec = selectedCodec;
+        _encoder.reset();
+    }
+
+    // mixes are always stereo
+    _receivedAudioStream.setupCodec(selectedCodec, AudioConstants::STEREO);
+}
+
+QByteArray AudioClient::encodeNetworkAudio(const QByteArray& decodedBuffer, bool isStereo) {
+    QMutexLocker lock(&_encoderMutex);
+
+    if (!_codec) {
+        return decodedBuffer;
+    }
+
+    // the mixer follows the channel flag of each packet, so a change of input channels needs a new encoder
+    if (!_encoder || _isEncoderStereo != isStereo) {
+        _encoder = _codec->createEncoder(AudioConstants::SAMPLE_RATE, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
+        _isEncoderStereo = isStereo;
+    }
+
+    QByteArray encodedBuffer;
+    _encoder->encode(decodedBuffer, encodedBuffer);
+    return encodedBuffer;
+}
+
 
 QAudioDeviceInfo getNamedAudioDeviceForMode(QAudio::Mode mode, const QString& deviceName) {
     QAudioDeviceInfo result;
@@ -771,8 +843,16 @@ void AudioClient::handleAudioInput() {
         Transform audioTransform;
         audioTransform.setTranslation(_positionGetter());
         audioTransform.setRotation(_orientationGetter());
+
+        QByteArray audioBuffer;
+        if (packetType != PacketType::SilentAudioFrame) {
+            audioBuffer = encodeNetworkAudio(QByteArray::fromRawData(reinterpret_cast<char*>(networkAudioSamples),
+                                                                     numNetworkBytes), _isStereoInput);
+        }
+
         // FIXME find a way to properly handle both playback audio and user audio concurrently
-        emitAudioPacket(networkAudioSamples, numNetworkBytes, _outgoingAvatarAudioSequenceNumber, audioTransform, packetType);
+        emitAudioPacket(audioBuffer.data(), audioBuffer.size(), _isStereoInput, _outgoingAvatarAudioSequenceNumber,
+                        audioTransform, packetType);
         _stats.sentPacket();
     }
 }
@@ -781,8 +861,13 @@ void AudioClient::handleRecordedAudioInput(const QByteArray& audio) {
     Transform audioTransform;
     audioTransform.setTranslation(_positionGetter());
     audioTransform.setRotation(_orientationGetter());
+
+    bool isStereo = audio.size() == AudioConstants::NETWORK_FRAME_BYTES_STEREO;
+    QByteArray audioBuffer = encodeNetworkAudio(audio, isStereo);
+
     // FIXME check a flag to see if we should echo audio?
-    emitAudioPacket(audio.data(), audio.size(), _outgoingAvatarAudioSequenceNumber, audioTransform, PacketType::MicrophoneAudioWithEcho);
+    emitAudioPacket(audioBuffer.data(), audioBuffer.size(), isStereo, _outgoingAvatarAudioSequenceNumber, audioTransform,
+                    PacketType::MicrophoneAudioWithEcho);
 }
 
 void AudioClient::processReceivedSamples(const QByteArray& inputBuffer, QByteArray& outputBuffer) {
@@ -18,6 +18,7 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
 #include <QtCore/QObject>
 #include <QtCore/QVector>
 #include <QtMultimedia/QAudio>
@@ -25,6 +26,7 @@
 #include <QtMultimedia/QAudioInput>
 
 #include <AbstractAudioInterface.h>
+#include <AudioCodec.h>
 #include <AudioEffectOptions.h>
 #include <AudioStreamStats.h>
 
@@ -134,12 +136,14 @@ public slots:
     void handleAudioDataPacket(QSharedPointer<ReceivedMessage> message);
     void handleNoisyMutePacket(QSharedPointer<ReceivedMessage> message);
     void handleMuteEnvironmentPacket(QSharedPointer<ReceivedMessage> message);
+    void handleSelectedAudioFormat(QSharedPointer<ReceivedMessage> message);
 
     void sendDownstreamAudioStatsPacket() { _stats.sendDownstreamAudioStatsPacket(); }
     void handleAudioInput();
     void handleRecordedAudioInput(const QByteArray& audio);
     void reset();
     void audioMixerKilled();
+    void negotiateAudioFormat();
     void toggleMute();
 
     virtual void setIsStereoInput(bool stereo);
@@ -198,9 +202,15 @@ protected:
         deleteLater();
     }
 
+private slots:
+    void nodeActivated(SharedNodePointer node);
+
 private:
     void outputFormatChanged();
 
+    // encodes a frame of network audio with the codec negotiated with the mixer, returns it as is if there is none
+    QByteArray encodeNetworkAudio(const QByteArray& decodedBuffer, bool isStereo);
+
     QByteArray firstInputFrame;
     QAudioInput* _audioInput;
     QAudioFormat _desiredInputFormat;
@@ -273,6 +283,11 @@ private:
 
     quint16 _outgoingAvatarAudioSequenceNumber;
 
+    QMutex _encoderMutex; // microphone and recorded audio are encoded from different threads
+    AudioCodecPointer _codec;
+    std::unique_ptr<AudioEncoder> _encoder;
+    bool _isEncoderStereo { false };
+
     AudioOutputIODevice _audioOutputIODevice;
 
     AudioIOStats _stats;
@@ -19,7 +19,8 @@
 
 #include "AudioConstants.h"
 
-void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes, quint16& sequenceNumber, const Transform& transform, PacketType packetType) {
+void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes, bool isStereo, quint16& sequenceNumber,
+                                             const Transform& transform, PacketType packetType) {
     static std::mutex _mutex;
     using Locker = std::unique_lock<std::mutex>;
     auto nodeList = DependencyManager::get<NodeList>();
@@ -27,7 +28,6 @@ void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes
     if (audioMixer && audioMixer->getActiveSocket()) {
         Locker lock(_mutex);
         auto audioPacket = NLPacket::create(packetType);
-        quint8 isStereo = bytes == AudioConstants::NETWORK_FRAME_BYTES_STEREO ? 1 : 0;
 
         // write sequence number
         audioPacket->writePrimitive(sequenceNumber++);
@@ -39,7 +39,8 @@ void AbstractAudioInterface::emitAudioPacket(const void* audioData, size_t bytes
             audioPacket->writePrimitive(numSilentSamples);
         } else {
             // set the mono/stereo byte
-            audioPacket->writePrimitive(isStereo);
+            quint8 channelFlag = isStereo ? 1 : 0;
+            audioPacket->writePrimitive(channelFlag);
         }
 
         // pack the three float positions
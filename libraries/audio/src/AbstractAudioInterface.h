@@ -28,7 +28,9 @@ class AbstractAudioInterface : public QObject {
 public:
     AbstractAudioInterface(QObject* parent = 0) : QObject(parent) {};
     
-    static void emitAudioPacket(const void* audioData, size_t bytes, quint16& sequenceNumber, const Transform& transform, PacketType packetType);
+    // the audio may be encoded by a codec, so the caller says whether it holds one channel or two
+    static void emitAudioPacket(const void* audioData, size_t bytes, bool isStereo, quint16& sequenceNumber,
+                                const Transform& transform, PacketType packetType);
 
 public slots:
     virtual bool outputLocalInjector(bool isStereo, AudioInjector* injector) = 0;
@@ -0,0 +1,180 @@
+//
+//  AudioADPCMCodec.cpp
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioADPCMCodec.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+const QString AudioADPCMCodec::NAME = "adpcm";
+
+namespace {
+
+const int NUM_STEPS = 89;
+
+const int STEP_SIZES[NUM_STEPS] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97,
+    107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796,
+    876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871,
+    5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623,
+    27086, 29794, 32767
+};
+
+const int INDEX_ADJUSTMENTS[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+
+// the predictor and step index of one channel, carried from sample to sample
+struct ChannelState {
+    int predictor { 0 };
+    int stepIndex { 0 };
+
+    // applies a nibble to the state, returns the new predicted sample
+    int16_t step(uint8_t nibble) {
+        int stepSize = STEP_SIZES[stepIndex];
+
+        int delta = stepSize >> 3;
+        if (nibble & 4) {
+            delta += stepSize;
+        }
+        if (nibble & 2) {
+            delta += stepSize >> 1;
+        }
+        if (nibble & 1) {
+            delta += stepSize >> 2;
+        }
+
+        predictor += (nibble & 8) ? -delta : delta;
+        predictor = predictor < INT16_MIN ? INT16_MIN : (predictor > INT16_MAX ? INT16_MAX : predictor);
+
+        stepIndex += INDEX_ADJUSTMENTS[nibble];
+        stepIndex = stepIndex < 0 ? 0 : (stepIndex >= NUM_STEPS ? NUM_STEPS - 1 : stepIndex);
+
+        return (int16_t)predictor;
+    }
+
+    // picks the nibble that brings the predictor closest to the sample, and applies it
+    uint8_t encode(int16_t sample) {
+        int stepSize = STEP_SIZES[stepIndex];
+        int difference = sample - predictor;
+
+        uint8_t nibble = 0;
+        if (difference < 0) {
+            nibble = 8;
+            difference = -difference;
+        }
+        if (difference >= stepSize) {
+            nibble |= 4;
+            difference -= stepSize;
+        }
+        stepSize >>= 1;
+        if (difference >= stepSize) {
+            nibble |= 2;
+            difference -= stepSize;
+        }
+        stepSize >>= 1;
+        if (difference >= stepSize) {
+            nibble |= 1;
+        }
+
+        step(nibble);
+        return nibble;
+    }
+};
+
+class ADPCMEncoder : public AudioEncoder {
+public:
+    ADPCMEncoder(int numChannels) : _channels(numChannels) {}
+
+    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override {
+        const int numChannels = (int)_channels.size();
+        const int16_t* samples = reinterpret_cast<const int16_t*>(decodedBuffer.constData());
+        const int numFrames = decodedBuffer.size() / (int)(sizeof(int16_t) * numChannels);
+        const int bytesPerChannel = AudioADPCMCodec::encodedBytesForFrames(numFrames, 1);
+
+        encodedBuffer.resize(bytesPerChannel * numChannels);
+        uint8_t* encoded = reinterpret_cast<uint8_t*>(encodedBuffer.data());
+
+        for (int channel = 0; channel < numChannels; ++channel) {
+            ChannelState& state = _channels[channel];
+            uint8_t* channelData = encoded + channel * bytesPerChannel;
+
+            // the header holds the state the first sample is encoded from
+            int16_t predictor = (int16_t)state.predictor;
+            memcpy(channelData, &predictor, sizeof(int16_t));
+            channelData[2] = (uint8_t)state.stepIndex;
+            channelData[3] = (numFrames & 1) ? 1 : 0;
+
+            uint8_t* nibbles = channelData + AudioADPCMCodec::CHANNEL_HEADER_BYTES;
+            for (int frame = 0; frame < numFrames; frame += 2) {
+                uint8_t packed = state.encode(samples[frame * numChannels + channel]);
+                if (frame + 1 < numFrames) {
+                    packed |= state.encode(samples[(frame + 1) * numChannels + channel]) << 4;
+                }
+                *nibbles++ = packed;
+            }
+        }
+    }
+
+private:
+    std::vector<ChannelState> _channels;
+};
+
+class ADPCMDecoder : public AudioDecoder {
+public:
+    ADPCMDecoder(int numChannels) : _numChannels(numChannels) {}
+
+    void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override {
+        const int bytesPerChannel = encodedBuffer.size() / _numChannels;
+        if (bytesPerChannel < AudioADPCMCodec::CHANNEL_HEADER_BYTES || encodedBuffer.size() % _numChannels != 0) {
+            // this frame was not written by an encoder with our channel count
+            decodedBuffer.clear();
+            return;
+        }
+
+        const uint8_t* encoded = reinterpret_cast<const uint8_t*>(encodedBuffer.constData());
+        const bool hasPadding = encoded[3] == 1;
+        const int numFrames = (bytesPerChannel - AudioADPCMCodec::CHANNEL_HEADER_BYTES) * 2 - (hasPadding ? 1 : 0);
+
+        decodedBuffer.resize(numFrames * _numChannels * sizeof(int16_t));
+        int16_t* samples = reinterpret_cast<int16_t*>(decodedBuffer.data());
+
+        for (int channel = 0; channel < _numChannels; ++channel) {
+            const uint8_t* channelData = encoded + channel * bytesPerChannel;
+
+            ChannelState state;
+            int16_t predictor;
+            memcpy(&predictor, channelData, sizeof(int16_t));
+            state.predictor = predictor;
+            state.stepIndex = channelData[2] < NUM_STEPS ? channelData[2] : NUM_STEPS - 1;
+
+            const uint8_t* nibbles = channelData + AudioADPCMCodec::CHANNEL_HEADER_BYTES;
+            for (int frame = 0; frame < numFrames; frame += 2) {
+                uint8_t packed = *nibbles++;
+                samples[frame * _numChannels + channel] = state.step(packed & 0x0f);
+                if (frame + 1 < numFrames) {
+                    samples[(frame + 1) * _numChannels + channel] = state.step(packed >> 4);
+                }
+            }
+        }
+    }
+
+private:
+    int _numChannels;
+};
+
+}
+
+std::unique_ptr<AudioEncoder> AudioADPCMCodec::createEncoder(int sampleRate, int numChannels) {
+    return std::unique_ptr<AudioEncoder> { new ADPCMEncoder(numChannels) };
+}
+
+std::unique_ptr<AudioDecoder> AudioADPCMCodec::createDecoder(int sampleRate, int numChannels) {
+    return std::unique_ptr<AudioDecoder> { new ADPCMDecoder(numChannels) };
+}
@@ -0,0 +1,40 @@
+//
+//  AudioADPCMCodec.h
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioADPCMCodec_h
+#define hifi_AudioADPCMCodec_h
+
+#include "AudioCodec.h"
+
+/// IMA ADPCM, four bits per sample. It costs a few operations per sample to encode or decode, and cuts a network
+/// frame to about a quarter of its size.
+///
+/// Every encoded frame starts with a header for each channel holding the predictor and step index the channel's
+/// samples were encoded from, followed by the samples of each channel packed two to a byte, so frames can be decoded
+/// on their own and a lost packet does not throw off the frames after it.
+class AudioADPCMCodec : public AudioCodec {
+public:
+    static const QString NAME;
+
+    // int16 predictor, uint8 step index, uint8 set to 1 when the last nibble of the channel is padding
+    static const int CHANNEL_HEADER_BYTES = 4;
+
+    static int encodedBytesForFrames(int numFrames, int numChannels) {
+        return numChannels * (CHANNEL_HEADER_BYTES + (numFrames + 1) / 2);
+    }
+
+    const QString& getName() const override { return NAME; }
+    bool hasIndependentFrames() const override { return true; }
+
+    std::unique_ptr<AudioEncoder> createEncoder(int sampleRate, int numChannels) override;
+    std::unique_ptr<AudioDecoder> createDecoder(int sampleRate, int numChannels) override;
+};
+
+#endif // hifi_AudioADPCMCodec_h
@@ -0,0 +1,82 @@
+//
+//  AudioCodec.cpp
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioCodec.h"
+
+#include "AudioADPCMCodec.h"
+
+namespace {
+
+// sends the samples as they are, this is what peers that do not negotiate a codec use
+class PCMCoder : public AudioEncoder, public AudioDecoder {
+public:
+    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) override { encodedBuffer = decodedBuffer; }
+    void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) override { decodedBuffer = encodedBuffer; }
+};
+
+class PCMCodec : public AudioCodec {
+public:
+    const QString& getName() const override { return NAME; }
+    bool hasIndependentFrames() const override { return true; }
+
+    std::unique_ptr<AudioEncoder> createEncoder(int sampleRate, int numChannels) override {
+        return std::unique_ptr<AudioEncoder> { new PCMCoder() };
+    }
+    std::unique_ptr<AudioDecoder> createDecoder(int sampleRate, int numChannels) override {
+        return std::unique_ptr<AudioDecoder> { new PCMCoder() };
+    }
+
+    static const QString NAME;
+};
+
+const QString PCMCodec::NAME = "pcm";
+
+AudioCodecList& codecList() {
+    // the built in codecs, in our order of preference
+    static AudioCodecList codecs {
+        std::make_shared<AudioADPCMCodec>(),
+        std::make_shared<PCMCodec>()
+    };
+    return codecs;
+}
+
+}
+
+void AudioCodecs::registerCodec(AudioCodecPointer codec) {
+    auto& codecs = codecList();
+    for (auto& existingCodec : codecs) {
+        if (existingCodec->getName() == codec->getName()) {
+            existingCodec = codec;
+            return;
+        }
+    }
+    codecs.push_back(codec);
+}
+
+AudioCodecPointer AudioCodecs::getCodec(const QString& name) {
+    for (auto& codec : codecList()) {
+        if (codec->getName() == name) {
+            return codec;
+        }
+    }
+    return AudioCodecPointer();
+}
+
+const AudioCodecList& AudioCodecs::getCodecs() {
+    return codecList();
+}
+
+QStringList AudioCodecs::getCodecNames() {
+    QStringList names;
+    for (auto& codec : codecList()) {
+        names << codec->getName();
+    }
+    return names;
+}
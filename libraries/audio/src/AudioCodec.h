@@ -0,0 +1,65 @@
+//
+//  AudioCodec.h
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioCodec_h
+#define hifi_AudioCodec_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+/// Encodes network frames of interleaved 16-bit samples. An encoder may keep state between frames, so each stream
+/// needs its own, and frames have to be encoded in the order they are sent.
+class AudioEncoder {
+public:
+    virtual ~AudioEncoder() {}
+    virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+};
+
+/// Decodes frames written by the matching AudioEncoder back to interleaved 16-bit samples.
+class AudioDecoder {
+public:
+    virtual ~AudioDecoder() {}
+    virtual void decode(const QByteArray& encodedBuffer, QByteArray& decodedBuffer) = 0;
+};
+
+class AudioCodec {
+public:
+    virtual ~AudioCodec() {}
+
+    /// the name the codec is negotiated by, it has to be the same on every client and mixer
+    virtual const QString& getName() const = 0;
+
+    /// true when every encoded frame can be decoded on its own, so the same frame can be sent to several listeners
+    /// whatever their decoders last saw
+    virtual bool hasIndependentFrames() const { return false; }
+
+    virtual std::unique_ptr<AudioEncoder> createEncoder(int sampleRate, int numChannels) = 0;
+    virtual std::unique_ptr<AudioDecoder> createDecoder(int sampleRate, int numChannels) = 0;
+};
+
+using AudioCodecPointer = std::shared_ptr<AudioCodec>;
+using AudioCodecList = std::vector<AudioCodecPointer>;
+
+/// The codecs this process can negotiate with its peers. The built in codecs are always available, and more can be
+/// registered before the first negotiation.
+class AudioCodecs {
+public:
+    static void registerCodec(AudioCodecPointer codec);
+
+    static AudioCodecPointer getCodec(const QString& name);
+    static const AudioCodecList& getCodecs();
+    static QStringList getCodecNames();
+};
+
+#endif // hifi_AudioCodec_h
@@ -18,6 +18,8 @@
 
 namespace AudioConstants {
     const int SAMPLE_RATE = 24000;
+    const int MONO = 1;
+    const int STEREO = 2;
 
     typedef int16_t AudioSample;
 
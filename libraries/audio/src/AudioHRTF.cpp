@@ -170,17 +170,98 @@ static bool cpuSupportsAVX() {
 
 #endif
 
+#if defined(_MSC_VER)
+
+static bool cpuSupportsAVX2() {
+    int info[4];
+    int mask1 = (1 << 12);  // FMA
+    int mask7 = (1 << 5);   // AVX2
+
+    bool result = false;
+    if (cpuSupportsAVX()) {
+
+        __cpuidex(info, 0x1, 0);
+        if ((info[2] & mask1) == mask1) {
+
+            __cpuidex(info, 0x7, 0);
+            if ((info[1] & mask7) == mask7) {
+                result = true;
+            }
+        }
+    }
+    return result;
+}
+
+#elif defined(__GNUC__)
+
+static bool cpuSupportsAVX2() {
+    unsigned int eax, ebx, ecx, edx;
+    unsigned int mask1 = (1 << 12);  // FMA
+    unsigned int mask7 = (1 << 5);   // AVX2
+
+    bool result = false;
+    if (cpuSupportsAVX() && __get_cpuid(0x1, &eax, &ebx, &ecx, &edx) && ((ecx & mask1) == mask1)) {
+
+        if (__get_cpuid_max(0, nullptr) >= 0x7) {
+            __cpuid_count(0x7, 0, eax, ebx, ecx, edx);
+            if ((ebx & mask7) == mask7) {
+                result = true;
+            }
+        }
+    }
+    return result;
+}
+
+#else
+
+static bool cpuSupportsAVX2() {
+    return false;
+}
+
+#endif
+
 //
 // Runtime CPU dispatch
 //
 
 typedef void FIR_1x4_t(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 FIR_1x4_t FIR_1x4_AVX;  // separate compilation with VEX-encoding enabled
+FIR_1x4_t FIR_1x4_AVX2; // separate compilation with AVX2 and FMA enabled
+
+static FIR_1x4_t* selectFIR_1x4() {
+    if (cpuSupportsAVX2()) {
+        return FIR_1x4_AVX2;
+    }
+    if (cpuSupportsAVX()) {
+        return FIR_1x4_AVX;
+    }
+    return FIR_1x4_SSE;
+}
 
 static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
 
-    static FIR_1x4_t* f = cpuSupportsAVX() ? FIR_1x4_AVX : FIR_1x4_SSE; // init on first call
-    (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames);                 // dispatch
+    static FIR_1x4_t* f = selectFIR_1x4();                  // init on first call
+    (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames);     // dispatch
+}
+
+// convert mono int16_t to float
+static void convertInput_1x1(int16_t* src, float* dst, int numFrames) {
+
+    __m128 scale = _mm_set1_ps(1/32768.0f);
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        __m128i a0 = _mm_loadu_si128((__m128i*)&src[i]);
+
+        // sign-extend
+        __m128i a1 = _mm_srai_epi32(_mm_unpackhi_epi16(a0, a0), 16);
+        a0 = _mm_srai_epi32(_mm_unpacklo_epi16(a0, a0), 16);
+
+        _mm_storeu_ps(&dst[i+0], _mm_mul_ps(_mm_cvtepi32_ps(a0), scale));
+        _mm_storeu_ps(&dst[i+4], _mm_mul_ps(_mm_cvtepi32_ps(a1), scale));
+    }
 }
 
 // 4 channel planar to interleaved
@@ -317,6 +398,177 @@ static void interpolate(float* dst, const float* src0, const float* src1, float
     }
 }
 
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+// 1 channel input, 4 channel output
+static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        float32x4_t acc2 = vdupq_n_f32(0.0f);
+        float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        assert(HRTF_TAPS % 4 == 0);
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            float32x4_t x0 = vld1q_f32(&ps[k+0]);
+            float32x4_t x1 = vld1q_f32(&ps[k+1]);
+            float32x4_t x2 = vld1q_f32(&ps[k+2]);
+            float32x4_t x3 = vld1q_f32(&ps[k+3]);
+
+            acc0 = vmlaq_n_f32(acc0, x0, coef0[-k-0]);
+            acc1 = vmlaq_n_f32(acc1, x0, coef1[-k-0]);
+            acc2 = vmlaq_n_f32(acc2, x0, coef2[-k-0]);
+            acc3 = vmlaq_n_f32(acc3, x0, coef3[-k-0]);
+
+            acc0 = vmlaq_n_f32(acc0, x1, coef0[-k-1]);
+            acc1 = vmlaq_n_f32(acc1, x1, coef1[-k-1]);
+            acc2 = vmlaq_n_f32(acc2, x1, coef2[-k-1]);
+            acc3 = vmlaq_n_f32(acc3, x1, coef3[-k-1]);
+
+            acc0 = vmlaq_n_f32(acc0, x2, coef0[-k-2]);
+            acc1 = vmlaq_n_f32(acc1, x2, coef1[-k-2]);
+            acc2 = vmlaq_n_f32(acc2, x2, coef2[-k-2]);
+            acc3 = vmlaq_n_f32(acc3, x2, coef3[-k-2]);
+
+            acc0 = vmlaq_n_f32(acc0, x3, coef0[-k-3]);
+            acc1 = vmlaq_n_f32(acc1, x3, coef1[-k-3]);
+            acc2 = vmlaq_n_f32(acc2, x3, coef2[-k-3]);
+            acc3 = vmlaq_n_f32(acc3, x3, coef3[-k-3]);
+        }
+
+        vst1q_f32(&dst0[i], acc0);
+        vst1q_f32(&dst1[i], acc1);
+        vst1q_f32(&dst2[i], acc2);
+        vst1q_f32(&dst3[i], acc3);
+    }
+}
+
+// 4 channel planar to interleaved
+static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4x4_t x;
+        x.val[0] = vld1q_f32(&src0[i]);
+        x.val[1] = vld1q_f32(&src1[i]);
+        x.val[2] = vld1q_f32(&src2[i]);
+        x.val[3] = vld1q_f32(&src3[i]);
+
+        vst4q_f32(&dst[4*i], x);
+    }
+}
+
+// 4 channels (interleaved)
+static void biquad_4x4(float* src, float* dst, float coef[5][4], float state[2][4], int numFrames) {
+
+    float32x4_t w1 = vld1q_f32(state[0]);
+    float32x4_t w2 = vld1q_f32(state[1]);
+
+    float32x4_t b0 = vld1q_f32(coef[0]);
+    float32x4_t b1 = vld1q_f32(coef[1]);
+    float32x4_t b2 = vld1q_f32(coef[2]);
+    float32x4_t a1 = vld1q_f32(coef[3]);
+    float32x4_t a2 = vld1q_f32(coef[4]);
+
+    // flush-to-zero is not the default on all ARM targets, so offset the input instead to prevent denormals
+    float32x4_t denormalOffset = vdupq_n_f32(1.0e-20f);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        // transposed Direct Form II
+        float32x4_t x0 = vaddq_f32(vld1q_f32(&src[4*i]), denormalOffset);
+        float32x4_t y0;
+
+        y0 = vmlaq_f32(w1, x0, b0);
+        w1 = vmlaq_f32(w2, x0, b1);
+        w2 = vmulq_f32(x0, b2);
+        w1 = vmlsq_f32(w1, y0, a1);
+        w2 = vmlsq_f32(w2, y0, a2);
+
+        vst1q_f32(&dst[4*i], y0);
+    }
+
+    // save state
+    vst1q_f32(state[0], w1);
+    vst1q_f32(state[1], w2);
+}
+
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t f0 = vld1q_f32(&win[i]);
+
+        // deinterleave
+        float32x4x4_t x = vld4q_f32(&src[4*i]);
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+
+        // crossfade and accumulate
+        y.val[0] = vaddq_f32(y.val[0], vmlaq_f32(x.val[2], f0, vsubq_f32(x.val[0], x.val[2])));
+        y.val[1] = vaddq_f32(y.val[1], vmlaq_f32(x.val[3], f0, vsubq_f32(x.val[1], x.val[3])));
+
+        // interleave
+        vst2q_f32(&dst[2*i], y);
+    }
+}
+
+// linear interpolation with gain
+static void interpolate(float* dst, const float* src0, const float* src1, float frac, float gain) {
+
+    float f0 = HRTF_GAIN * gain * (1.0f - frac);
+    float f1 = HRTF_GAIN * gain * frac;
+
+    assert(HRTF_TAPS % 4 == 0);
+
+    for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+        float32x4_t x0 = vld1q_f32(&src0[k]);
+        float32x4_t x1 = vld1q_f32(&src1[k]);
+
+        x0 = vmlaq_n_f32(vmulq_n_f32(x0, f0), x1, f1);
+
+        vst1q_f32(&dst[k], x0);
+    }
+}
+
+// convert mono int16_t to float
+static void convertInput_1x1(int16_t* src, float* dst, int numFrames) {
+
+    assert(numFrames % 8 == 0);
+
+    for (int i = 0; i < numFrames; i += 8) {
+
+        int16x8_t a0 = vld1q_s16(&src[i]);
+
+        // sign-extend
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(a0)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(a0)));
+
+        vst1q_f32(&dst[i+0], vmulq_n_f32(f0, 1/32768.0f));
+        vst1q_f32(&dst[i+4], vmulq_n_f32(f1, 1/32768.0f));
+    }
+}
+
 #else   // portable reference code
 
 // 1 channel input, 4 channel output
@@ -507,6 +759,14 @@ static void interpolate(float* dst, const float* src0, const float* src1, float
     }
 }
 
+// convert mono int16_t to float
+static void convertInput_1x1(int16_t* src, float* dst, int numFrames) {
+
+    for (int i = 0; i < numFrames; i++) {
+        dst[i] = (float)src[i] * (1/32768.0f);
+    }
+}
+
 #endif
 
 // design a 2nd order Thiran allpass
@@ -628,9 +888,7 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
     _gainState = gain;
 
     // convert mono input to float
-    for (int i = 0; i < HRTF_BLOCK; i++) {
-        in[HRTF_TAPS+i] = (float)input[i] * (1/32768.0f);
-    }
+    convertInput_1x1(input, &in[HRTF_TAPS], HRTF_BLOCK);
 
     // FIR state update
     memcpy(in, _firState, HRTF_TAPS * sizeof(float));
@@ -0,0 +1,224 @@
+//
+//  AudioMixKernels.cpp
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixKernels.h"
+
+#include "AudioConstants.h"
+
+static const float SAMPLE_SCALE = (float)AudioConstants::MAX_SAMPLE_VALUE;
+static const float MIN_SAMPLE = (float)AudioConstants::MIN_SAMPLE_VALUE;
+static const float MAX_SAMPLE = (float)AudioConstants::MAX_SAMPLE_VALUE;
+
+// the reference conversion, also used for the samples left over by the vectorized loops
+static inline int16_t convertSample(float sample) {
+    int value = (int)(sample * SAMPLE_SCALE);
+    if (value < AudioConstants::MIN_SAMPLE_VALUE) {
+        value = AudioConstants::MIN_SAMPLE_VALUE;
+    } else if (value > AudioConstants::MAX_SAMPLE_VALUE) {
+        value = AudioConstants::MAX_SAMPLE_VALUE;
+    }
+    return (int16_t)value;
+}
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+void mixInt16ToFloat(const int16_t* input, float* output, float gain, int numSamples) {
+    __m128 scale = _mm_set1_ps(gain / SAMPLE_SCALE);
+
+    int i = 0;
+    for (; i < numSamples - 7; i += 8) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&input[i]);
+
+        // sign-extend
+        __m128i a1 = _mm_srai_epi32(_mm_unpackhi_epi16(a0, a0), 16);
+        a0 = _mm_srai_epi32(_mm_unpacklo_epi16(a0, a0), 16);
+
+        __m128 y0 = _mm_add_ps(_mm_loadu_ps(&output[i+0]), _mm_mul_ps(_mm_cvtepi32_ps(a0), scale));
+        __m128 y1 = _mm_add_ps(_mm_loadu_ps(&output[i+4]), _mm_mul_ps(_mm_cvtepi32_ps(a1), scale));
+
+        _mm_storeu_ps(&output[i+0], y0);
+        _mm_storeu_ps(&output[i+4], y1);
+    }
+    for (; i < numSamples; i++) {
+        output[i] += (float)input[i] * (gain / SAMPLE_SCALE);
+    }
+}
+
+void mixMonoInt16ToStereoFloat(const int16_t* input, float* output, float gain, int numFrames) {
+    __m128 scale = _mm_set1_ps(gain / SAMPLE_SCALE);
+
+    int i = 0;
+    for (; i < numFrames - 7; i += 8) {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)&input[i]);
+
+        // sign-extend
+        __m128i a1 = _mm_srai_epi32(_mm_unpackhi_epi16(a0, a0), 16);
+        a0 = _mm_srai_epi32(_mm_unpacklo_epi16(a0, a0), 16);
+
+        __m128 f0 = _mm_mul_ps(_mm_cvtepi32_ps(a0), scale);
+        __m128 f1 = _mm_mul_ps(_mm_cvtepi32_ps(a1), scale);
+
+        // duplicate into both channels
+        __m128 x0 = _mm_unpacklo_ps(f0, f0);
+        __m128 x1 = _mm_unpackhi_ps(f0, f0);
+        __m128 x2 = _mm_unpacklo_ps(f1, f1);
+        __m128 x3 = _mm_unpackhi_ps(f1, f1);
+
+        _mm_storeu_ps(&output[2*i+0], _mm_add_ps(_mm_loadu_ps(&output[2*i+0]), x0));
+        _mm_storeu_ps(&output[2*i+4], _mm_add_ps(_mm_loadu_ps(&output[2*i+4]), x1));
+        _mm_storeu_ps(&output[2*i+8], _mm_add_ps(_mm_loadu_ps(&output[2*i+8]), x2));
+        _mm_storeu_ps(&output[2*i+12], _mm_add_ps(_mm_loadu_ps(&output[2*i+12]), x3));
+    }
+    for (; i < numFrames; i++) {
+        float sample = (float)input[i] * (gain / SAMPLE_SCALE);
+        output[2*i+0] += sample;
+        output[2*i+1] += sample;
+    }
+}
+
+bool convertMixToInt16(const float* input, int16_t* output, int numSamples) {
+    __m128 scale = _mm_set1_ps(SAMPLE_SCALE);
+    __m128 minSample = _mm_set1_ps(MIN_SAMPLE);
+    __m128 maxSample = _mm_set1_ps(MAX_SAMPLE);
+    __m128i nonZero = _mm_setzero_si128();
+
+    int i = 0;
+    for (; i < numSamples - 7; i += 8) {
+        __m128 f0 = _mm_mul_ps(_mm_loadu_ps(&input[i+0]), scale);
+        __m128 f1 = _mm_mul_ps(_mm_loadu_ps(&input[i+4]), scale);
+
+        // saturate before truncating, so large samples can't overflow the conversion
+        f0 = _mm_min_ps(_mm_max_ps(f0, minSample), maxSample);
+        f1 = _mm_min_ps(_mm_max_ps(f1, minSample), maxSample);
+
+        __m128i a0 = _mm_packs_epi32(_mm_cvttps_epi32(f0), _mm_cvttps_epi32(f1));
+        _mm_storeu_si128((__m128i*)&output[i], a0);
+
+        nonZero = _mm_or_si128(nonZero, a0);
+    }
+
+    bool hasAudio = _mm_movemask_epi8(_mm_cmpeq_epi16(nonZero, _mm_setzero_si128())) != 0xffff;
+
+    for (; i < numSamples; i++) {
+        output[i] = convertSample(input[i]);
+        hasAudio = hasAudio || (output[i] != 0);
+    }
+    return hasAudio;
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+#include <arm_neon.h>
+
+void mixInt16ToFloat(const int16_t* input, float* output, float gain, int numSamples) {
+    float scale = gain / SAMPLE_SCALE;
+
+    int i = 0;
+    for (; i < numSamples - 7; i += 8) {
+        int16x8_t a0 = vld1q_s16(&input[i]);
+
+        // sign-extend
+        float32x4_t f0 = vcvtq_f32_s32(vmovl_s16(vget_low_s16(a0)));
+        float32x4_t f1 = vcvtq_f32_s32(vmovl_s16(vget_high_s16(a0)));
+
+        vst1q_f32(&output[i+0], vmlaq_n_f32(vld1q_f32(&output[i+0]), f0, scale));
+        vst1q_f32(&output[i+4], vmlaq_n_f32(vld1q_f32(&output[i+4]), f1, scale));
+    }
+    for (; i < numSamples; i++) {
+        output[i] += (float)input[i] * scale;
+    }
+}
+
+void mixMonoInt16ToStereoFloat(const int16_t* input, float* output, float gain, int numFrames) {
+    float scale = gain / SAMPLE_SCALE;
+
+    int i = 0;
+    for (; i < numFrames - 3; i += 4) {
+        float32x4_t f0 = vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vld1_s16(&input[i]))), scale);
+
+        // deinterleave, accumulate into both channels, and interleave
+        float32x4x2_t y = vld2q_f32(&output[2*i]);
+        y.val[0] = vaddq_f32(y.val[0], f0);
+        y.val[1] = vaddq_f32(y.val[1], f0);
+        vst2q_f32(&output[2*i], y);
+    }
+    for (; i < numFrames; i++) {
+        float sample = (float)input[i] * scale;
+        output[2*i+0] += sample;
+        output[2*i+1] += sample;
+    }
+}
+
+bool convertMixToInt16(const float* input, int16_t* output, int numSamples) {
+    float32x4_t minSample = vdupq_n_f32(MIN_SAMPLE);
+    float32x4_t maxSample = vdupq_n_f32(MAX_SAMPLE);
+    int16x8_t nonZero = vdupq_n_s16(0);
+
+    int i = 0;
+    for (; i < numSamples - 7; i += 8) {
+        float32x4_t f0 = vmulq_n_f32(vld1q_f32(&input[i+0]), SAMPLE_SCALE);
+        float32x4_t f1 = vmulq_n_f32(vld1q_f32(&input[i+4]), SAMPLE_SCALE);
+
+        // saturate before truncating, so large samples can't overflow the conversion
+        f0 = vminq_f32(vmaxq_f32(f0, minSample), maxSample);
+        f1 = vminq_f32(vmaxq_f32(f1, minSample), maxSample);
+
+        int16x8_t a0 = vcombine_s16(vqmovn_s32(vcvtq_s32_f32(f0)), vqmovn_s32(vcvtq_s32_f32(f1)));
+        vst1q_s16(&output[i], a0);
+
+        nonZero = vorrq_s16(nonZero, a0);
+    }
+
+    int16x4_t nonZeroHalf = vorr_s16(vget_low_s16(nonZero), vget_high_s16(nonZero));
+    bool hasAudio = vget_lane_u64(vreinterpret_u64_s16(nonZeroHalf), 0) != 0;
+
+    for (; i < numSamples; i++) {
+        output[i] = convertSample(input[i]);
+        hasAudio = hasAudio || (output[i] != 0);
+    }
+    return hasAudio;
+}
+
+#else   // portable reference code
+
+void mixInt16ToFloat(const int16_t* input, float* output, float gain, int numSamples) {
+    float scale = gain / SAMPLE_SCALE;
+
+    for (int i = 0; i < numSamples; i++) {
+        output[i] += (float)input[i] * scale;
+    }
+}
+
+void mixMonoInt16ToStereoFloat(const int16_t* input, float* output, float gain, int numFrames) {
+    float scale = gain / SAMPLE_SCALE;
+
+    for (int i = 0; i < numFrames; i++) {
+        float sample = (float)input[i] * scale;
+        output[2*i+0] += sample;
+        output[2*i+1] += sample;
+    }
+}
+
+bool convertMixToInt16(const float* input, int16_t* output, int numSamples) {
+    bool hasAudio = false;
+
+    for (int i = 0; i < numSamples; i++) {
+        output[i] = convertSample(input[i]);
+        hasAudio = hasAudio || (output[i] != 0);
+    }
+    return hasAudio;
+}
+
+#endif
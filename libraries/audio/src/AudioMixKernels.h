@@ -0,0 +1,30 @@
+//
+//  AudioMixKernels.h
+//  libraries/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixKernels_h
+#define hifi_AudioMixKernels_h
+
+#include <stdint.h>
+
+//
+// Conversions between network samples and a float mix, where full scale is AudioConstants::MAX_SAMPLE_VALUE.
+// SSE2 is assumed on x86 and NEON is used on ARM when available, otherwise portable code is used.
+//
+
+// accumulates samples into a mix (either both mono, or both interleaved stereo), scaled by gain
+void mixInt16ToFloat(const int16_t* input, float* output, float gain, int numSamples);
+
+// accumulates mono samples into both channels of an interleaved stereo mix, scaled by gain
+void mixMonoInt16ToStereoFloat(const int16_t* input, float* output, float gain, int numFrames);
+
+// converts a mix to samples, truncating and saturating, returns true if any of the samples is not zero
+bool convertMixToInt16(const float* input, int16_t* output, int numSamples);
+
+#endif // hifi_AudioMixKernels_h
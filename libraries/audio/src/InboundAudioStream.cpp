@@ -11,6 +11,8 @@
 
 #include <glm/glm.hpp>
 
+#include <QtCore/QElapsedTimer>
+
 #include <NLPacket.h>
 #include <Node.h>
 
@@ -91,6 +93,16 @@ void InboundAudioStream::setReverb(float reverbTime, float wetLevel) {
     _wetLevel = wetLevel;
 }
 
+void InboundAudioStream::setupCodec(AudioCodecPointer codec, int numChannels) {
+    _codec = codec;
+    _decoder = codec ? codec->createDecoder(AudioConstants::SAMPLE_RATE, numChannels) : nullptr;
+    resetDecodeStats();
+}
+
+void InboundAudioStream::cleanupCodec() {
+    setupCodec(AudioCodecPointer(), 0);
+}
+
 void InboundAudioStream::perSecondCallbackForUpdatingStats() {
     _incomingSequenceNumberStats.pushStatsToHistory();
     _timeGapStatsForDesiredCalcOnTooManyStarves.currentIntervalComplete();
@@ -114,7 +126,30 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
     int prePropertyPosition = message.getPosition();
     int propertyBytes = parseStreamProperties(message.getType(), message.readWithoutCopy(message.getBytesLeftToRead()), networkSamples);
     message.seek(prePropertyPosition + propertyBytes);
-    
+
+    bool isSilent = message.getType() == PacketType::SilentAudioFrame;
+    bool isWritten = arrivalInfo._status == SequenceNumberStats::OnTime
+        || arrivalInfo._status == SequenceNumberStats::Early;
+
+    QByteArray audioData;
+    if (!isSilent && isWritten) {
+        audioData = message.readWithoutCopy(message.getBytesLeftToRead());
+
+        if (_decoder) {
+            // the stream properties counted the encoded bytes, the decoded frame tells us how many samples it holds
+            QElapsedTimer decodeTimer;
+            decodeTimer.start();
+
+            _decoder->decode(audioData, _decodedBuffer);
+
+            _decodeNsecs += decodeTimer.nsecsElapsed();
+            ++_numDecodes;
+
+            audioData = _decodedBuffer;
+            networkSamples = _decodedBuffer.size() / sizeof(int16_t);
+        }
+    }
+
     // handle this packet based on its arrival status.
     switch (arrivalInfo._status) {
         case SequenceNumberStats::Early: {
@@ -128,10 +163,10 @@ int InboundAudioStream::parseData(ReceivedMessage& message) {
         }
         case SequenceNumberStats::OnTime: {
             // Packet is on time; parse its data to the ringbuffer
-            if (message.getType() == PacketType::SilentAudioFrame) {
+            if (isSilent) {
                 writeDroppableSilentSamples(networkSamples);
             } else {
-                parseAudioData(message.getType(), message.readWithoutCopy(message.getBytesLeftToRead()), networkSamples);
+                parseAudioData(message.getType(), audioData, networkSamples);
             }
             break;
         }
@@ -18,6 +18,7 @@
 #include <ReceivedMessage.h>
 #include <StDev.h>
 
+#include "AudioCodec.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -174,6 +175,15 @@ public:
     void setReverb(float reverbTime, float wetLevel);
     void clearReverb() { _hasReverb = false; }
 
+    /// decodes the audio of every packet that is not silent with the given codec before it is written to the buffer
+    void setupCodec(AudioCodecPointer codec, int numChannels);
+    void cleanupCodec();
+    const AudioCodecPointer& getCodec() const { return _codec; }
+
+    /// time spent decoding since the last call to resetDecodeStats()
+    float getAverageDecodeUsecs() const { return _numDecodes > 0 ? (float)_decodeNsecs / (_numDecodes * NSECS_PER_USEC) : 0.0f; }
+    void resetDecodeStats() { _decodeNsecs = 0; _numDecodes = 0; }
+
 public slots:
     /// This function should be called every second for all the stats to function properly. If dynamic jitter buffers
     /// is enabled, those stats are used to calculate _desiredJitterBufferFrames.
@@ -267,6 +277,12 @@ protected:
     bool _hasReverb;
     float _reverbTime;
     float _wetLevel;
+
+    AudioCodecPointer _codec;
+    std::unique_ptr<AudioDecoder> _decoder;
+    QByteArray _decodedBuffer;
+    quint64 _decodeNsecs { 0 };
+    int _numDecodes { 0 };
 };
 
 float calculateRepeatedFrameFadeFactor(int indexOfRepeat);
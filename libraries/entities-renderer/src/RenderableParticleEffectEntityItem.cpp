@@ -41,11 +41,9 @@ public:
         float lifespan;
     };
     
-    struct ParticlePrimitive {
-        ParticlePrimitive(glm::vec3 xyzIn, glm::vec2 uvIn) : xyz(xyzIn), uv(uvIn) {}
-        glm::vec3 xyz; // Position
-        glm::vec2 uv; // Lifetime + seed
-    };
+    // the layout of the instance buffer, written by the particle store
+    using ParticlePrimitive = ParticleStore::Instance;
+    using ParticlePrimitives = std::vector<ParticlePrimitive>;
     
     using Payload = render::Payload<ParticlePayloadData>;
     using Pointer = Payload::DataPointer;
@@ -56,16 +54,15 @@ public:
     using Format = gpu::Stream::Format;
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
-    using ParticlePrimitives = std::vector<ParticlePrimitive>;
     
     ParticlePayloadData() {
         ParticleUniforms uniforms;
         _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
         
         _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-                                    offsetof(ParticlePrimitive, xyz), gpu::Stream::PER_INSTANCE);
+                                    offsetof(ParticlePrimitive, position), gpu::Stream::PER_INSTANCE);
         _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-                                    offsetof(ParticlePrimitive, uv), gpu::Stream::PER_INSTANCE);
+                                    offsetof(ParticlePrimitive, lifetimeAndSeed), gpu::Stream::PER_INSTANCE);
     }
 
     void setPipeline(PipelinePointer pipeline) { _pipeline = pipeline; }
@@ -79,6 +76,19 @@ public:
 
     BufferPointer getParticleBuffer() { return _particleBuffer; }
     const BufferPointer& getParticleBuffer() const { return _particleBuffer; }
+
+    // copies the particles into the instance buffer, which is only reallocated when it has to grow
+    void setParticles(const ParticlePrimitives& particles) {
+        _numParticles = particles.size();
+        Buffer::Size size = sizeof(ParticlePrimitive) * _numParticles;
+        if (size > _particleBuffer->getSize()) {
+            _particleBuffer->resize(size);
+        }
+        if (size > 0) {
+            _particleBuffer->setSubData(0, size, reinterpret_cast<const gpu::Byte*>(particles.data()));
+        }
+    }
+    size_t getNumParticles() const { return _numParticles; }
     
     const ParticleUniforms& getParticleUniforms() const { return _uniformBuffer.get<ParticleUniforms>(); }
     ParticleUniforms& editParticleUniforms() { return _uniformBuffer.edit<ParticleUniforms>(); }
@@ -104,8 +114,7 @@ public:
         batch.setInputFormat(_vertexFormat);
         batch.setInputBuffer(0, _particleBuffer, 0, sizeof(ParticlePrimitive));
 
-        auto numParticles = _particleBuffer->getSize() / sizeof(ParticlePrimitive);
-        batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
+        batch.drawInstanced((gpu::uint32)_numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
     }
 
 protected:
@@ -114,6 +123,7 @@ protected:
     PipelinePointer _pipeline;
     FormatPointer _vertexFormat { std::make_shared<Format>() };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
+    size_t _numParticles { 0 }; // the buffer can hold more than this
     BufferView _uniformBuffer;
     TexturePointer _texture;
     bool _visibleFlag = true;
@@ -230,11 +240,11 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
     particleUniforms.color.spread = glm::vec4(getColorSpreadRGB(), getAlphaSpread());
     particleUniforms.lifespan = getLifespan();
     
-    // Build particle primitives
-    auto particlePrimitives = std::make_shared<ParticlePrimitives>();
-    particlePrimitives->reserve(_particles.size()); // Reserve space
-    for (auto& particle : _particles) {
-        particlePrimitives->emplace_back(particle.position, glm::vec2(particle.lifetime, particle.seed));
+    // The render thread may still be drawing from the payload's instance buffer, so the particles are handed over
+    // to be copied into it when the payload is updated
+    auto particlePrimitives = std::make_shared<ParticlePrimitives>(_particles.size());
+    if (!_particles.isEmpty()) {
+        _particles.writeInstances(particlePrimitives->data());
     }
 
     bool successb, successp, successr;
@@ -260,13 +270,10 @@ void RenderableParticleEffectEntityItem::updateRenderItem() {
         memcpy(&payload.editParticleUniforms(), &particleUniforms, sizeof(ParticleUniforms));
         
         // Update particle buffer
-        auto particleBuffer = payload.getParticleBuffer();
-        size_t numBytes = sizeof(ParticlePrimitive) * particlePrimitives->size();
-        particleBuffer->resize(numBytes);
-        if (numBytes == 0) {
+        payload.setParticles(*particlePrimitives);
+        if (payload.getNumParticles() == 0) {
             return;
         }
-        memcpy(particleBuffer->editData(), particlePrimitives->data(), numBytes);
 
         // Update transform and bounds
         payload.setModelTransform(transform);
@@ -81,6 +81,13 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
   When a script changes _volData, compressVolumeDataAndSendEditPacket is called to update _voxelData and to
   send a packet to the entity-server.
 
+  All of this is done in chunks (see PolyVoxChunks).  _voxelData holds each chunk compressed separately and _chunks
+  keeps a decoded copy of it, so decompressVolumeData only expands the chunks that differ from what is already in
+  _volData, and compressVolumeDataAndSendEditPacket only recompresses the chunks a script touched and only sends
+  those to the entity-server.  Likewise, getMesh only re-extracts the surface of the chunks which were touched
+  (and of their neighbors, whose surfaces can depend on the voxels along their shared faces), then stitches the
+  cached surfaces of every chunk back together into _mesh.  The collision hulls are cached the same way.
+
   decompressVolumeData, getMesh, computeShapeInfoWorker, and compressVolumeDataAndSendEditPacket are too expensive
   to run on a thread that has other things to do.  These use QtConcurrent::run to spawn a thread.  As each thread
   finishes, it adjusts the dirty flags so that the next call to render() will kick off the next step.
@@ -146,8 +153,9 @@ bool isEdged(PolyVoxEntityItem::PolyVoxSurfaceStyle surfaceStyle) {
 void RenderablePolyVoxEntityItem::setVoxelData(QByteArray voxelData) {
     // compressed voxel information from the entity-server
     withWriteLock([&] {
-        if (_voxelData != voxelData) {
-            _voxelData = voxelData;
+        QByteArray newVoxelData = applyVoxelDataUpdate(_voxelData, voxelData);
+        if (_voxelData != newVoxelData) {
+            _voxelData = newVoxelData;
             _voxelDataDirty = true;
         }
     });
@@ -179,6 +187,7 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
         } else {
             _volDataDirty = true;
             _voxelSurfaceStyle = voxelSurfaceStyle;
+            markAllMeshChunksDirty();
         }
     });
 
@@ -761,6 +770,8 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(glm::vec3 voxelVolumeSize)
 
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        resetChunks();
     });
 }
 
@@ -817,12 +828,22 @@ bool RenderablePolyVoxEntityItem::setVoxelInternal(int x, int y, int z, uint8_t
         return result;
     }
 
+    if (getVoxelInternal(x, y, z) != toValue) {
+        _chunksToSend[_chunks.getChunkIndexForVoxel(x, y, z)] = true;
+    }
+
     result = updateOnCount(x, y, z, toValue);
 
     if (isEdged(_voxelSurfaceStyle)) {
         _volData->setVoxelAt(x + 1, y + 1, z + 1, toValue);
+        if (result) {
+            markVolDataVoxelForRemesh(x + 1, y + 1, z + 1);
+        }
     } else {
         _volData->setVoxelAt(x, y, z, toValue);
+        if (result) {
+            markVolDataVoxelForRemesh(x, y, z);
+        }
     }
 
     if (x == 0 || y == 0 || z == 0) {
@@ -858,109 +879,227 @@ bool RenderablePolyVoxEntityItem::updateOnCount(int x, int y, int z, uint8_t toV
     return false;
 }
 
+void RenderablePolyVoxEntityItem::resetChunks() {
+    // _volData has just been allocated, so every voxel is zero.  This assumes that the caller has
+    // write-locked the entity.
+    _chunks = PolyVoxChunks((quint16)_voxelVolumeSize.x, (quint16)_voxelVolumeSize.y, (quint16)_voxelVolumeSize.z);
+    _chunksToSend.assign(_chunks.getChunkCount(), false);
+
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
+    _meshChunksX = (_volData->getWidth() + CHUNK_SIDE - 1) / CHUNK_SIDE;
+    _meshChunksY = (_volData->getHeight() + CHUNK_SIDE - 1) / CHUNK_SIDE;
+    _meshChunksZ = (_volData->getDepth() + CHUNK_SIDE - 1) / CHUNK_SIDE;
+    _meshChunks.clear();
+    _meshChunks.resize(_meshChunksX * _meshChunksY * _meshChunksZ);
+    _meshChunksDirty.assign(_meshChunks.size(), true);
+}
+
+void RenderablePolyVoxEntityItem::markAllMeshChunksDirty() {
+    _meshChunksDirty.assign(_meshChunks.size(), true);
+}
+
+void RenderablePolyVoxEntityItem::markVolDataVoxelForRemesh(int x, int y, int z) {
+    // x, y, z are in _volData coordinates.  A voxel on the face of a chunk also shapes the surface of the chunk
+    // on the other side of that face, so those get re-extracted as well.
+    if (_meshChunksDirty.empty()) {
+        return;
+    }
+
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
+    int xLow = std::max(x - 1, 0) / CHUNK_SIDE;
+    int yLow = std::max(y - 1, 0) / CHUNK_SIDE;
+    int zLow = std::max(z - 1, 0) / CHUNK_SIDE;
+    int xHigh = std::min((x + 1) / CHUNK_SIDE, _meshChunksX - 1);
+    int yHigh = std::min((y + 1) / CHUNK_SIDE, _meshChunksY - 1);
+    int zHigh = std::min((z + 1) / CHUNK_SIDE, _meshChunksZ - 1);
+
+    for (int chunkZ = zLow; chunkZ <= zHigh; chunkZ++) {
+        for (int chunkY = yLow; chunkY <= yHigh; chunkY++) {
+            for (int chunkX = xLow; chunkX <= xHigh; chunkX++) {
+                _meshChunksDirty[(chunkZ * _meshChunksY + chunkY) * _meshChunksX + chunkX] = true;
+            }
+        }
+    }
+}
+
+QByteArray RenderablePolyVoxEntityItem::getChunkVoxels(int index) {
+    // copy the voxels of one of _chunks out of _volData.  This assumes that the caller has locked the entity.
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
+    QByteArray uncompressedData(PolyVoxChunks::CHUNK_VOXEL_COUNT, '\0');
+
+    int originX, originY, originZ;
+    _chunks.getChunkOrigin(index, originX, originY, originZ);
+    int xHigh = std::min(originX + CHUNK_SIDE, (int)_chunks.getXSize());
+    int yHigh = std::min(originY + CHUNK_SIDE, (int)_chunks.getYSize());
+    int zHigh = std::min(originZ + CHUNK_SIDE, (int)_chunks.getZSize());
+
+    for (int z = originZ; z < zHigh; z++) {
+        for (int y = originY; y < yHigh; y++) {
+            for (int x = originX; x < xHigh; x++) {
+                int uncompressedIndex = ((z - originZ) * CHUNK_SIDE + (y - originY)) * CHUNK_SIDE + (x - originX);
+                uncompressedData[uncompressedIndex] = getVoxelInternal(x, y, z);
+            }
+        }
+    }
+    return uncompressedData;
+}
+
 void RenderablePolyVoxEntityItem::decompressVolumeData() {
-    // take compressed data and expand it into _volData.
+    // take compressed data and expand the chunks which differ from what's already in _volData.
     QByteArray voxelData;
+    PolyVoxChunks currentChunks;
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
     withReadLock([&] {
         voxelData = _voxelData;
+        currentChunks = _chunks;
     });
 
     QtConcurrent::run([=] {
-        QDataStream reader(voxelData);
-        quint16 voxelXSize, voxelYSize, voxelZSize;
-        reader >> voxelXSize;
-        reader >> voxelYSize;
-        reader >> voxelZSize;
-
-        if (voxelXSize == 0 || voxelXSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelYSize == 0 || voxelYSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION ||
-            voxelZSize == 0 || voxelZSize > PolyVoxEntityItem::MAX_VOXEL_DIMENSION) {
-            qDebug() << "voxelSize is not reasonable, skipping decompressions."
-                     << voxelXSize << voxelYSize << voxelZSize << getName() << getID();
-            entity->setVoxelDataDirty(false);
+        PolyVoxChunks newChunks = currentChunks;
+        if (!newChunks.readVoxelData(voxelData)) {
+            qDebug() << "PolyVox decompress -- unable to read voxel data, skipping decompression." << getName() << getID();
             return;
         }
-        int rawSize = voxelXSize * voxelYSize * voxelZSize;
-
-        QByteArray compressedData;
-        reader >> compressedData;
 
-        QByteArray uncompressedData = qUncompress(compressedData);
-
-        if (uncompressedData.size() != rawSize) {
-            qDebug() << "PolyVox decompress -- size is (" << voxelXSize << voxelYSize << voxelZSize << ")"
-                     << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size()
-                     << getName() << getID();
-            entity->setVoxelDataDirty(false);
+        if (!newChunks.hasSize(currentChunks.getXSize(), currentChunks.getYSize(), currentChunks.getZSize())) {
+            // voxel data is always written at the size of the volume it came from, so this arrived ahead of
+            // the matching voxelVolumeSize.  Resizing _volData will flag the voxel data as dirty again.
+            qDebug() << "PolyVox decompress -- size is (" << newChunks.getXSize() << newChunks.getYSize()
+                     << newChunks.getZSize() << ") but volume size is (" << currentChunks.getXSize()
+                     << currentChunks.getYSize() << currentChunks.getZSize() << ")" << getName() << getID();
             return;
         }
 
-        entity->setVoxelsFromData(uncompressedData, voxelXSize, voxelYSize, voxelZSize);
+        QVector<int> chunkIndices;
+        QVector<QByteArray> uncompressedChunks;
+        for (int i = 0; i < newChunks.getChunkCount(); i++) {
+            if (newChunks.getChunk(i) == currentChunks.getChunk(i)) {
+                continue;
+            }
+            QByteArray uncompressedData = PolyVoxChunks::uncompressChunk(newChunks.getChunk(i));
+            if (uncompressedData.size() != PolyVoxChunks::CHUNK_VOXEL_COUNT) {
+                qDebug() << "PolyVox decompress -- expected uncompressed chunk length of" << PolyVoxChunks::CHUNK_VOXEL_COUNT
+                         << "but length is" << uncompressedData.size() << getName() << getID();
+                return;
+            }
+            chunkIndices << i;
+            uncompressedChunks << uncompressedData;
+        }
+
+        if (!chunkIndices.isEmpty()) {
+            entity->setVoxelsFromChunks(newChunks, chunkIndices, uncompressedChunks);
+        }
     });
 }
 
-void RenderablePolyVoxEntityItem::setVoxelsFromData(QByteArray uncompressedData,
-                                                    quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
+void RenderablePolyVoxEntityItem::setVoxelsFromChunks(const PolyVoxChunks& chunks, const QVector<int>& chunkIndices,
+                                                      const QVector<QByteArray>& uncompressedChunks) {
     // this accepts the payload from decompressVolumeData
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
     withWriteLock([&] {
-        for (int z = 0; z < voxelZSize; z++) {
-            for (int y = 0; y < voxelYSize; y++) {
-                for (int x = 0; x < voxelXSize; x++) {
-                    int uncompressedIndex = (z * voxelYSize * voxelXSize) + (y * voxelZSize) + x;
-                    setVoxelInternal(x, y, z, uncompressedData[uncompressedIndex]);
+        if (!_chunks.hasSize(chunks.getXSize(), chunks.getYSize(), chunks.getZSize())) {
+            // _volData was resized while this was being decompressed
+            return;
+        }
+
+        for (int i = 0; i < chunkIndices.size(); i++) {
+            int index = chunkIndices[i];
+            const QByteArray& uncompressedData = uncompressedChunks[i];
+
+            int originX, originY, originZ;
+            _chunks.getChunkOrigin(index, originX, originY, originZ);
+            int xHigh = std::min(originX + CHUNK_SIDE, (int)_chunks.getXSize());
+            int yHigh = std::min(originY + CHUNK_SIDE, (int)_chunks.getYSize());
+            int zHigh = std::min(originZ + CHUNK_SIDE, (int)_chunks.getZSize());
+
+            // these voxels came from the entity-server, so they don't need to be sent back to it
+            bool wasWaitingToSend = _chunksToSend[index];
+            for (int z = originZ; z < zHigh; z++) {
+                for (int y = originY; y < yHigh; y++) {
+                    for (int x = originX; x < xHigh; x++) {
+                        int uncompressedIndex = ((z - originZ) * CHUNK_SIDE + (y - originY)) * CHUNK_SIDE + (x - originX);
+                        setVoxelInternal(x, y, z, uncompressedData[uncompressedIndex]);
+                    }
                 }
             }
+            _chunksToSend[index] = wasWaitingToSend;
+            _chunks.setChunk(index, chunks.getChunk(index));
         }
         _volDataDirty = true;
     });
 }
 
 void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
-    // compress the data in _volData and save the results.  The compressed form is used during
-    // saves to disk and for transmission over the wire to the entity-server
+    // compress the chunks of _volData that were edited since the last call and save the results.  _voxelData
+    // holds the compressed form of the whole volume, which is used during saves to disk and for transmission
+    // to other interfaces, but only the edited chunks are sent to the entity-server.
 
     EntityItemPointer entity = getThisPointer();
 
-    quint16 voxelXSize;
-    quint16 voxelYSize;
-    quint16 voxelZSize;
-    withReadLock([&] {
-        voxelXSize = _voxelVolumeSize.x;
-        voxelYSize = _voxelVolumeSize.y;
-        voxelZSize = _voxelVolumeSize.z;
-    });
-
     EntityTreeElementPointer element = getElement();
     EntityTreePointer tree = element ? element->getTree() : nullptr;
 
-    QtConcurrent::run([voxelXSize, voxelYSize, voxelZSize, entity, tree] {
-        int rawSize = voxelXSize * voxelYSize * voxelZSize;
-        QByteArray uncompressedData = QByteArray(rawSize, '\0');
-
+    QtConcurrent::run([entity, tree] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
-        polyVoxEntity->forEachVoxelValue(voxelXSize, voxelYSize, voxelZSize, [&] (int x, int y, int z, uint8_t uVoxelValue) {
-            int uncompressedIndex =
-                z * voxelYSize * voxelXSize +
-                y * voxelXSize +
-                x;
-            uncompressedData[uncompressedIndex] = uVoxelValue;
-        });
 
-        QByteArray newVoxelData;
-        QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+        PolyVoxChunks chunks;
+        std::vector<bool> changedChunks;
+        QVector<int> chunkIndices;
+        QVector<QByteArray> uncompressedChunks;
+        polyVoxEntity->withWriteLock([&] {
+            chunks = polyVoxEntity->_chunks;
+            changedChunks.swap(polyVoxEntity->_chunksToSend);
+            polyVoxEntity->_chunksToSend.assign(changedChunks.size(), false);
+            for (int i = 0; i < (int)changedChunks.size(); i++) {
+                if (changedChunks[i]) {
+                    chunkIndices << i;
+                    uncompressedChunks << polyVoxEntity->getChunkVoxels(i);
+                }
+            }
+        });
 
-        writer << voxelXSize << voxelYSize << voxelZSize;
+        if (chunkIndices.isEmpty()) {
+            // another call already picked up these edits
+            return;
+        }
 
-        QByteArray compressedData = qCompress(uncompressedData, 9);
-        writer << compressedData;
+        for (int i = 0; i < chunkIndices.size(); i++) {
+            chunks.setChunk(chunkIndices[i], PolyVoxChunks::compressChunk(uncompressedChunks[i]));
+        }
 
         // make sure the compressed data can be sent over the wire-protocol
-        if (newVoxelData.size() > 1150) {
+        if (chunks.toVoxelData().size() > 1150) {
             // HACK -- until we have a way to allow for properties larger than MTU, don't update.
-            // revert the active voxel-space to the last version that fit.
+            // keep the edits pending, they'll go out with the next edit that brings the volume back under the limit.
             qDebug() << "compressed voxel data is too large" << entity->getName() << entity->getID();
+            polyVoxEntity->withWriteLock([&] {
+                if (polyVoxEntity->_chunks.hasSize(chunks.getXSize(), chunks.getYSize(), chunks.getZSize())) {
+                    for (int index : chunkIndices) {
+                        polyVoxEntity->_chunksToSend[index] = true;
+                    }
+                }
+            });
+            return;
+        }
+
+        QByteArray voxelDataUpdate = chunks.toPartialVoxelData(changedChunks);
+
+        bool saved = false;
+        polyVoxEntity->withWriteLock([&] {
+            if (!polyVoxEntity->_chunks.hasSize(chunks.getXSize(), chunks.getYSize(), chunks.getZSize())) {
+                // _volData was resized while this was being compressed
+                return;
+            }
+            for (int index : chunkIndices) {
+                polyVoxEntity->_chunks.setChunk(index, chunks.getChunk(index));
+            }
+            // _volData already holds these voxels, so there's no need to flag _voxelDataDirty
+            polyVoxEntity->_voxelData = polyVoxEntity->_chunks.toVoxelData();
+            saved = true;
+        });
+
+        if (!saved) {
             return;
         }
 
@@ -968,14 +1107,16 @@ void RenderablePolyVoxEntityItem::compressVolumeDataAndSendEditPacket() {
         entity->setLastEdited(now);
         entity->setLastBroadcast(now);
 
-        std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->setVoxelData(newVoxelData);
+        if (!tree) {
+            return;
+        }
 
         tree->withReadLock([&] {
             EntityItemProperties properties = entity->getProperties();
-            properties.setVoxelDataDirty();
+            properties.setVoxelData(voxelDataUpdate);
             properties.setLastEdited(now);
 
-            EntitySimulation* simulation = tree ? tree->getSimulation() : nullptr;
+            EntitySimulation* simulation = tree->getSimulation();
             PhysicalEntitySimulation* peSimulation = static_cast<PhysicalEntitySimulation*>(simulation);
             EntityEditPacketSender* packetSender = peSimulation ? peSimulation->getPacketSender() : nullptr;
             if (packetSender) {
@@ -1044,7 +1185,10 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int y = 0; y < _volData->getHeight(); y++) {
                     for (int z = 0; z < _volData->getDepth(); z++) {
                         uint8_t neighborValue = polyVoxXPNeighbor->getVoxel(0, y, z);
-                        _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
+                        if (_volData->getVoxelAt(_volData->getWidth() - 1, y, z) != neighborValue) {
+                            _volData->setVoxelAt(_volData->getWidth() - 1, y, z, neighborValue);
+                            markVolDataVoxelForRemesh(_volData->getWidth() - 1, y, z);
+                        }
                     }
                 }
             });
@@ -1058,7 +1202,10 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int x = 0; x < _volData->getWidth(); x++) {
                     for (int z = 0; z < _volData->getDepth(); z++) {
                         uint8_t neighborValue = polyVoxYPNeighbor->getVoxel(x, 0, z);
-                        _volData->setVoxelAt(x, _volData->getWidth() - 1, z, neighborValue);
+                        if (_volData->getVoxelAt(x, _volData->getWidth() - 1, z) != neighborValue) {
+                            _volData->setVoxelAt(x, _volData->getWidth() - 1, z, neighborValue);
+                            markVolDataVoxelForRemesh(x, _volData->getWidth() - 1, z);
+                        }
                     }
                 }
             });
@@ -1072,7 +1219,10 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                 for (int x = 0; x < _volData->getWidth(); x++) {
                     for (int y = 0; y < _volData->getHeight(); y++) {
                         uint8_t neighborValue = polyVoxZPNeighbor->getVoxel(x, y, 0);
-                        _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
+                        if (_volData->getVoxelAt(x, y, _volData->getDepth() - 1) != neighborValue) {
+                            _volData->setVoxelAt(x, y, _volData->getDepth() - 1, neighborValue);
+                            markVolDataVoxelForRemesh(x, y, _volData->getDepth() - 1);
+                        }
                     }
                 }
             });
@@ -1082,81 +1232,204 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
 
 void RenderablePolyVoxEntityItem::getMesh() {
     // use _volData to make a renderable mesh
+    cacheNeighbors();
+    copyUpperEdgesFromNeighbors();
+
+    auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
+
+    QtConcurrent::run([entity] {
+        entity->remeshDirtyChunks();
+    });
+}
+
+int RenderablePolyVoxEntityItem::remeshDirtyChunks() {
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    std::vector<int> dirtyChunks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        for (int i = 0; i < (int)_meshChunksDirty.size(); i++) {
+            if (_meshChunksDirty[i]) {
+                dirtyChunks.push_back(i);
+                _meshChunksDirty[i] = false;
+            }
+        }
     });
 
-    cacheNeighbors();
-    copyUpperEdgesFromNeighbors();
+    std::vector<MeshChunk> newMeshChunks(dirtyChunks.size());
+    withReadLock([&] {
+        for (size_t i = 0; i < dirtyChunks.size(); i++) {
+            extractMeshChunk(dirtyChunks[i], voxelSurfaceStyle, newMeshChunks[i]);
+        }
+    });
 
-    auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
+    // stitch the surfaces of all the chunks together
+    std::vector<MeshChunkVertex> vertices;
+    std::vector<uint32_t> indices;
+    withWriteLock([&] {
+        for (size_t i = 0; i < dirtyChunks.size(); i++) {
+            if (dirtyChunks[i] < (int)_meshChunks.size()) {
+                _meshChunks[dirtyChunks[i]] = std::move(newMeshChunks[i]);
+            }
+        }
 
+        size_t vertexCount = 0;
+        size_t indexCount = 0;
+        for (const MeshChunk& meshChunk : _meshChunks) {
+            vertexCount += meshChunk.vertices.size();
+            indexCount += meshChunk.indices.size();
+        }
+        vertices.reserve(vertexCount);
+        indices.reserve(indexCount);
+
+        for (const MeshChunk& meshChunk : _meshChunks) {
+            uint32_t baseIndex = (uint32_t)vertices.size();
+            vertices.insert(vertices.end(), meshChunk.vertices.begin(), meshChunk.vertices.end());
+            for (uint32_t index : meshChunk.indices) {
+                indices.push_back(baseIndex + index);
+            }
+        }
+    });
+
+    // convert to a Sam mesh
+    model::MeshPointer mesh(new model::Mesh());
+    auto indexBuffer = std::make_shared<gpu::Buffer>(indices.size() * sizeof(uint32_t), (gpu::Byte*)indices.data());
+    auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
+    auto indexBufferView = new gpu::BufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
+    mesh->setIndexBuffer(*indexBufferView);
+
+    auto vertexBuffer = std::make_shared<gpu::Buffer>(vertices.size() * sizeof(MeshChunkVertex),
+                                                      (gpu::Byte*)vertices.data());
+    auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
+    gpu::Resource::Size vertexBufferSize = 0;
+    if (vertexBufferPtr->getSize() > sizeof(float) * 3) {
+        vertexBufferSize = vertexBufferPtr->getSize() - sizeof(float) * 3;
+    }
+    auto vertexBufferView = new gpu::BufferView(vertexBufferPtr, 0, vertexBufferSize,
+                                                sizeof(MeshChunkVertex),
+                                                gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
+    mesh->setVertexBuffer(*vertexBufferView);
+    mesh->addAttribute(gpu::Stream::NORMAL,
+                       gpu::BufferView(vertexBufferPtr,
+                                       sizeof(float) * 3,
+                                       vertexBufferPtr->getSize() - sizeof(float) * 3,
+                                       sizeof(MeshChunkVertex),
+                                       gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
+    setMesh(mesh);
+
+    return (int)dirtyChunks.size();
+}
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        model::MeshPointer mesh(new model::Mesh());
+void RenderablePolyVoxEntityItem::extractMeshChunk(int index, PolyVoxSurfaceStyle voxelSurfaceStyle, MeshChunk& meshChunk) {
+    // extract the surface and collision hulls of one chunk of _volData.  This assumes that the caller has
+    // locked the entity.
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
+    bool marchingCubes = voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+        voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES;
+
+    int lowX = (index % _meshChunksX) * CHUNK_SIDE;
+    int lowY = ((index / _meshChunksX) % _meshChunksY) * CHUNK_SIDE;
+    int lowZ = (index / (_meshChunksX * _meshChunksY)) * CHUNK_SIDE;
+
+    // both extractors work on pairs of neighboring voxels -- the cubic extractor puts a face between a solid voxel
+    // and an empty one, the marching-cubes extractor works on the cells between voxels -- and neither visits a pair
+    // that starts on the region's upper face.  Each region therefore reaches one voxel into the next chunk to pick
+    // up the faces and cells that straddle the two.
+    int highX = std::min(lowX + CHUNK_SIDE, _volData->getWidth() - 1);
+    int highY = std::min(lowY + CHUNK_SIDE, _volData->getHeight() - 1);
+    int highZ = std::min(lowZ + CHUNK_SIDE, _volData->getDepth() - 1);
+
+    // a single layer of voxels has no pairs of its own, they are all handled by the chunk below it
+    if (highX > lowX && highY > lowY && highZ > lowZ) {
+        PolyVox::Region region(PolyVox::Vector3DInt32(lowX, lowY, lowZ), PolyVox::Vector3DInt32(highX, highY, highZ));
 
         // A mesh object to hold the result of surface extraction
         PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        if (marchingCubes) {
+            PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (_volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+        } else {
+            PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                (_volData, region, &polyVoxMesh);
+            surfaceExtractor.execute();
+        }
 
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
-                }
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+        // the extractors place vertices relative to the region's lower corner
+        glm::vec3 regionOffset(lowX, lowY, lowZ);
+        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getVertices();
+        meshChunk.vertices.reserve(vecVertices.size());
+        for (const PolyVox::PositionMaterialNormal& vertex : vecVertices) {
+            PolyVox::Vector3DFloat position = vertex.getPosition();
+            PolyVox::Vector3DFloat normal = vertex.getNormal();
+            meshChunk.vertices.push_back({
+                glm::vec3(position.getX(), position.getY(), position.getZ()) + regionOffset,
+                glm::vec3(normal.getX(), normal.getY(), normal.getZ())
+            });
+        }
+        meshChunk.indices = polyVoxMesh.getIndices();
+    }
+
+    if (marchingCubes) {
+        // pull each triangle in the mesh into a polyhedron which can be collided with
+        for (size_t i = 0; i + 2 < meshChunk.indices.size(); i += 3) {
+            const glm::vec3& p0 = meshChunk.vertices[meshChunk.indices[i]].position;
+            const glm::vec3& p1 = meshChunk.vertices[meshChunk.indices[i + 1]].position;
+            const glm::vec3& p2 = meshChunk.vertices[meshChunk.indices[i + 2]].position;
+
+            glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << p0 << p1 << p2 << p3;
+            meshChunk.hulls << pointsInPart;
+        }
+        return;
+    }
+
+    // one box per voxel that isn't buried, for the voxels of this chunk only
+    int voxelHighX = std::min(lowX + CHUNK_SIDE - 1, _volData->getWidth() - 1);
+    int voxelHighY = std::min(lowY + CHUNK_SIDE - 1, _volData->getHeight() - 1);
+    int voxelHighZ = std::min(lowZ + CHUNK_SIDE - 1, _volData->getDepth() - 1);
+    int edgeOffset = isEdged(voxelSurfaceStyle) ? 1 : 0;
+    float offL = -0.5f;
+    float offH = 0.5f;
+    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
+        offL += 1.0f;
+        offH += 1.0f;
+    }
+
+    for (int z = lowZ - edgeOffset; z <= voxelHighZ - edgeOffset; z++) {
+        for (int y = lowY - edgeOffset; y <= voxelHighY - edgeOffset; y++) {
+            for (int x = lowX - edgeOffset; x <= voxelHighX - edgeOffset; x++) {
+                if (!inUserBounds(_volData, voxelSurfaceStyle, x, y, z) || getVoxelInternal(x, y, z) == 0) {
+                    continue;
                 }
-            }
-        });
 
-        // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
-        auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
-                                                         (gpu::Byte*)vecIndices.data());
-        auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
-        auto indexBufferView = new gpu::BufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::RAW));
-        mesh->setIndexBuffer(*indexBufferView);
+                if ((x > 0 && getVoxelInternal(x - 1, y, z) > 0) &&
+                    (y > 0 && getVoxelInternal(x, y - 1, z) > 0) &&
+                    (z > 0 && getVoxelInternal(x, y, z - 1) > 0) &&
+                    (x < _voxelVolumeSize.x - 1 && getVoxelInternal(x + 1, y, z) > 0) &&
+                    (y < _voxelVolumeSize.y - 1 && getVoxelInternal(x, y + 1, z) > 0) &&
+                    (z < _voxelVolumeSize.z - 1 && getVoxelInternal(x, y, z + 1) > 0)) {
+                    // this voxel has neighbors in every cardinal direction, so there's no need
+                    // to include it in the collision hull.
+                    continue;
+                }
 
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getVertices();
-        auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
-                                                          (gpu::Byte*)vecVertices.data());
-        auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
-        gpu::Resource::Size vertexBufferSize = 0;
-        if (vertexBufferPtr->getSize() > sizeof(float) * 3) {
-            vertexBufferSize = vertexBufferPtr->getSize() - sizeof(float) * 3;
+                QVector<glm::vec3> pointsInPart;
+                pointsInPart << glm::vec3(x + offL, y + offL, z + offL);
+                pointsInPart << glm::vec3(x + offL, y + offL, z + offH);
+                pointsInPart << glm::vec3(x + offL, y + offH, z + offL);
+                pointsInPart << glm::vec3(x + offL, y + offH, z + offH);
+                pointsInPart << glm::vec3(x + offH, y + offL, z + offL);
+                pointsInPart << glm::vec3(x + offH, y + offL, z + offH);
+                pointsInPart << glm::vec3(x + offH, y + offH, z + offL);
+                pointsInPart << glm::vec3(x + offH, y + offH, z + offH);
+                meshChunk.hulls << pointsInPart;
+            }
         }
-        auto vertexBufferView = new gpu::BufferView(vertexBufferPtr, 0, vertexBufferSize,
-                                                    sizeof(PolyVox::PositionMaterialNormal),
-                                                    gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW));
-        mesh->setVertexBuffer(*vertexBufferView);
-        mesh->addAttribute(gpu::Stream::NORMAL,
-                           gpu::BufferView(vertexBufferPtr,
-                                           sizeof(float) * 3,
-                                           vertexBufferPtr->getSize() - sizeof(float) * 3,
-                                           sizeof(PolyVox::PositionMaterialNormal),
-                                           gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::RAW)));
-        entity->setMesh(mesh);
-    });
+    }
 }
 
 void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
@@ -1176,133 +1449,35 @@ void RenderablePolyVoxEntityItem::setMesh(model::MeshPointer mesh) {
 }
 
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine.  The hulls were built along with each chunk's
+    // surface in extractMeshChunk, so all that's left is to move them into model space.
     if (!_meshInitialized) {
         return;
     }
 
     EntityItemPointer entity = getThisPointer();
 
-    PolyVoxSurfaceStyle voxelSurfaceStyle;
-    glm::vec3 voxelVolumeSize;
-    model::MeshPointer mesh;
-
-    withReadLock([&] {
-        voxelSurfaceStyle = _voxelSurfaceStyle;
-        voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
-    });
-
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity] {
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> points;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
-
-                QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
-                // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                points << newMeshPoints;
-                // add points to the new convex hull
-                points[i++] << pointsInPart;
-            }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize.x, voxelVolumeSize.y, voxelVolumeSize.z,
-                                             [&](int x, int y, int z, uint8_t value) {
-                if (value > 0) {
-                    if ((x > 0 && polyVoxEntity->getVoxelInternal(x - 1, y, z) > 0) &&
-                        (y > 0 && polyVoxEntity->getVoxelInternal(x, y - 1, z) > 0) &&
-                        (z > 0 && polyVoxEntity->getVoxelInternal(x, y, z - 1) > 0) &&
-                        (x < voxelVolumeSize.x - 1 && polyVoxEntity->getVoxelInternal(x + 1, y, z) > 0) &&
-                        (y < voxelVolumeSize.y - 1 && polyVoxEntity->getVoxelInternal(x, y + 1, z) > 0) &&
-                        (z < voxelVolumeSize.z - 1 && polyVoxEntity->getVoxelInternal(x, y, z + 1) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
-                    }
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
 
+        polyVoxEntity->withReadLock([&] {
+            for (const MeshChunk& meshChunk : polyVoxEntity->_meshChunks) {
+                for (const QVector<glm::vec3>& hull : meshChunk.hulls) {
                     QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
+                    pointsInPart.reserve(hull.size());
+                    for (const glm::vec3& point : hull) {
+                        glm::vec3 pointModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                        box += pointModel;
+                        pointsInPart << pointModel;
                     }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
                     // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    points << newMeshPoints;
-                    // add points to the new convex hull
-                    points[i++] << pointsInPart;
+                    points << pointsInPart;
                 }
-            });
-        }
+            }
+        });
         polyVoxEntity->setCollisionPoints(points, box);
     });
 }
@@ -20,6 +20,7 @@
 
 #include <TextureCache.h>
 
+#include "PolyVoxChunks.h"
 #include "PolyVoxEntityItem.h"
 #include "RenderableEntityItem.h"
 #include "gpu/Context.h"
@@ -118,11 +119,17 @@ public:
 
     virtual void updateRegistrationPoint(const glm::vec3& value);
 
-    void setVoxelsFromData(QByteArray uncompressedData, quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize);
+    void setVoxelsFromChunks(const PolyVoxChunks& chunks, const QVector<int>& chunkIndices,
+                             const QVector<QByteArray>& uncompressedChunks);
     void forEachVoxelValue(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize,
                            std::function<void(int, int, int, uint8_t)> thunk);
 
     void setMesh(model::MeshPointer mesh);
+    model::MeshPointer getCurrentMesh() {
+        model::MeshPointer mesh;
+        withReadLock([&] { mesh = _mesh; });
+        return mesh;
+    }
     void setCollisionPoints(const QVector<QVector<glm::vec3>> points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData; }
 
@@ -131,10 +138,27 @@ public:
 
     void setVolDataDirty() { withWriteLock([&] { _volDataDirty = true; }); }
 
+    // re-extract the surface of every mesh chunk touched since the last pass and rebuild _mesh from the
+    // per-chunk surfaces.  Returns the number of chunks that were re-extracted.  getMesh runs this off the main thread.
+    int remeshDirtyChunks();
+    void setAllMeshChunksDirty() { withWriteLock([&] { markAllMeshChunksDirty(); }); }
+
 private:
     // The PolyVoxEntityItem class has _voxelData which contains dimensions and compressed voxel data.  The dimensions
     // may not match _voxelVolumeSize.
 
+    struct MeshChunkVertex {
+        glm::vec3 position; // in _volData coordinates
+        glm::vec3 normal;
+    };
+
+    // the surface and collision hulls extracted from one chunk of _volData
+    struct MeshChunk {
+        std::vector<MeshChunkVertex> vertices;
+        std::vector<uint32_t> indices;
+        QVector<QVector<glm::vec3>> hulls; // in voxel coordinates, see computeShapeInfoWorker
+    };
+
     model::MeshPointer _mesh;
     bool _meshDirty { true }; // does collision-shape need to be recomputed?
     bool _meshInitialized { false };
@@ -153,6 +177,24 @@ private:
     bool _volDataDirty = false; // does getMesh need to be called?
     int _onCount; // how many non-zero voxels are in _volData
 
+    // compressed copy of _volData, chunk by chunk, as of the last time _voxelData was read or written
+    PolyVoxChunks _chunks;
+    std::vector<bool> _chunksToSend; // chunks edited locally that the entity-server hasn't been sent yet
+
+    // _volData is meshed in chunks of PolyVoxChunks::CHUNK_SIDE voxels (measured in _volData coordinates, which
+    // are offset from user coordinates when edged), so an edit only re-extracts the chunks it touched.
+    std::vector<MeshChunk> _meshChunks;
+    std::vector<bool> _meshChunksDirty;
+    int _meshChunksX { 0 };
+    int _meshChunksY { 0 };
+    int _meshChunksZ { 0 };
+
+    void resetChunks();
+    void markAllMeshChunksDirty();
+    void markVolDataVoxelForRemesh(int x, int y, int z);
+    void extractMeshChunk(int index, PolyVoxSurfaceStyle voxelSurfaceStyle, MeshChunk& meshChunk);
+    QByteArray getChunkVoxels(int index);
+
     bool _neighborsNeedUpdate { false };
 
     bool updateOnCount(int x, int y, int z, uint8_t toValue);
@@ -100,6 +100,10 @@ EntityItem::~EntityItem() {
     assert(!_physicsInfo);
 }
 
+std::atomic<quint64> EntityItem::_encodedDataHits { 0 };
+std::atomic<quint64> EntityItem::_encodedDataMisses { 0 };
+std::atomic<quint64> EntityItem::_encodedDataBytesSaved { 0 };
+
 EntityPropertyFlags EntityItem::getEntityProperties(EncodeBitstreamParams& params) const {
     EntityPropertyFlags requestedProperties;
 
@@ -153,6 +157,27 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
+    // If all of our properties are being sent, and we haven't changed since they were last encoded (for any viewer),
+    // then that encoding can be copied as it is. Only the remainder of a partially sent entity is encoded every time.
+    bool sendingAllProperties = !entityTreeElementExtraEncodeData ||
+        !entityTreeElementExtraEncodeData->entities.getRemainingProperties(getEntityItemID());
+    int startOfEntity = packetData->getUncompressedByteOffset();
+
+    if (sendingAllProperties) {
+        std::shared_ptr<const EncodedData> encodedData = std::atomic_load(&_encodedData);
+        if (encodedData && isEncodedDataCurrent(*encodedData)) {
+            if (packetData->appendRawData(encodedData->bytes)) {
+                _encodedDataHits++;
+                _encodedDataBytesSaved += encodedData->bytes.size();
+                params.trackSend(getID(), getLastEdited());
+                return appendState;
+            }
+            // it doesn't fit whole, so encode as much of it as fits below
+        } else {
+            _encodedDataMisses++;
+        }
+    }
+
     // encode our ID as a byte count coded byte stream
     QByteArray encodedID = getID().toRfc4122();
 
@@ -177,8 +202,12 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
-        requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
+    if (entityTreeElementExtraEncodeData) {
+        const EntityPropertyFlags* remainingProperties =
+            entityTreeElementExtraEncodeData->entities.getRemainingProperties(getEntityItemID());
+        if (remainingProperties) {
+            requestedProperties = *remainingProperties;
+        }
     }
 
     LevelDetails entityLevel = packetData->startLevel();
@@ -317,6 +346,21 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         entityTreeElementExtraEncodeData->entities.insert(getEntityItemID(), propertiesDidntFit);
     }
 
+    // keep a complete encoding for the next viewer to be sent this entity
+    if (sendingAllProperties && appendState == OctreeElement::COMPLETED) {
+        int endOfEntity = packetData->getUncompressedByteOffset();
+        std::shared_ptr<EncodedData> encodedData = std::make_shared<EncodedData>();
+        encodedData->lastEdited = lastEdited;
+        encodedData->lastUpdated = getLastUpdated();
+        encodedData->lastSimulated = getLastSimulated();
+        encodedData->changedOnServer = getLastChangedOnServer();
+        encodedData->simulatorID = _simulationOwner.getID();
+        encodedData->simulationPriority = _simulationOwner.getPriority();
+        encodedData->bytes = QByteArray((const char*)packetData->getUncompressedData(startOfEntity),
+                                        endOfEntity - startOfEntity);
+        std::atomic_store(&_encodedData, std::shared_ptr<const EncodedData>(encodedData));
+    }
+
     // if any part of our entity was sent, call trackSend
     if (appendState != OctreeElement::NONE) {
         params.trackSend(getID(), getLastEdited());
@@ -325,6 +369,15 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     return appendState;
 }
 
+bool EntityItem::isEncodedDataCurrent(const EncodedData& encodedData) const {
+    return encodedData.lastEdited == getLastEdited() &&
+        encodedData.lastUpdated == getLastUpdated() &&
+        encodedData.lastSimulated == getLastSimulated() &&
+        encodedData.changedOnServer == getLastChangedOnServer() &&
+        encodedData.simulatorID == _simulationOwner.getID() &&
+        encodedData.simulationPriority == _simulationOwner.getPriority();
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -1004,6 +1057,14 @@ bool EntityItem::isMovingRelativeToParent() const {
     return hasLocalVelocity() || hasLocalAngularVelocity();
 }
 
+void EntityItem::markAsChangedOnServer() {
+    _changedOnServer = usecTimestampNow();
+    EntityTreePointer tree = getTree();
+    if (tree) {
+        tree->trackJournaledChange(getEntityItemID());
+    }
+}
+
 EntityTreePointer EntityItem::getTree() const {
     EntityTreeElementPointer containingElement = getElement();
     EntityTreePointer tree = containingElement ? containingElement->getTree() : nullptr;
@@ -12,6 +12,7 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
 #include <stdint.h>
 
@@ -108,7 +109,7 @@ public:
     quint64 getLastBroadcast() const { return _lastBroadcast; }
     void setLastBroadcast(quint64 lastBroadcast) { _lastBroadcast = lastBroadcast; }
 
-    void markAsChangedOnServer() { _changedOnServer = usecTimestampNow();  }
+    void markAsChangedOnServer(); // also queues the entity for the next journal write of its tree
     quint64 getLastChangedOnServer() const { return _changedOnServer; }
 
     // TODO: eventually only include properties changed since the params.lastViewFrustumSent time
@@ -117,6 +118,11 @@ public:
     virtual OctreeElement::AppendState appendEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                                 EntityTreeElementExtraEncodeData* entityTreeElementExtraEncodeData) const;
 
+    // stats for the whole-entity encodings that appendEntityData() reuses across viewers
+    static quint64 getEncodedDataHits() { return _encodedDataHits; }
+    static quint64 getEncodedDataMisses() { return _encodedDataMisses; }
+    static quint64 getEncodedDataBytesSaved() { return _encodedDataBytesSaved; }
+
     virtual void appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                     EntityTreeElementExtraEncodeData* entityTreeElementExtraEncodeData,
                                     EntityPropertyFlags& requestedProperties,
@@ -407,6 +413,7 @@ public:
     virtual glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override { return glm::vec3(0.0f); }
     virtual bool setAbsoluteJointRotationInObjectFrame(int index, const glm::quat& rotation) override { return false; }
     virtual bool setAbsoluteJointTranslationInObjectFrame(int index, const glm::vec3& translation) override { return false; }
+    virtual bool hasStaticJoints() const override { return true; }
 
     virtual int getJointIndex(const QString& name) const { return -1; }
     virtual QStringList getJointNames() const { return QStringList(); }
@@ -447,6 +454,24 @@ protected:
     quint64 _created;
     quint64 _changedOnServer;
 
+    // The last encoding of all of this entity's properties, along with what it depends on that changes without an
+    // edit. It is shared by all the threads sending this entity, so it is only ever replaced, never modified.
+    struct EncodedData {
+        quint64 lastEdited;
+        quint64 lastUpdated;
+        quint64 lastSimulated;
+        quint64 changedOnServer;
+        QUuid simulatorID;
+        quint8 simulationPriority;
+        QByteArray bytes;
+    };
+    bool isEncodedDataCurrent(const EncodedData& encodedData) const;
+    mutable std::shared_ptr<const EncodedData> _encodedData; // only accessed with std::atomic_load/atomic_store
+
+    static std::atomic<quint64> _encodedDataHits;
+    static std::atomic<quint64> _encodedDataMisses;
+    static std::atomic<quint64> _encodedDataBytesSaved;
+
     mutable AABox _cachedAABox;
     mutable AACube _maxAACube;
     mutable AACube _minAACube;
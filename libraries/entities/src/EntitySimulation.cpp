@@ -152,6 +152,7 @@ void EntitySimulation::sortEntitiesThatMoved() {
             prepareEntityForDelete(entity);
         } else {
             moveOperator.addEntityToMoveList(entity, newCube);
+            _entityTree->trackJournaledChange(entity->getEntityItemID());
             ++itemItr;
         }
     }
@@ -10,8 +10,10 @@
 //
 
 #include <PerfStat.h>
+#include <QDataStream>
 #include <QDateTime>
 #include <QtScript/QScriptEngine>
+#include <UUID.h>
 
 #include "EntityTree.h"
 #include "EntitySimulation.h"
@@ -94,6 +96,7 @@ void EntityTree::postAddEntity(EntityItemPointer entity) {
     }
 
     _isDirty = true;
+    trackJournaledChange(entity->getEntityItemID());
     maybeNotifyNewCollisionSoundURL("", entity->getCollisionSoundURL());
     emit addingEntity(entity->getEntityItemID());
 
@@ -235,44 +238,10 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
         recurseTreeWithOperator(&theOperator);
         entity->setProperties(properties);
 
-        // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
-        QQueue<SpatiallyNestablePointer> toProcess;
-        foreach (SpatiallyNestablePointer child, entity->getChildren()) {
-            if (child && child->getNestableType() == NestableType::Entity) {
-                toProcess.enqueue(child);
-            }
-        }
-
-        while (!toProcess.empty()) {
-            EntityItemPointer childEntity = std::static_pointer_cast<EntityItem>(toProcess.dequeue());
-            if (!childEntity) {
-                continue;
-            }
-            EntityTreeElementPointer containingElement = childEntity->getElement();
-            if (!containingElement) {
-                continue;
-            }
-
-            bool success;
-            AACube queryCube = childEntity->getQueryAACube(success);
-            if (!success) {
-                _missingParent.append(childEntity);
-                continue;
-            }
-            if (!childEntity->isParentIDValid()) {
-                _missingParent.append(childEntity);
-            }
-
-            UpdateEntityOperator theChildOperator(getThisPointer(), containingElement, childEntity, queryCube);
-            recurseTreeWithOperator(&theChildOperator);
-            foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
-                if (childChild && childChild->getNestableType() == NestableType::Entity) {
-                    toProcess.enqueue(childChild);
-                }
-            }
-        }
+        updateChildEntityElements(entity);
 
         _isDirty = true;
+        trackJournaledChange(entity->getEntityItemID());
 
         uint32_t newFlags = entity->getDirtyFlags() & ~preFlags;
         if (newFlags) {
@@ -306,6 +275,45 @@ bool EntityTree::updateEntityWithElement(EntityItemPointer entity, const EntityI
     return true;
 }
 
+void EntityTree::updateChildEntityElements(EntityItemPointer entity) {
+    // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
+    QQueue<SpatiallyNestablePointer> toProcess;
+    foreach (SpatiallyNestablePointer child, entity->getChildren()) {
+        if (child && child->getNestableType() == NestableType::Entity) {
+            toProcess.enqueue(child);
+        }
+    }
+
+    while (!toProcess.empty()) {
+        EntityItemPointer childEntity = std::static_pointer_cast<EntityItem>(toProcess.dequeue());
+        if (!childEntity) {
+            continue;
+        }
+        EntityTreeElementPointer containingElement = childEntity->getElement();
+        if (!containingElement) {
+            continue;
+        }
+
+        bool success;
+        AACube queryCube = childEntity->getQueryAACube(success);
+        if (!success) {
+            _missingParent.append(childEntity);
+            continue;
+        }
+        if (!childEntity->isParentIDValid()) {
+            _missingParent.append(childEntity);
+        }
+
+        UpdateEntityOperator theChildOperator(getThisPointer(), containingElement, childEntity, queryCube);
+        recurseTreeWithOperator(&theChildOperator);
+        foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
+            if (childChild && childChild->getNestableType() == NestableType::Entity) {
+                toProcess.enqueue(childChild);
+            }
+        }
+    }
+}
+
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties) {
     EntityItemPointer result = NULL;
 
@@ -475,6 +483,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker locker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            trackJournaledChange(theEntity->getEntityItemID());
         } else {
             // on the client side, we also remember that we deleted this entity, we don't care about the time
             trackDeletedEntity(theEntity->getEntityItemID());
@@ -848,120 +857,145 @@ void EntityTree::fixupTerseEditLogging(EntityItemProperties& properties, QList<Q
 
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                      const SharedNodePointer& senderNode) {
+    int processedBytes = 0;
+    OctreeEditPointer edit = decodeEditPacketData(message, editData, maxLength, senderNode, processedBytes);
+    if (edit) {
+        applyEdit(*edit);
+    }
+    return processedBytes;
+}
 
+OctreeEditPointer EntityTree::decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& senderNode, int& bytesRead) {
+    bytesRead = 0;
     if (!getIsServer()) {
-        qCDebug(entities) << "UNEXPECTED!!! processEditPacketData() should only be called on a server tree.";
-        return 0;
+        qCDebug(entities) << "UNEXPECTED!!! decodeEditPacketData() should only be called on a server tree.";
+        return OctreeEditPointer();
     }
 
-    int processedBytes = 0;
+    std::unique_ptr<EntityEdit> edit { new EntityEdit() };
+    edit->type = message.getType();
+    edit->senderNode = senderNode;
+
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
             QByteArray dataByteArray = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-            processedBytes = processEraseMessageDetails(dataByteArray, senderNode);
+            bytesRead = decodeEraseMessageDetails(dataByteArray, senderNode, edit->entityItemIDsToDelete);
+            if (edit->entityItemIDsToDelete.isEmpty()) {
+                return OctreeEditPointer();
+            }
             break;
         }
 
         case PacketType::EntityAdd:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
             _totalEditMessages++;
 
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-           
-            bool validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes,
-                                                                                entityItemID, properties);
-            endDecode = usecTimestampNow();
-
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (existingEntity && message.getType() == PacketType::EntityEdit) {
-                    // if the EntityItem exists, then update it
-                    startLogging = usecTimestampNow();
-                    if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
-                        qCDebug(entities) << "   properties:" << properties;
-                    }
-                    if (wantTerseEditLogging()) {
-                        QList<QString> changedProperties = properties.listChangedProperties();
-                        fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
-                    }
-                    endLogging = usecTimestampNow();
-
-                    startUpdate = usecTimestampNow();
-                    updateEntity(entityItemID, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (message.getType() == PacketType::EntityAdd) {
-                    if (senderNode->getCanRez()) {
-                        // this is a new entity... assign a new entityID
-                        properties.setCreated(properties.getLastEdited());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
+            quint64 startDecode = usecTimestampNow();
+            bool validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, bytesRead,
+                                                                                edit->entityItemID, edit->properties);
+            _totalDecodeTime += usecTimestampNow() - startDecode;
 
-                        }
-                    } else {
-                        qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
-                                          << "] attempted to add an entity.";
-                    }
-                } else {
-                    static QString repeatedMessage =
-                        LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
-                    qCDebug(entities) << "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get();
-                }
+            if (!validEditPacket) {
+                return OctreeEditPointer();
             }
 
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-
+            if (message.getType() == PacketType::EntityAdd && !senderNode->getCanRez()) {
+                qCDebug(entities) << "User without 'rez rights' [" << senderNode->getUUID()
+                                  << "] attempted to add an entity.";
+                return OctreeEditPointer();
+            }
             break;
         }
 
         default:
-            processedBytes = 0;
-            break;
+            return OctreeEditPointer();
     }
-    return processedBytes;
+
+    return std::move(edit);
+}
+
+void EntityTree::applyEdit(OctreeEdit& octreeEdit) {
+    EntityEdit& edit = static_cast<EntityEdit&>(octreeEdit);
+    const SharedNodePointer& senderNode = edit.senderNode;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    EntityItemProperties& properties = edit.properties;
+
+    if (edit.type == PacketType::EntityErase) {
+        deleteEntities(edit.entityItemIDsToDelete, true, true);
+        return;
+    }
+
+    quint64 startLookup = 0, endLookup = 0;
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    // We got a valid edit packet, it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+
+    // search for the entity by EntityItemID
+    startLookup = usecTimestampNow();
+    EntityItemPointer existingEntity = findEntityByEntityItemID(entityItemID);
+    endLookup = usecTimestampNow();
+    if (existingEntity && edit.type == PacketType::EntityEdit) {
+        // if the EntityItem exists, then update it
+        startLogging = usecTimestampNow();
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+            qCDebug(entities) << "   properties:" << properties;
+        }
+        if (wantTerseEditLogging()) {
+            QList<QString> changedProperties = properties.listChangedProperties();
+            fixupTerseEditLogging(properties, changedProperties);
+            qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                existingEntity->getDebugName() << changedProperties;
+        }
+        endLogging = usecTimestampNow();
+
+        startUpdate = usecTimestampNow();
+        updateEntity(entityItemID, properties, senderNode);
+        existingEntity->markAsChangedOnServer();
+        endUpdate = usecTimestampNow();
+        _totalUpdates++;
+    } else if (edit.type == PacketType::EntityAdd) {
+        // this is a new entity... assign a new entityID
+        properties.setCreated(properties.getLastEdited());
+        startCreate = usecTimestampNow();
+        EntityItemPointer newEntity = addEntity(entityItemID, properties);
+        endCreate = usecTimestampNow();
+        _totalCreates++;
+        if (newEntity) {
+            newEntity->markAsChangedOnServer();
+            notifyNewlyCreatedEntity(*newEntity, senderNode);
+
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                << newEntity->getEntityItemID();
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+        }
+    } else {
+        static QString repeatedMessage =
+            LogHandler::getInstance().addRepeatedMessageRegex("^Edit failed.*");
+        qCDebug(entities) << "Edit failed. [" << edit.type <<"] " <<
+                "entity id:" << entityItemID <<
+                "existingEntity pointer:" << existingEntity.get();
+    }
+
+    _totalLookupTime += endLookup - startLookup;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
 }
 
 
@@ -1003,6 +1037,7 @@ void EntityTree::entityChanged(EntityItemPointer entity) {
     if (_simulation) {
         _simulation->changeEntity(entity);
     }
+    trackJournaledChange(entity->getEntityItemID());
 }
 
 void EntityTree::fixupMissingParents() {
@@ -1184,8 +1219,18 @@ int EntityTree::processEraseMessage(ReceivedMessage& message, const SharedNodePo
 // NOTE: Caller must lock the tree before calling this.
 // TODO: consider consolidating processEraseMessageDetails() and processEraseMessage()
 int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, const SharedNodePointer& sourceNode) {
+    QSet<EntityItemID> entityItemIDsToDelete;
+    int processedBytes = decodeEraseMessageDetails(dataByteArray, sourceNode, entityItemIDsToDelete);
+    if (!entityItemIDsToDelete.isEmpty()) {
+        deleteEntities(entityItemIDsToDelete, true, true);
+    }
+    return processedBytes;
+}
+
+int EntityTree::decodeEraseMessageDetails(const QByteArray& dataByteArray, const SharedNodePointer& sourceNode,
+                                          QSet<EntityItemID>& entityItemIDsToDelete) {
     #ifdef EXTRA_ERASE_DEBUGGING
-        qDebug() << "EntityTree::processEraseMessageDetails()";
+        qDebug() << "EntityTree::decodeEraseMessageDetails()";
     #endif
     const unsigned char* packetData = (const unsigned char*)dataByteArray.constData();
     const unsigned char* dataAt = packetData;
@@ -1198,13 +1243,11 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
     processedBytes += sizeof(numberOfIds);
 
     if (numberOfIds > 0) {
-        QSet<EntityItemID> entityItemIDsToDelete;
-
         for (size_t i = 0; i < numberOfIds; i++) {
 
 
             if (processedBytes + NUM_BYTES_RFC4122_UUID > packetLength) {
-                qCDebug(entities) << "EntityTree::processEraseMessageDetails().... bailing because not enough bytes in buffer";
+                qCDebug(entities) << "EntityTree::decodeEraseMessageDetails().... bailing because not enough bytes in buffer";
                 break; // bail to prevent buffer overflow
             }
 
@@ -1214,7 +1257,7 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
             processedBytes += encodedID.size();
 
             #ifdef EXTRA_ERASE_DEBUGGING
-                qDebug() << "    ---- EntityTree::processEraseMessageDetails() contains id:" << entityID;
+                qDebug() << "    ---- EntityTree::decodeEraseMessageDetails() contains id:" << entityID;
             #endif
 
             EntityItemID entityItemID(entityID);
@@ -1225,7 +1268,6 @@ int EntityTree::processEraseMessageDetails(const QByteArray& dataByteArray, cons
             }
 
         }
-        deleteEntities(entityItemIDsToDelete, true, true);
     }
     return (int)processedBytes;
 }
@@ -1412,6 +1454,356 @@ bool EntityTree::readFromMap(QVariantMap& map) {
     return true;
 }
 
+void EntityTree::setJournalChanges(bool journalChanges) {
+    QMutexLocker locker(&_journaledChangesLock);
+    _journalChanges = journalChanges;
+    _journaledChangeIDs.clear();
+}
+
+void EntityTree::trackJournaledChange(const EntityItemID& entityID) {
+    QMutexLocker locker(&_journaledChangesLock);
+    if (_journalChanges) {
+        _journaledChangeIDs.insert(entityID);
+    }
+}
+
+QByteArray EntityTree::writeEntityProperties(const EntityItemProperties& properties, QScriptEngine& scriptEngine) {
+    // every property is written, so restoring them over an older copy of the entity brings it back exactly
+    QVariantMap entityMap = EntityItemPropertiesToScriptValue(&scriptEngine, properties).toVariant().toMap();
+
+    QByteArray entityData;
+    QDataStream entityStream(&entityData, QIODevice::WriteOnly);
+    entityStream << entityMap;
+    return entityData;
+}
+
+void EntityTree::restoreEntityProperties(const EntityItemID& entityID, const QByteArray& entityData,
+                                         QScriptEngine& scriptEngine) {
+    QVariantMap entityMap;
+    QDataStream entityStream(entityData);
+    entityStream >> entityMap;
+
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemProperties properties;
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    EntityItemPointer entity = findEntityByEntityItemID(entityID);
+    if (entity) {
+        // the properties already went through the edit rules (locks, simulation ownership) before they were written,
+        // so they are applied as they are
+        UpdateEntityOperator theOperator(getThisPointer(), getContainingElement(entityID), entity,
+                                         properties.getQueryAACube());
+        recurseTreeWithOperator(&theOperator);
+        entity->setProperties(properties);
+        updateChildEntityElements(entity);
+        _isDirty = true;
+    } else if (!addEntity(entityID, properties)) {
+        qCDebug(entities) << "restoring Entity failed:" << entityID << properties.getType();
+    }
+}
+
+int EntityTree::writeJournalRecords(OctreeJournal& journal) {
+    QSet<EntityItemID> changedEntityIDs;
+    {
+        QMutexLocker locker(&_journaledChangesLock);
+        changedEntityIDs.swap(_journaledChangeIDs);
+    }
+
+    // repeated edits to an entity since the last write collapse into one record of its current properties
+    QScriptEngine scriptEngine;
+    foreach (const EntityItemID& entityID, changedEntityIDs) {
+        EntityItemPointer entity = findEntityByEntityItemID(entityID);
+        if (entity) {
+            journal.append(OctreeJournal::UpsertRecord, entityID, writeEntityProperties(entity->getProperties(), scriptEngine));
+        } else {
+            journal.append(OctreeJournal::EraseRecord, entityID);
+        }
+    }
+    return changedEntityIDs.size();
+}
+
+int EntityTree::replayJournal(OctreeJournal& journal) {
+    // only the last record for each entity matters, since every record holds the complete state of its entity
+    QHash<QUuid, OctreeJournal::Record> latestRecords;
+    QVector<QUuid> entityOrder;
+    int numRecords = journal.replay([&](const OctreeJournal::Record& record) {
+        if (!latestRecords.contains(record.id)) {
+            entityOrder << record.id;
+        }
+        latestRecords[record.id] = record;
+    });
+
+    QScriptEngine scriptEngine;
+    foreach (const QUuid& id, entityOrder) {
+        const OctreeJournal::Record& record = latestRecords[id];
+        if (record.type == OctreeJournal::EraseRecord) {
+            deleteEntity(EntityItemID(id), true, true);
+        } else {
+            restoreEntityProperties(EntityItemID(id), record.data, scriptEngine);
+        }
+    }
+
+    qCDebug(entities) << "Replayed" << numRecords << "journal records for" << entityOrder.size() << "entities from"
+        << journal.getFilename();
+    return numRecords;
+}
+
+// the binary persist format is a sequence of chunks, each a chunk type, a quint32 size and that many bytes
+enum BinaryPersistChunkType : quint8 {
+    END_OF_ENTITIES_CHUNK = 0,
+    ENTITY_DATA_CHUNK = 1 // an entity bitstream as sent to clients, or larger for properties that can't fit in a packet
+};
+
+static void writeBinaryChunk(QDataStream& outputStream, BinaryPersistChunkType chunkType, const char* data, int size) {
+    outputStream << (quint8)chunkType << (quint32)size;
+    outputStream.writeRawData(data, size);
+}
+
+class WriteToBinaryStreamArgs {
+public:
+    WriteToBinaryStreamArgs() { oversizedPacketData.changeOversizedTargetSize(MAX_OCTREE_OVERSIZED_DATA_SIZE); }
+
+    QDataStream* outputStream;
+    OctreePacketData packetData;
+    OctreePacketData oversizedPacketData; // for properties too large to ever fit in a packet
+    EncodeBitstreamParams params;
+    int entitiesWritten { 0 };
+};
+
+void EntityTree::writeEntityToBinaryStream(EntityItemPointer entityItem, WriteToBinaryStreamArgs& args) {
+    // entities are written one packet's worth of their bitstream at a time, so large ones take several chunks
+    EntityTreeElementExtraEncodeData encodeData;
+    OctreeElement::AppendState appendState;
+    do {
+        OctreePacketData* packetData = &args.packetData;
+        packetData->reset();
+        appendState = entityItem->appendEntityData(packetData, args.params, &encodeData);
+
+        if (appendState == OctreeElement::NONE) {
+            // the next property is too large to ever fit in a packet, give it a chunk larger than a packet
+            packetData = &args.oversizedPacketData;
+            packetData->reset();
+            appendState = entityItem->appendEntityData(packetData, args.params, &encodeData);
+            if (appendState == OctreeElement::NONE) {
+                qCWarning(entities) << "Entity" << entityItem->getEntityItemID()
+                    << "has a property too large for the binary format, some of its properties were not written";
+                return;
+            }
+        }
+
+        writeBinaryChunk(*args.outputStream, ENTITY_DATA_CHUNK,
+                         reinterpret_cast<const char*>(packetData->getUncompressedData()),
+                         packetData->getUncompressedSize());
+    } while (appendState == OctreeElement::PARTIAL);
+
+    args.entitiesWritten++;
+}
+
+bool EntityTree::writeToBinaryStreamOperation(OctreeElementPointer element, void* extraData) {
+    WriteToBinaryStreamArgs* args = static_cast<WriteToBinaryStreamArgs*>(extraData);
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+
+    entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
+        if (!entityItem->isParentIDValid()) {
+            return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+        }
+        writeEntityToBinaryStream(entityItem, *args);
+    });
+    return true;
+}
+
+bool EntityTree::writeToBinaryStream(QDataStream& outputStream, OctreeElementPointer element) {
+    WriteToBinaryStreamArgs args;
+    args.outputStream = &outputStream;
+
+    recurseElementWithOperation(element, writeToBinaryStreamOperation, &args);
+
+    // marks the end of the file, so we can tell a complete file from one that was cut short
+    outputStream << (quint8)END_OF_ENTITIES_CHUNK;
+
+    qCDebug(entities) << "Wrote" << args.entitiesWritten << "entities to binary stream";
+    return outputStream.status() == QDataStream::Ok;
+}
+
+bool EntityTree::readFromBinaryStream(QDataStream& inputStream, PacketVersion bitstreamVersion) {
+    ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, NULL, QUuid(), SharedNodePointer(), false, bitstreamVersion);
+
+    QByteArray chunk;
+    int entitiesRead = 0;
+
+    while (true) {
+        quint8 chunkType = END_OF_ENTITIES_CHUNK;
+        quint32 chunkSize = 0;
+
+        inputStream >> chunkType;
+        if (chunkType != END_OF_ENTITIES_CHUNK) {
+            inputStream >> chunkSize;
+        }
+        if (inputStream.status() != QDataStream::Ok) {
+            break;
+        }
+        if (chunkType == END_OF_ENTITIES_CHUNK) {
+            qCDebug(entities) << "Read" << entitiesRead << "entities from binary stream";
+            return true;
+        }
+
+        // the chunk buffer is reused, so reading never holds more than one entity's worth of data
+        chunk.resize(chunkSize);
+        if (inputStream.readRawData(chunk.data(), chunkSize) != (int)chunkSize) {
+            break;
+        }
+        const unsigned char* data = reinterpret_cast<const unsigned char*>(chunk.constData());
+
+        if (chunkType == ENTITY_DATA_CHUNK) {
+            EntityItemID entityItemID = EntityItemID::readEntityItemIDFromBuffer(data, chunkSize);
+            EntityItemPointer entity = findEntityByEntityItemID(entityItemID);
+
+            if (entity) {
+                // the rest of the properties of an entity that took more than one chunk
+                entity->readEntityDataFromBuffer(data, chunkSize, args);
+            } else {
+                entity = EntityTypes::constructEntityItem(data, chunkSize, args);
+                if (!entity) {
+                    qCDebug(entities) << "reading Entity from binary stream failed:" << entityItemID;
+                    continue;
+                }
+                entity->readEntityDataFromBuffer(data, chunkSize, args);
+
+                AddEntityOperator theOperator(getThisPointer(), entity);
+                recurseTreeWithOperator(&theOperator);
+                if (entity->getAncestorMissing()) {
+                    _missingParent.append(entity);
+                }
+                postAddEntity(entity);
+                entitiesRead++;
+            }
+        } else {
+            qCDebug(entities) << "skipping unknown binary chunk type" << chunkType;
+        }
+    }
+
+    qCWarning(entities) << "Binary stream ended early, read" << entitiesRead << "entities";
+    return false;
+}
+
+// changes to an entity always move at least one of these forward, so the entity is unchanged while they stay put
+static quint64 getSnapshotVersion(EntityItemPointer entity) {
+    return glm::max(entity->getLastChangedOnServer(), glm::max(entity->getLastSimulated(), entity->getLastUpdated()));
+}
+
+class TakeSnapshotArgs {
+public:
+    EntityTreeSnapshot* snapshot;
+    const QHash<EntityItemID, EntityTree::SnapshotBlock>* oldBlocks;
+    QHash<EntityItemID, EntityTree::SnapshotBlock>* newBlocks;
+    int blocksCopied { 0 };
+};
+
+bool EntityTree::takeSnapshotOperation(OctreeElementPointer element, void* extraData) {
+    TakeSnapshotArgs* args = static_cast<TakeSnapshotArgs*>(extraData);
+    EntityTreeElementPointer entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+
+    entityTreeElement->forEachEntity([&](EntityItemPointer entityItem) {
+        if (!entityItem->isParentIDValid()) {
+            return;  // we weren't able to resolve a parent from _parentID, so don't save this entity.
+        }
+
+        EntityItemID entityID = entityItem->getEntityItemID();
+        quint64 version = getSnapshotVersion(entityItem);
+
+        SnapshotBlock block = args->oldBlocks->value(entityID);
+        if (!block.properties || block.version != version) {
+            block.version = version;
+            block.properties = std::make_shared<const EntityItemProperties>(entityItem->getProperties());
+            args->blocksCopied++;
+        }
+
+        args->newBlocks->insert(entityID, block);
+        args->snapshot->_entities.push_back({ entityID, block.properties });
+    });
+    return true;
+}
+
+OctreeSnapshotPointer EntityTree::takeSnapshot() {
+    auto snapshot = std::make_shared<EntityTreeSnapshot>();
+
+    // only one snapshot is taken at a time, each one starts from the blocks of the one before it
+    QMutexLocker locker(&_snapshotBlocksLock);
+
+    QHash<EntityItemID, SnapshotBlock> newBlocks;
+    newBlocks.reserve(_snapshotBlocks.size());
+
+    TakeSnapshotArgs args;
+    args.snapshot = snapshot.get();
+    args.oldBlocks = &_snapshotBlocks;
+    args.newBlocks = &newBlocks;
+
+    recurseTreeWithOperation(takeSnapshotOperation, &args);
+
+    // blocks of entities that are gone are dropped along with the old map
+    _snapshotBlocks.swap(newBlocks);
+
+    qCDebug(entities) << "Took snapshot of" << snapshot->getNumItems() << "entities," << args.blocksCopied
+        << "of them changed since the last snapshot";
+    return snapshot;
+}
+
+bool EntityTreeSnapshot::writeToMap(QVariantMap& entityDescription, bool skipDefaultValues) {
+    QVariantList entitiesQList = entityDescription["Entities"].toList();
+    entitiesQList.reserve(entitiesQList.size() + _entities.size());
+
+    QScriptEngine scriptEngine;
+    foreach (const Entity& entity, _entities) {
+        QScriptValue qScriptValues;
+        if (skipDefaultValues) {
+            qScriptValues = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, *entity.properties);
+        } else {
+            qScriptValues = EntityItemPropertiesToScriptValue(&scriptEngine, *entity.properties);
+        }
+        entitiesQList << qScriptValues.toVariant();
+    }
+
+    entityDescription["Entities"] = entitiesQList;
+    return true;
+}
+
+bool EntityTreeSnapshot::writeToBinaryStream(QDataStream& outputStream) {
+    WriteToBinaryStreamArgs args;
+    args.outputStream = &outputStream;
+
+    foreach (const Entity& entity, _entities) {
+        // the bitstream encoders work on entities, so each block is loaded into a detached entity to be written.
+        // Setting the properties of an entity looks up its parent and registers the entity as one of its children,
+        // which would reach into the live tree without its lock - so the copy is built without its parent, and the
+        // parent ID is put back afterwards, which doesn't look the parent up.
+        const EntityItemProperties* properties = entity.properties.get();
+        EntityItemProperties parentlessProperties;
+        QUuid parentID = properties->getParentID();
+        if (!parentID.isNull()) {
+            parentlessProperties = *properties;
+            parentlessProperties.setParentID(QUuid());
+            properties = &parentlessProperties;
+        }
+
+        EntityItemPointer entityItem = EntityTypes::constructEntityItem(properties->getType(), entity.id, *properties);
+        if (!entityItem) {
+            qCDebug(entities) << "writing Entity from snapshot failed:" << entity.id << properties->getType();
+            continue;
+        }
+        entityItem->setParentID(parentID);
+        // without its parent the copy took its local position as a world position when adjusting its query cube
+        entityItem->setQueryAACube(entity.properties->getQueryAACube());
+        entityItem->setLastEdited(entity.properties->getLastEdited());
+        EntityTree::writeEntityToBinaryStream(entityItem, args);
+    }
+
+    // marks the end of the file, so we can tell a complete file from one that was cut short
+    outputStream << (quint8)END_OF_ENTITIES_CHUNK;
+
+    qCDebug(entities) << "Wrote" << args.entitiesWritten << "entities from snapshot to binary stream";
+    return outputStream.status() == QDataStream::Ok;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
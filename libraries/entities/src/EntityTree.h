@@ -12,6 +12,9 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <vector>
+
+#include <QMutex>
 #include <QSet>
 #include <QVector>
 
@@ -25,11 +28,22 @@ typedef std::shared_ptr<EntityTree> EntityTreePointer;
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 
+/// An EntityAdd, EntityEdit or EntityErase record decoded by EntityTree::decodeEditPacketData()
+class EntityEdit : public OctreeEdit {
+public:
+    PacketType type { PacketType::Unknown };
+    SharedNodePointer senderNode;
+    EntityItemID entityItemID;
+    EntityItemProperties properties;
+    QSet<EntityItemID> entityItemIDsToDelete; // only for EntityErase
+};
+
 class Model;
 using ModelPointer = std::shared_ptr<Model>;
 using ModelWeakPointer = std::weak_ptr<Model>;
 
 class EntitySimulation;
+class QScriptEngine;
 
 class NewlyCreatedEntityHook {
 public:
@@ -44,6 +58,29 @@ public:
 };
 
 
+/// A snapshot of the entities in an EntityTree, each held as an immutable block of its properties. A block is shared by
+/// every snapshot taken while its entity is unchanged, so taking a snapshot only copies the entities that changed.
+class EntityTreeSnapshot : public OctreeSnapshot {
+public:
+    using PropertiesPointer = std::shared_ptr<const EntityItemProperties>;
+
+    struct Entity {
+        EntityItemID id;
+        PropertiesPointer properties;
+    };
+
+    virtual int getNumItems() const override { return (int)_entities.size(); }
+    virtual bool writeToMap(QVariantMap& entityDescription, bool skipDefaultValues) override;
+    virtual bool writeToBinaryStream(QDataStream& outputStream) override;
+
+private:
+    std::vector<Entity> _entities;
+
+    friend class EntityTree;
+};
+
+class WriteToBinaryStreamArgs;
+
 class SendEntitiesOperationArgs {
 public:
     glm::vec3 root;
@@ -85,6 +122,9 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual OctreeEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& senderNode, int& bytesRead) override;
+    virtual void applyEdit(OctreeEdit& edit) override;
 
     virtual bool findRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         OctreeElementPointer& node, float& distance, BoxFace& face, glm::vec3& surfaceNormal,
@@ -171,6 +211,8 @@ public:
 
     int processEraseMessage(ReceivedMessage& message, const SharedNodePointer& sourceNode);
     int processEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode);
+    int decodeEraseMessageDetails(const QByteArray& buffer, const SharedNodePointer& sourceNode,
+                                  QSet<EntityItemID>& entityItemIDsToDelete);
 
     EntityItemFBXService* getFBXService() const { return _fbxService; }
     void setFBXService(EntityItemFBXService* service) { _fbxService = service; }
@@ -192,6 +234,9 @@ public:
 
     void entityChanged(EntityItemPointer entity);
 
+    // queues the entity for the next journal write, a no-op unless journaling is on
+    void trackJournaledChange(const EntityItemID& entityID);
+
     void emitEntityScriptChanging(const EntityItemID& entityItemID, const bool reload);
 
     void setSimulation(EntitySimulation* simulation);
@@ -207,6 +252,16 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription) override;
 
+    virtual bool writeToBinaryStream(QDataStream& outputStream, OctreeElementPointer element) override;
+    virtual bool readFromBinaryStream(QDataStream& inputStream, PacketVersion bitstreamVersion) override;
+
+    virtual OctreeSnapshotPointer takeSnapshot() override;
+
+    virtual bool canJournalChanges() const override { return true; }
+    virtual void setJournalChanges(bool journalChanges) override;
+    virtual int writeJournalRecords(OctreeJournal& journal) override;
+    virtual int replayJournal(OctreeJournal& journal) override;
+
     float getContentsLargestDimension();
 
     virtual void resetEditStats() override {
@@ -262,6 +317,9 @@ signals:
 protected:
 
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
+    void updateChildEntityElements(EntityItemPointer entity);
+    static QByteArray writeEntityProperties(const EntityItemProperties& properties, QScriptEngine& scriptEngine);
+    void restoreEntityProperties(const EntityItemID& entityID, const QByteArray& entityData, QScriptEngine& scriptEngine);
     bool updateEntityWithElement(EntityItemPointer entity, const EntityItemProperties& properties,
                                  EntityTreeElementPointer containingElement,
                                  const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
@@ -270,6 +328,9 @@ protected:
     static bool findInCubeOperation(OctreeElementPointer element, void* extraData);
     static bool findInBoxOperation(OctreeElementPointer element, void* extraData);
     static bool sendEntitiesOperation(OctreeElementPointer element, void* extraData);
+    static bool writeToBinaryStreamOperation(OctreeElementPointer element, void* extraData);
+    static void writeEntityToBinaryStream(EntityItemPointer entityItem, WriteToBinaryStreamArgs& args);
+    static bool takeSnapshotOperation(OctreeElementPointer element, void* extraData);
 
     void notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode);
 
@@ -282,6 +343,20 @@ protected:
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
 
+    QMutex _journaledChangesLock; /// lock of server side changes not yet written to the journal
+    bool _journalChanges { false };
+    QSet<EntityItemID> _journaledChangeIDs; /// server side changes not yet written to the journal
+
+    struct SnapshotBlock {
+        quint64 version { 0 };
+        EntityTreeSnapshot::PropertiesPointer properties;
+    };
+    QMutex _snapshotBlocksLock;
+    QHash<EntityItemID, SnapshotBlock> _snapshotBlocks; /// property blocks of the last snapshot, by entity
+
+    friend class EntityTreeSnapshot;
+    friend class TakeSnapshotArgs;
+
     void clearDeletedEntities() {
         QWriteLocker locker(&_deletedEntitiesLock);
         _deletedEntityItemIDs.clear();
@@ -83,9 +83,11 @@ void EntityTreeElement::initializeExtraEncodeData(EncodeBitstreamParams& params)
                 }
             }
         }
+        entityTreeElementExtraEncodeData->entities.reserve(_entityItems.size());
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            entityTreeElementExtraEncodeData->entities.addDistinct(entity->getEntityItemID());
         });
+        entityTreeElementExtraEncodeData->entities.sortAdded();
 
         // TODO: some of these inserts might be redundant!!!
         extraEncodeData->insert(this, entityTreeElementExtraEncodeData);
@@ -262,9 +264,11 @@ OctreeElement::AppendState EntityTreeElement::appendElementData(OctreePacketData
                 }
             }
         }
+        entityTreeElementExtraEncodeData->entities.reserve(_entityItems.size());
         forEachEntity([&](EntityItemPointer entity) {
-            entityTreeElementExtraEncodeData->entities.insert(entity->getEntityItemID(), entity->getEntityProperties(params));
+            entityTreeElementExtraEncodeData->entities.addDistinct(entity->getEntityItemID());
         });
+        entityTreeElementExtraEncodeData->entities.sortAdded();
     }
 
     //assert(extraEncodeData);
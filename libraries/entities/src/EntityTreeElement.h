@@ -12,7 +12,9 @@
 #ifndef hifi_EntityTreeElement_h
 #define hifi_EntityTreeElement_h
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include <OctreeElement.h>
 #include <QList>
@@ -41,6 +43,91 @@ public:
     int _movingItems;
 };
 
+// The entities of an element that are still to be sent to a viewer in the current scene pass. This is kept for every
+// viewer and every element, so it is a single flat array per element sorted by entity ID, and an entity that hasn't been
+// sent yet is only its ID. Its remaining properties are only recorded once part of it has been sent. Sent entities are
+// only flagged as removed, so that nothing has to be moved while the element is being encoded.
+class EntityTreeElementPendingEntities {
+public:
+    void reserve(int numEntities) { _pending.reserve(numEntities); }
+    int size() const { return _numPending; }
+
+    // adds an entity that can't be pending already, such as one of the element's own entities, without looking for it.
+    // sortAdded() must be called once they have all been added, before the entities are looked up.
+    void addDistinct(const EntityItemID& entityID) {
+        _pending.push_back({ entityID, false, false, EntityPropertyFlags() });
+        _numPending++;
+    }
+    void sortAdded() {
+        std::sort(_pending.begin(), _pending.end(),
+            [](const PendingEntity& a, const PendingEntity& b) { return a.entityID < b.entityID; });
+    }
+
+    // the entity still needs all of its properties sent
+    void insert(const EntityItemID& entityID) { insert(entityID, EntityPropertyFlags(), false); }
+
+    // the entity still needs the given properties sent
+    void insert(const EntityItemID& entityID, const EntityPropertyFlags& remainingProperties) {
+        insert(entityID, remainingProperties, true);
+    }
+
+    bool contains(const EntityItemID& entityID) const { return find(entityID) != _pending.end(); }
+
+    // the properties still to be sent, or null if that is all of them (or if the entity isn't pending)
+    const EntityPropertyFlags* getRemainingProperties(const EntityItemID& entityID) const {
+        auto entry = find(entityID);
+        return (entry != _pending.end() && entry->partiallySent) ? &entry->remainingProperties : nullptr;
+    }
+
+    void remove(const EntityItemID& entityID) {
+        auto entry = find(entityID);
+        if (entry != _pending.end()) {
+            entry->removed = true;
+            _numPending--;
+        }
+    }
+
+private:
+    struct PendingEntity {
+        EntityItemID entityID;
+        bool partiallySent;
+        bool removed;
+        EntityPropertyFlags remainingProperties;
+    };
+
+    // the entry for the entity whether or not it was removed, or where it would go
+    std::vector<PendingEntity>::iterator lowerBound(const EntityItemID& entityID) {
+        return std::lower_bound(_pending.begin(), _pending.end(), entityID,
+            [](const PendingEntity& entry, const EntityItemID& id) { return entry.entityID < id; });
+    }
+
+    std::vector<PendingEntity>::iterator find(const EntityItemID& entityID) {
+        auto entry = lowerBound(entityID);
+        return (entry != _pending.end() && entry->entityID == entityID && !entry->removed) ? entry : _pending.end();
+    }
+    std::vector<PendingEntity>::const_iterator find(const EntityItemID& entityID) const {
+        return const_cast<EntityTreeElementPendingEntities*>(this)->find(entityID);
+    }
+
+    void insert(const EntityItemID& entityID, const EntityPropertyFlags& remainingProperties, bool partiallySent) {
+        auto entry = lowerBound(entityID);
+        if (entry != _pending.end() && entry->entityID == entityID) {
+            if (entry->removed) {
+                entry->removed = false;
+                _numPending++;
+            }
+            entry->remainingProperties = remainingProperties;
+            entry->partiallySent = partiallySent;
+        } else {
+            _pending.insert(entry, { entityID, partiallySent, false, remainingProperties });
+            _numPending++;
+        }
+    }
+
+    std::vector<PendingEntity> _pending;
+    int _numPending { 0 };
+};
+
 class EntityTreeElementExtraEncodeData {
 public:
     EntityTreeElementExtraEncodeData() :
@@ -52,7 +139,7 @@ public:
     bool elementCompleted;
     bool subtreeCompleted;
     bool childCompleted[NUMBER_OF_CHILDREN];
-    QMap<EntityItemID, EntityPropertyFlags> entities;
+    EntityTreeElementPendingEntities entities;
 };
 
 inline QDebug operator<<(QDebug debug, const EntityTreeElementExtraEncodeData* data) {
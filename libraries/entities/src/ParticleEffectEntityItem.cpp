@@ -552,7 +552,7 @@ void ParticleEffectEntityItem::appendSubclassData(OctreePacketData* packetData,
 
 bool ParticleEffectEntityItem::isEmittingParticles() const {
     // keep emitting if there are particles still alive.
-    return (getIsEmitting() || !_particles.empty());
+    return (getIsEmitting() || !_particles.isEmpty());
 }
 
 bool ParticleEffectEntityItem::needsToCallUpdate() const {
@@ -601,42 +601,23 @@ void ParticleEffectEntityItem::integrateParticle(Particle& particle, float delta
 }
 
 void ParticleEffectEntityItem::stepSimulation(float deltaTime) {
-    // update particles between head and tail
-    int popCount = 0;
-    for (Particle& particle : _particles) {
-        particle.lifetime += deltaTime;
-
-        // if particle has died.
-        if (particle.lifetime >= _lifespan) {
-            // move head forward
-            popCount++;
-        } else {
-            // Otherwise update it
-            integrateParticle(particle, deltaTime);
-        }
-    }
-    _particles.erase(_particles.begin(), _particles.begin() + popCount);
+    // age all the particles, drop the ones that have died, and move the rest along
+    _particles.age(deltaTime, _lifespan);
+    _particles.integrate(deltaTime);
 
     // emit new particles, but only if we are emmitting
     if (getIsEmitting() && _emitRate > 0.0f && _lifespan > 0.0f && _polarStart <= _polarFinish) {
 
         float timeLeftInFrame = deltaTime;
         while (_timeUntilNextEmit < timeLeftInFrame) {
-            // overflow! move head forward by one.
-            // because the case of head == tail indicates an empty array, not a full one.
-            // This can drop an existing older particle, but this is by design, newer particles are a higher priority.
-            if (_particles.size() >= _maxParticles) {
-                _particles.pop_front();
-            }
-            
-            // emit a new particle at tail index.
-            _particles.push_back(createParticle(glm::mix(_previousPosition, getPosition(),
-                (deltaTime - timeLeftInFrame) / deltaTime)));
-            auto particle = _particles.back();
+            // emit a new particle, aged and moved along for the part of the frame since it was emitted.
+            // if the store is full this drops the oldest particle, but this is by design, newer particles are a
+            // higher priority.
+            auto particle = createParticle(glm::mix(_previousPosition, getPosition(),
+                (deltaTime - timeLeftInFrame) / deltaTime));
             particle.lifetime += timeLeftInFrame;
-            
-            // Initialize it
-            integrateParticle(particle, deltaTime);
+            integrateParticle(particle, timeLeftInFrame);
+            _particles.push(particle);
             
             // Advance in frame
             timeLeftInFrame -= _timeUntilNextEmit;
@@ -726,10 +707,8 @@ void ParticleEffectEntityItem::setMaxParticles(quint32 maxParticles) {
     if (_maxParticles != maxParticles && MINIMUM_MAX_PARTICLES <= maxParticles && maxParticles <= MAXIMUM_MAX_PARTICLES) {
         _maxParticles = maxParticles;
 
-        // Pop all the overflowing oldest particles
-        while (_particles.size() > _maxParticles) {
-            _particles.pop_front();
-        }
+        // drops all the overflowing oldest particles
+        _particles.setCapacity((int)_maxParticles);
 
         // effectively clear all particles and start emitting new ones from scratch.
         _timeUntilNextEmit = 0.0f;
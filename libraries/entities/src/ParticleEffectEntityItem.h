@@ -11,11 +11,10 @@
 #ifndef hifi_ParticleEffectEntityItem_h
 #define hifi_ParticleEffectEntityItem_h
 
-#include <deque>
-
 #include "EntityItem.h"
 
 #include "ColorUtils.h"
+#include "ParticleStore.h"
 
 class ParticleEffectEntityItem : public EntityItem {
 public:
@@ -222,8 +221,7 @@ public:
     virtual bool supportsDetailedRayIntersection() const { return false; }
 
 protected:
-    struct Particle;
-    using Particles = std::deque<Particle>;
+    using Particle = ParticleStore::Particle;
 
     bool isAnimatingSomething() const;
     
@@ -231,16 +229,8 @@ protected:
     void stepSimulation(float deltaTime);
     void integrateParticle(Particle& particle, float deltaTime);
     
-    struct Particle {
-        float seed { 0.0f };
-        float lifetime { 0.0f };
-        glm::vec3 position { Vectors::ZERO };
-        glm::vec3 velocity { Vectors::ZERO };
-        glm::vec3 acceleration { Vectors::ZERO };
-    };
-    
     // Particles container
-    Particles _particles;
+    ParticleStore _particles { (int)DEFAULT_MAX_PARTICLES };
     
     // Particles properties
     rgbColor _color;
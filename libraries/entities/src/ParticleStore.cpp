@@ -0,0 +1,188 @@
+//
+//  ParticleStore.cpp
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleStore.h"
+
+#include <algorithm>
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+static void addToAll(float* values, float amount, int count) {
+    __m128 a = _mm_set1_ps(amount);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        _mm_storeu_ps(&values[i], _mm_add_ps(_mm_loadu_ps(&values[i]), a));
+    }
+    for (; i < count; i++) {
+        values[i] += amount;
+    }
+}
+
+// position += velocity * t + acceleration * (t^2 / 2), velocity += acceleration * t
+static void integrateAxis(float* positions, float* velocities, const float* accelerations, float deltaTime, int count) {
+    __m128 t = _mm_set1_ps(deltaTime);
+    __m128 halfTSquared = _mm_set1_ps(0.5f * deltaTime * deltaTime);
+
+    int i = 0;
+    for (; i < count - 3; i += 4) {
+        __m128 p = _mm_loadu_ps(&positions[i]);
+        __m128 v = _mm_loadu_ps(&velocities[i]);
+        __m128 a = _mm_loadu_ps(&accelerations[i]);
+
+        p = _mm_add_ps(p, _mm_add_ps(_mm_mul_ps(v, t), _mm_mul_ps(a, halfTSquared)));
+        v = _mm_add_ps(v, _mm_mul_ps(a, t));
+
+        _mm_storeu_ps(&positions[i], p);
+        _mm_storeu_ps(&velocities[i], v);
+    }
+    for (; i < count; i++) {
+        positions[i] += velocities[i] * deltaTime + accelerations[i] * (0.5f * deltaTime * deltaTime);
+        velocities[i] += accelerations[i] * deltaTime;
+    }
+}
+
+#else   // portable reference code
+
+static void addToAll(float* values, float amount, int count) {
+    for (int i = 0; i < count; i++) {
+        values[i] += amount;
+    }
+}
+
+static void integrateAxis(float* positions, float* velocities, const float* accelerations, float deltaTime, int count) {
+    float halfTSquared = 0.5f * deltaTime * deltaTime;
+    for (int i = 0; i < count; i++) {
+        positions[i] += velocities[i] * deltaTime + accelerations[i] * halfTSquared;
+        velocities[i] += accelerations[i] * deltaTime;
+    }
+}
+
+#endif
+
+void ParticleStore::allocate() {
+    _seeds.resize(_capacity);
+    _lifetimes.resize(_capacity);
+    for (int axis = 0; axis < 3; axis++) {
+        _positions[axis].resize(_capacity);
+        _velocities[axis].resize(_capacity);
+        _accelerations[axis].resize(_capacity);
+    }
+}
+
+void ParticleStore::setCapacity(int capacity) {
+    if (capacity == _capacity) {
+        return;
+    }
+
+    if (_seeds.empty()) {
+        // nothing has been stored yet, the arrays are sized on the first push
+        _capacity = capacity;
+        return;
+    }
+
+    // unroll the newest particles that still fit into the new arrays, oldest first
+    int keep = std::min(_size, capacity);
+    int first = _head + (_size - keep);
+
+    auto unroll = [&](std::vector<float>& values) {
+        std::vector<float> unrolled(capacity);
+        for (int i = 0; i < keep; i++) {
+            unrolled[i] = values[(first + i) % _capacity];
+        }
+        values.swap(unrolled);
+    };
+
+    unroll(_seeds);
+    unroll(_lifetimes);
+    for (int axis = 0; axis < 3; axis++) {
+        unroll(_positions[axis]);
+        unroll(_velocities[axis]);
+        unroll(_accelerations[axis]);
+    }
+
+    _capacity = capacity;
+    _head = 0;
+    _size = keep;
+}
+
+void ParticleStore::push(const Particle& particle) {
+    if (_capacity <= 0) {
+        return;
+    }
+    if (_seeds.empty()) {
+        allocate();
+    }
+
+    if (_size == _capacity) {
+        // full, so the newest particle takes the place of the oldest
+        _head = (_head + 1) % _capacity;
+        _size--;
+    }
+
+    int index = (_head + _size) % _capacity;
+    _seeds[index] = particle.seed;
+    _lifetimes[index] = particle.lifetime;
+    for (int axis = 0; axis < 3; axis++) {
+        _positions[axis][index] = particle.position[axis];
+        _velocities[axis][index] = particle.velocity[axis];
+        _accelerations[axis][index] = particle.acceleration[axis];
+    }
+    _size++;
+}
+
+template <typename F>
+void ParticleStore::forEachSpan(F function) {
+    int firstCount = std::min(_size, _capacity - _head);
+    if (firstCount > 0) {
+        function(_head, firstCount);
+    }
+    if (_size > firstCount) {
+        function(0, _size - firstCount);
+    }
+}
+
+void ParticleStore::age(float deltaTime, float lifespan) {
+    forEachSpan([&](int first, int count) {
+        addToAll(&_lifetimes[first], deltaTime, count);
+    });
+
+    // particles are stored oldest first, so the ones that have died are all at the head
+    while (_size > 0 && _lifetimes[_head] >= lifespan) {
+        _head = (_head + 1) % _capacity;
+        _size--;
+    }
+}
+
+void ParticleStore::integrate(float deltaTime) {
+    forEachSpan([&](int first, int count) {
+        for (int axis = 0; axis < 3; axis++) {
+            integrateAxis(&_positions[axis][first], &_velocities[axis][first], &_accelerations[axis][first],
+                          deltaTime, count);
+        }
+    });
+}
+
+void ParticleStore::writeInstances(Instance* instances) const {
+    int index = _head;
+    for (int i = 0; i < _size; i++) {
+        Instance& instance = instances[i];
+        instance.position = glm::vec3(_positions[0][index], _positions[1][index], _positions[2][index]);
+        instance.lifetimeAndSeed = glm::vec2(_lifetimes[index], _seeds[index]);
+        if (++index == _capacity) {
+            index = 0;
+        }
+    }
+}
@@ -0,0 +1,77 @@
+//
+//  ParticleStore.h
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleStore_h
+#define hifi_ParticleStore_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <GLMHelpers.h>
+
+/// Fixed capacity ring buffer of particles, stored as one array per component so that the aging and integration passes
+/// run over contiguous floats. Particles are kept oldest first; adding to a full store drops the oldest particle.
+class ParticleStore {
+public:
+    struct Particle {
+        float seed { 0.0f };
+        float lifetime { 0.0f };
+        glm::vec3 position { Vectors::ZERO };
+        glm::vec3 velocity { Vectors::ZERO };
+        glm::vec3 acceleration { Vectors::ZERO };
+    };
+
+    /// Per instance data read by the particle shaders: position, then lifetime and seed.
+    struct Instance {
+        glm::vec3 position;
+        glm::vec2 lifetimeAndSeed;
+    };
+
+    ParticleStore(int capacity) : _capacity(capacity) { }
+
+    /// Changes the number of particles held, dropping the oldest ones that no longer fit.
+    void setCapacity(int capacity);
+    int getCapacity() const { return _capacity; }
+
+    int size() const { return _size; }
+    bool isEmpty() const { return _size == 0; }
+    void clear() { _head = 0; _size = 0; }
+
+    /// Adds a particle as the newest one, dropping the oldest if the store is full.
+    void push(const Particle& particle);
+
+    /// Ages every particle by deltaTime and drops the ones that have lived for lifespan or longer.
+    void age(float deltaTime, float lifespan);
+
+    /// Moves every particle along its velocity and acceleration for deltaTime.
+    void integrate(float deltaTime);
+
+    /// Writes one instance per particle, oldest first. instances must have room for size() of them.
+    void writeInstances(Instance* instances) const;
+
+private:
+    template <typename F>
+    void forEachSpan(F function); // calls function(first, count) for the one or two runs of particles in the ring
+
+    void allocate();
+
+    int _capacity;
+    int _head { 0 }; // index of the oldest particle
+    int _size { 0 };
+
+    std::vector<float> _seeds;
+    std::vector<float> _lifetimes;
+    std::vector<float> _positions[3];
+    std::vector<float> _velocities[3];
+    std::vector<float> _accelerations[3];
+};
+
+#endif // hifi_ParticleStore_h
@@ -0,0 +1,253 @@
+//
+//  PolyVoxChunks.cpp
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxChunks.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+#include <QDataStream>
+#include <QDebug>
+
+#include "PolyVoxEntityItem.h"
+
+enum PolyVoxChunkRecord : quint8 {
+    UNIFORM_RUN = 0,
+    COMPRESSED,
+    UNCHANGED_RUN
+};
+
+static int chunksAlong(quint16 size) {
+    return (size + PolyVoxChunks::CHUNK_SIDE - 1) / PolyVoxChunks::CHUNK_SIDE;
+}
+
+static bool isReasonableSize(quint16 xSize, quint16 ySize, quint16 zSize) {
+    return xSize > 0 && xSize <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION &&
+        ySize > 0 && ySize <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION &&
+        zSize > 0 && zSize <= PolyVoxEntityItem::MAX_VOXEL_DIMENSION;
+}
+
+PolyVoxChunks::Chunk PolyVoxChunks::compressChunk(const QByteArray& raw) {
+    assert(raw.size() == CHUNK_VOXEL_COUNT);
+    Chunk chunk;
+    chunk._value = (uint8_t)raw[0];
+
+    const char* data = raw.constData();
+    for (int i = 1; i < CHUNK_VOXEL_COUNT; i++) {
+        if (data[i] != data[0]) {
+            chunk._value = 0;
+            chunk._compressed = qCompress(raw, 9);
+            break;
+        }
+    }
+    return chunk;
+}
+
+QByteArray PolyVoxChunks::uncompressChunk(const Chunk& chunk) {
+    if (chunk.isUniform()) {
+        return QByteArray(CHUNK_VOXEL_COUNT, (char)chunk._value);
+    }
+    return qUncompress(chunk._compressed);
+}
+
+bool PolyVoxChunks::isChunked(const QByteArray& voxelData) {
+    return voxelData.size() >= 2 && ((quint8)voxelData[0] << 8 & CHUNKED_FLAG);
+}
+
+bool PolyVoxChunks::isPartial(const QByteArray& voxelData) {
+    const int FLAGS_OFFSET = 3 * sizeof(quint16);
+    return isChunked(voxelData) && voxelData.size() > FLAGS_OFFSET && ((quint8)voxelData[FLAGS_OFFSET] & PARTIAL_FLAG);
+}
+
+PolyVoxChunks::PolyVoxChunks(quint16 xSize, quint16 ySize, quint16 zSize) :
+    _xSize(xSize),
+    _ySize(ySize),
+    _zSize(zSize),
+    _xChunks(chunksAlong(xSize)),
+    _yChunks(chunksAlong(ySize)),
+    _zChunks(chunksAlong(zSize)),
+    _chunks(_xChunks * _yChunks * _zChunks)
+{
+}
+
+void PolyVoxChunks::getChunkOrigin(int index, int& x, int& y, int& z) const {
+    x = (index % _xChunks) * CHUNK_SIDE;
+    y = ((index / _xChunks) % _yChunks) * CHUNK_SIDE;
+    z = (index / (_xChunks * _yChunks)) * CHUNK_SIDE;
+}
+
+bool PolyVoxChunks::readVoxelData(const QByteArray& voxelData) {
+    if (!isChunked(voxelData)) {
+        return readLegacyVoxelData(voxelData);
+    }
+
+    QDataStream reader(voxelData);
+    quint16 xSize, ySize, zSize;
+    quint8 flags;
+    reader >> xSize >> ySize >> zSize >> flags;
+    xSize &= ~CHUNKED_FLAG;
+
+    if (!isReasonableSize(xSize, ySize, zSize)) {
+        qDebug() << "PolyVoxChunks -- voxel data size is not reasonable" << xSize << ySize << zSize;
+        return false;
+    }
+
+    bool partial = flags & PARTIAL_FLAG;
+    if (partial && !hasSize(xSize, ySize, zSize)) {
+        qDebug() << "PolyVoxChunks -- partial voxel data of size" << xSize << ySize << zSize
+                 << "doesn't match current size" << _xSize << _ySize << _zSize;
+        return false;
+    }
+
+    PolyVoxChunks result = partial ? *this : PolyVoxChunks(xSize, ySize, zSize);
+    int chunkCount = result.getChunkCount();
+    int index = 0;
+    while (index < chunkCount && !reader.atEnd()) {
+        quint8 record;
+        reader >> record;
+        switch (record) {
+            case UNIFORM_RUN: {
+                quint8 value;
+                quint16 count;
+                reader >> value >> count;
+                if (index + count > chunkCount) {
+                    return false;
+                }
+                Chunk chunk;
+                chunk._value = value;
+                std::fill(result._chunks.begin() + index, result._chunks.begin() + index + count, chunk);
+                index += count;
+                break;
+            }
+            case COMPRESSED: {
+                quint16 size;
+                reader >> size;
+                Chunk chunk;
+                chunk._compressed.resize(size);
+                if (size == 0 || reader.readRawData(chunk._compressed.data(), size) != size) {
+                    return false;
+                }
+                if (uncompressChunk(chunk).size() != CHUNK_VOXEL_COUNT) {
+                    qDebug() << "PolyVoxChunks -- chunk" << index << "doesn't uncompress to" << CHUNK_VOXEL_COUNT << "voxels";
+                    return false;
+                }
+                result._chunks[index++] = chunk;
+                break;
+            }
+            case UNCHANGED_RUN: {
+                quint16 count;
+                reader >> count;
+                if (!partial || index + count > chunkCount) {
+                    return false;
+                }
+                index += count;
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+
+    if (index != chunkCount || reader.status() != QDataStream::Ok) {
+        qDebug() << "PolyVoxChunks -- voxel data is truncated, read" << index << "of" << chunkCount << "chunks";
+        return false;
+    }
+
+    *this = result;
+    return true;
+}
+
+bool PolyVoxChunks::readLegacyVoxelData(const QByteArray& voxelData) {
+    // a single qCompress'ed blob of the whole volume
+    QDataStream reader(voxelData);
+    quint16 xSize, ySize, zSize;
+    reader >> xSize >> ySize >> zSize;
+
+    if (!isReasonableSize(xSize, ySize, zSize)) {
+        qDebug() << "PolyVoxChunks -- voxel data size is not reasonable" << xSize << ySize << zSize;
+        return false;
+    }
+
+    QByteArray compressedData;
+    reader >> compressedData;
+    QByteArray uncompressedData = qUncompress(compressedData);
+
+    int rawSize = xSize * ySize * zSize;
+    if (uncompressedData.size() != rawSize) {
+        qDebug() << "PolyVoxChunks -- size is (" << xSize << ySize << zSize << ")"
+                 << "so expected uncompressed length of" << rawSize << "but length is" << uncompressedData.size();
+        return false;
+    }
+
+    PolyVoxChunks result(xSize, ySize, zSize);
+    QByteArray raw(CHUNK_VOXEL_COUNT, '\0');
+    for (int index = 0; index < result.getChunkCount(); index++) {
+        int originX, originY, originZ;
+        result.getChunkOrigin(index, originX, originY, originZ);
+
+        raw.fill('\0');
+        for (int z = originZ; z < std::min(originZ + CHUNK_SIDE, (int)zSize); z++) {
+            for (int y = originY; y < std::min(originY + CHUNK_SIDE, (int)ySize); y++) {
+                for (int x = originX; x < std::min(originX + CHUNK_SIDE, (int)xSize); x++) {
+                    int chunkIndex = ((z - originZ) * CHUNK_SIDE + (y - originY)) * CHUNK_SIDE + (x - originX);
+                    raw[chunkIndex] = uncompressedData[(z * ySize + y) * xSize + x];
+                }
+            }
+        }
+        result._chunks[index] = compressChunk(raw);
+    }
+
+    *this = result;
+    return true;
+}
+
+QByteArray PolyVoxChunks::toVoxelData() const {
+    return encode(nullptr);
+}
+
+QByteArray PolyVoxChunks::toPartialVoxelData(const std::vector<bool>& changedChunks) const {
+    assert((int)changedChunks.size() == getChunkCount());
+    return encode(&changedChunks);
+}
+
+QByteArray PolyVoxChunks::encode(const std::vector<bool>* changedChunks) const {
+    QByteArray voxelData;
+    QDataStream writer(&voxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+
+    quint8 flags = changedChunks ? PARTIAL_FLAG : 0;
+    writer << (quint16)(_xSize | CHUNKED_FLAG) << _ySize << _zSize << flags;
+
+    const int MAX_RUN = std::numeric_limits<quint16>::max();
+    int chunkCount = getChunkCount();
+    int index = 0;
+    while (index < chunkCount) {
+        const Chunk& chunk = _chunks[index];
+        int run = 1;
+        if (changedChunks && !(*changedChunks)[index]) {
+            while (index + run < chunkCount && run < MAX_RUN && !(*changedChunks)[index + run]) {
+                run++;
+            }
+            writer << (quint8)UNCHANGED_RUN << (quint16)run;
+        } else if (chunk.isUniform()) {
+            while (index + run < chunkCount && run < MAX_RUN && _chunks[index + run] == chunk &&
+                   (!changedChunks || (*changedChunks)[index + run])) {
+                run++;
+            }
+            writer << (quint8)UNIFORM_RUN << (quint8)chunk._value << (quint16)run;
+        } else {
+            writer << (quint8)COMPRESSED << (quint16)chunk._compressed.size();
+            writer.writeRawData(chunk._compressed.constData(), chunk._compressed.size());
+        }
+        index += run;
+    }
+
+    return voxelData;
+}
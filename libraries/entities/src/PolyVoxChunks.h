@@ -0,0 +1,103 @@
+//
+//  PolyVoxChunks.h
+//  libraries/entities/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PolyVoxChunks_h
+#define hifi_PolyVoxChunks_h
+
+#include <vector>
+
+#include <QByteArray>
+
+// A PolyVox entity's voxelData property, split into fixed-size cubic chunks that are compressed independently.
+// Chunks are ordered with x varying fastest, then y, then z, and voxels within a chunk use the same ordering.
+// Chunks which hang off the high edges of the volume are padded with zeros.
+//
+// The encoded form starts with the volume dimensions as quint16s (the x dimension has CHUNKED_FLAG set, which
+// tells it apart from the older single-blob encoding), followed by a flags byte and a series of records:
+//
+//   UNIFORM_RUN      quint8 value, quint16 count     -- count consecutive chunks where every voxel is value
+//   COMPRESSED       quint16 size, size bytes        -- one chunk, qCompress'ed
+//   UNCHANGED_RUN    quint16 count                   -- count chunks that this partial update doesn't touch
+//
+// A partial encoding (PARTIAL_FLAG) only carries the chunks that changed and must be applied on top of a full
+// encoding of the same dimensions.
+class PolyVoxChunks {
+public:
+    static const int CHUNK_SIDE = 16;
+    static const int CHUNK_VOXEL_COUNT = CHUNK_SIDE * CHUNK_SIDE * CHUNK_SIDE;
+
+    static const quint16 CHUNKED_FLAG = 0x8000;
+    static const quint8 PARTIAL_FLAG = 0x01;
+
+    class Chunk {
+    public:
+        bool isUniform() const { return _compressed.isEmpty(); }
+        uint8_t getUniformValue() const { return _value; }
+        const QByteArray& getCompressed() const { return _compressed; }
+
+        bool operator==(const Chunk& other) const { return _value == other._value && _compressed == other._compressed; }
+        bool operator!=(const Chunk& other) const { return !(*this == other); }
+
+    private:
+        friend class PolyVoxChunks;
+        uint8_t _value { 0 };
+        QByteArray _compressed;
+    };
+
+    // raw chunk data is CHUNK_VOXEL_COUNT bytes
+    static Chunk compressChunk(const QByteArray& raw);
+    static QByteArray uncompressChunk(const Chunk& chunk);
+
+    static bool isChunked(const QByteArray& voxelData);
+    static bool isPartial(const QByteArray& voxelData);
+
+    PolyVoxChunks() {}
+    PolyVoxChunks(quint16 xSize, quint16 ySize, quint16 zSize); // every voxel is zero
+
+    quint16 getXSize() const { return _xSize; }
+    quint16 getYSize() const { return _ySize; }
+    quint16 getZSize() const { return _zSize; }
+    bool hasSize(quint16 xSize, quint16 ySize, quint16 zSize) const {
+        return _xSize == xSize && _ySize == ySize && _zSize == zSize;
+    }
+
+    int getChunkCount() const { return (int)_chunks.size(); }
+    int getChunkIndex(int chunkX, int chunkY, int chunkZ) const {
+        return (chunkZ * _yChunks + chunkY) * _xChunks + chunkX;
+    }
+    int getChunkIndexForVoxel(int x, int y, int z) const {
+        return getChunkIndex(x / CHUNK_SIDE, y / CHUNK_SIDE, z / CHUNK_SIDE);
+    }
+    void getChunkOrigin(int index, int& x, int& y, int& z) const;
+
+    const Chunk& getChunk(int index) const { return _chunks[index]; }
+    void setChunk(int index, const Chunk& chunk) { _chunks[index] = chunk; }
+
+    // parse either encoding.  A full encoding replaces everything, a partial one is merged into the current chunks.
+    // Returns false, leaving this unchanged, if the data is malformed or is a partial update of a different size.
+    bool readVoxelData(const QByteArray& voxelData);
+
+    QByteArray toVoxelData() const;
+    QByteArray toPartialVoxelData(const std::vector<bool>& changedChunks) const;
+
+private:
+    bool readLegacyVoxelData(const QByteArray& voxelData);
+    QByteArray encode(const std::vector<bool>* changedChunks) const;
+
+    quint16 _xSize { 0 };
+    quint16 _ySize { 0 };
+    quint16 _zSize { 0 };
+    int _xChunks { 0 };
+    int _yChunks { 0 };
+    int _zChunks { 0 };
+    std::vector<Chunk> _chunks;
+};
+
+#endif // hifi_PolyVoxChunks_h
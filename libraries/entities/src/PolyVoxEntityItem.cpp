@@ -20,6 +20,7 @@
 #include "EntityItemProperties.h"
 #include "EntityTree.h"
 #include "EntityTreeElement.h"
+#include "PolyVoxChunks.h"
 #include "PolyVoxEntityItem.h"
 
 const glm::vec3 PolyVoxEntityItem::DEFAULT_VOXEL_VOLUME_SIZE = glm::vec3(32, 32, 32);
@@ -38,17 +39,7 @@ EntityItemPointer PolyVoxEntityItem::factory(const EntityItemID& entityID, const
 }
 
 QByteArray PolyVoxEntityItem::makeEmptyVoxelData(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) {
-    int rawSize = voxelXSize * voxelYSize * voxelZSize;
-
-    QByteArray uncompressedData = QByteArray(rawSize, '\0');
-    QByteArray newVoxelData;
-    QDataStream writer(&newVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
-    writer << voxelXSize << voxelYSize << voxelZSize;
-
-    QByteArray compressedData = qCompress(uncompressedData, 9);
-    writer << compressedData;
-
-    return newVoxelData;
+    return PolyVoxChunks(voxelXSize, voxelYSize, voxelZSize).toVoxelData();
 }
 
 PolyVoxEntityItem::PolyVoxEntityItem(const EntityItemID& entityItemID) :
@@ -228,9 +219,24 @@ void PolyVoxEntityItem::debugDump() const {
     qCDebug(entities) << "       getLastEdited:" << debugTime(getLastEdited(), now);
 }
 
+QByteArray PolyVoxEntityItem::applyVoxelDataUpdate(const QByteArray& currentVoxelData, const QByteArray& update) {
+    // edits only carry the chunks that changed.  merge those into the current data so that _voxelData
+    // always holds the whole volume.
+    if (!PolyVoxChunks::isPartial(update)) {
+        return update;
+    }
+
+    PolyVoxChunks chunks;
+    if (!chunks.readVoxelData(currentVoxelData) || !chunks.readVoxelData(update)) {
+        qCDebug(entities) << "PolyVoxEntityItem -- dropping partial voxel data that doesn't apply to the current data";
+        return currentVoxelData;
+    }
+    return chunks.toVoxelData();
+}
+
 void PolyVoxEntityItem::setVoxelData(QByteArray voxelData) {
     withWriteLock([&] {
-        _voxelData = voxelData;
+        _voxelData = applyVoxelDataUpdate(_voxelData, voxelData);
         _voxelDataDirty = true;
     });
 }
@@ -132,6 +132,10 @@ class PolyVoxEntityItem : public EntityItem {
     virtual void getMesh() {}; // recompute mesh
 
  protected:
+    // returns currentVoxelData with update applied.  update is either a whole encoding, which replaces
+    // currentVoxelData, or a partial one carrying only the chunks an edit touched (see PolyVoxChunks)
+    static QByteArray applyVoxelDataUpdate(const QByteArray& currentVoxelData, const QByteArray& update);
+
     glm::vec3 _voxelVolumeSize; // this is always 3 bytes
 
     QByteArray _voxelData;
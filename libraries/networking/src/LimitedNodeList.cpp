@@ -404,6 +404,62 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
     }
 }
 
+qint64 LimitedNodeList::batchPacket(udt::SendBatch& batch, std::unique_ptr<NLPacket> packet,
+                                    const Node& destinationNode) {
+    Q_ASSERT(!packet->isPartOfMessage());
+
+    if (packet->isReliable()) {
+        // reliable packets go through the send queue of their connection, they can't be batched
+        return sendPacket(std::move(packet), destinationNode);
+    }
+
+    auto activeSocket = destinationNode.getActiveSocket();
+    if (!activeSocket) {
+        return 0;
+    }
+
+    auto size = packet->getDataSize();
+
+    emit dataSent(destinationNode.getType(), size);
+    destinationNode.recordBytesSent(size);
+
+    collectPacketStats(*packet);
+    fillPacketHeader(*packet, destinationNode.getConnectionSecret());
+
+    batch.addPacket(std::move(packet), *activeSocket);
+
+    return size;
+}
+
+qint64 LimitedNodeList::batchPacketList(udt::SendBatch& batch, std::unique_ptr<NLPacketList> packetList,
+                                        const Node& destinationNode) {
+    if (packetList->isReliable()) {
+        return sendPacketList(std::move(packetList), destinationNode);
+    }
+
+    auto activeSocket = destinationNode.getActiveSocket();
+    if (!activeSocket) {
+        qCDebug(networking) << "LimitedNodeList::batchPacketList called without active socket for node. Not sending.";
+        return 0;
+    }
+
+    // close the last packet in the list
+    packetList->closeCurrentPacket();
+
+    qint64 bytesBatched = 0;
+
+    while (!packetList->_packets.empty()) {
+        auto packet = packetList->takeFront<NLPacket>();
+        collectPacketStats(*packet);
+        fillPacketHeader(*packet, destinationNode.getConnectionSecret());
+
+        bytesBatched += packet->getDataSize();
+        batch.addPacket(std::move(packet), *activeSocket);
+    }
+
+    return bytesBatched;
+}
+
 qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode,
                                    const HifiSockAddr& overridenSockAddr) {
     if (overridenSockAddr.isNull() && !destinationNode.getActiveSocket()) {
@@ -65,6 +65,13 @@ using namespace tbb;
 typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
 typedef concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
 
+// each entry in a DomainList is either a node to add or update, or the UUID of a node that is gone
+typedef quint8 DomainListEntry_t;
+namespace DomainListEntry {
+    const DomainListEntry_t Node = 0;
+    const DomainListEntry_t RemovedNode = 1;
+}
+
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -129,6 +136,11 @@ public:
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 sendPacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode);
 
+    // unreliable packets are added to the batch and only go out with sendBatch, reliable ones are sent right away
+    qint64 batchPacket(udt::SendBatch& batch, std::unique_ptr<NLPacket> packet, const Node& destinationNode);
+    qint64 batchPacketList(udt::SendBatch& batch, std::unique_ptr<NLPacketList> packetList, const Node& destinationNode);
+    qint64 sendBatch(udt::SendBatch& batch) { return _nodeSocket.writeBatch(batch); }
+
     std::function<void(Node*)> linkedDataCreateCallback;
 
     size_t size() const { return _nodeHash.size(); }
@@ -220,6 +232,7 @@ public:
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    bool setNumSendQueueThreads(int numThreads) { return _nodeSocket.setNumSendQueueThreads(numThreads); }
 
 public slots:
     void reset();
@@ -311,11 +311,19 @@ void NodeList::sendDomainServerCheckIn() {
 
             // pack the connect UUID for this connect request
             packetStream << connectUUID;
+
+            // a newly connected node is sent the whole domain list
+            _domainListVersion = 0;
         }
 
         // pack our data to send to the domain-server
         packetStream << _ownerType << _publicSockAddr << _localSockAddr << _nodeTypesOfInterest.toList();
 
+        if (domainPacketType == PacketType::DomainListRequest) {
+            // let the domain-server know what we've already heard, so it only needs to send us what changed since
+            packetStream << _domainListVersion;
+        }
+
         if (!_domainHandler.isConnected()) {
             DataServerAccountInfo& accountInfo = accountManager.getAccountInfo();
             packetStream << accountInfo.getUsername();
@@ -537,10 +545,26 @@ void NodeList::processDomainServerList(QSharedPointer<ReceivedMessage> message)
     quint8 thisNodeCanRez;
     packetStream >> thisNodeCanRez;
     setThisNodeCanRez((bool) thisNodeCanRez);
+
+    // this is either the whole list, or what changed since the version we last told the domain-server we heard
+    quint32 domainListVersion;
+    packetStream >> domainListVersion;
+    if (domainListVersion > _domainListVersion) {
+        _domainListVersion = domainListVersion;
+    }
     
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
-        parseNodeFromPacketStream(packetStream);
+        DomainListEntry_t entryType;
+        packetStream >> entryType;
+
+        if (entryType == DomainListEntry::RemovedNode) {
+            QUuid nodeUUID;
+            packetStream >> nodeUUID;
+            killNodeWithUUID(nodeUUID);
+        } else {
+            parseNodeFromPacketStream(packetStream);
+        }
     }
 }
 
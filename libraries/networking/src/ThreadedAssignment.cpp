@@ -16,6 +16,8 @@
 
 #include <LogHandler.h>
 
+#include "udt/PacketBufferPool.h"
+
 #include "ThreadedAssignment.h"
 
 ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
@@ -98,6 +100,17 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject &statsObje
     statsObject["packets_per_second"] = packetsPerSecond;
     statsObject["bytes_per_second"] = bytesPerSecond;
 
+    auto& packetBufferPool = udt::PacketBufferPool::getInstance();
+    auto poolStats = packetBufferPool.getStats();
+    packetBufferPool.resetHitsAndMisses();
+
+    QJsonObject poolObject;
+    poolObject["hits"] = (double)poolStats.hits;
+    poolObject["misses"] = (double)poolStats.misses;
+    poolObject["in_use"] = poolStats.buffersInUse;
+    poolObject["high_water_mark"] = poolStats.highWaterMark;
+    statsObject["packet_buffer_pool"] = poolObject;
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
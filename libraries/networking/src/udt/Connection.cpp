@@ -22,6 +22,7 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 
 using namespace udt;
@@ -58,6 +59,18 @@ Connection::~Connection() {
 
 void Connection::stopSendQueue() {
     if (auto sendQueue = _sendQueue.release()) {
+        if (auto scheduler = sendQueue->getScheduler()) {
+            // the send queue has no thread of its own - once the scheduler is done with it we can delete it
+            sendQueue->stop();
+            scheduler->remove(sendQueue);
+            sendQueue->deleteLater();
+
+            // since we're stopping the send queue we should consider our handshake ACK not receieved
+            _hasReceivedHandshakeACK = false;
+
+            return;
+        }
+
         // grab the send queue thread so we can wait on it
         QThread* sendQueueThread = sendQueue->thread();
         
@@ -61,6 +61,10 @@ public:
         int receivedUnreliableUtilBytes { 0 };
         int sentUnreliableBytes { 0 };
         int receivedUnreliableBytes { 0 };
+
+        // reads on the socket this connection is on, divide to get the datagrams read per syscall
+        int receiveSyscalls { 0 };
+        int receivedDatagrams { 0 };
        
         // the following stats are trailing averages in the result, not totals
         int sendRate { 0 };
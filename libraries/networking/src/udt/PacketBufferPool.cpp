@@ -0,0 +1,162 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <string.h>
+
+using namespace udt;
+
+static const quint64 FREE_LIST_INDEX_MASK = 0xFFFFFFFF;
+static const int FREE_LIST_TAG_SHIFT = 32;
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (buffer) {
+        PacketBufferPool::getInstance().release(buffer);
+    }
+}
+
+PacketBufferPool& PacketBufferPool::getInstance() {
+    // the pool is never destroyed, since packets can outlive any other static object that would own it
+    static PacketBufferPool* pool = new PacketBufferPool();
+    return *pool;
+}
+
+PacketBufferPool::PacketBufferPool() {
+    for (auto& chunk : _chunks) {
+        chunk.store(nullptr);
+    }
+
+    for (auto& nextFree : _nextFree) {
+        nextFree.store(0);
+    }
+}
+
+PacketBuffer PacketBufferPool::allocateBuffer(qint64 size, bool zeroed) {
+    char* buffer = nullptr;
+
+    if (size <= BUFFER_SIZE) {
+        // pop the head of the free list
+        quint64 head = _freeListHead.load(std::memory_order_acquire);
+
+        while (head & FREE_LIST_INDEX_MASK) {
+            quint32 index = (quint32)(head & FREE_LIST_INDEX_MASK) - 1;
+            quint64 nextHead = (((head >> FREE_LIST_TAG_SHIFT) + 1) << FREE_LIST_TAG_SHIFT)
+                | _nextFree[index].load(std::memory_order_relaxed);
+
+            if (_freeListHead.compare_exchange_weak(head, nextHead, std::memory_order_acquire, std::memory_order_acquire)) {
+                buffer = bufferForIndex(index);
+                ++_hits;
+                break;
+            }
+        }
+
+        if (!buffer) {
+            // the free list is empty - grow the pool if it still has room
+            ++_misses;
+
+            quint32 index = _numPooledBuffers++;
+            if (index < (quint32)MAX_POOLED_BUFFERS) {
+                buffer = bufferForIndex(index);
+            } else {
+                _numPooledBuffers = MAX_POOLED_BUFFERS;
+            }
+        }
+    } else {
+        ++_misses;
+    }
+
+    if (!buffer) {
+        buffer = heapBuffer(size);
+    }
+
+    recordBufferInUse();
+
+    if (zeroed) {
+        memset(buffer, 0, size);
+    }
+
+    return PacketBuffer(buffer);
+}
+
+void PacketBufferPool::release(char* buffer) {
+    --_buffersInUse;
+
+    quint32 index;
+    memcpy(&index, buffer - BUFFER_HEADER_SIZE, sizeof(index));
+
+    if (index == HEAP_BUFFER_INDEX) {
+        delete[] (buffer - BUFFER_HEADER_SIZE);
+        return;
+    }
+
+    // push the buffer back on the head of the free list
+    quint64 head = _freeListHead.load(std::memory_order_relaxed);
+    quint64 nextHead;
+
+    do {
+        _nextFree[index].store((quint32)(head & FREE_LIST_INDEX_MASK), std::memory_order_relaxed);
+        nextHead = (((head >> FREE_LIST_TAG_SHIFT) + 1) << FREE_LIST_TAG_SHIFT) | (index + 1);
+    } while (!_freeListHead.compare_exchange_weak(head, nextHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+char* PacketBufferPool::bufferForIndex(quint32 index) {
+    int chunkIndex = index / BUFFERS_PER_CHUNK;
+    char* chunk = _chunks[chunkIndex].load(std::memory_order_acquire);
+
+    if (!chunk) {
+        // allocate this chunk, if another thread beats us to it we use theirs instead
+        char* newChunk = new char[BUFFERS_PER_CHUNK * BUFFER_STRIDE];
+
+        for (int i = 0; i < BUFFERS_PER_CHUNK; ++i) {
+            quint32 bufferIndex = chunkIndex * BUFFERS_PER_CHUNK + i;
+            memcpy(newChunk + i * BUFFER_STRIDE, &bufferIndex, sizeof(bufferIndex));
+        }
+
+        if (_chunks[chunkIndex].compare_exchange_strong(chunk, newChunk, std::memory_order_acq_rel)) {
+            chunk = newChunk;
+        } else {
+            delete[] newChunk;
+        }
+    }
+
+    return chunk + (index % BUFFERS_PER_CHUNK) * BUFFER_STRIDE + BUFFER_HEADER_SIZE;
+}
+
+char* PacketBufferPool::heapBuffer(qint64 size) {
+    char* allocation = new char[BUFFER_HEADER_SIZE + size];
+
+    quint32 index = HEAP_BUFFER_INDEX;
+    memcpy(allocation, &index, sizeof(index));
+    return allocation + BUFFER_HEADER_SIZE;
+}
+
+void PacketBufferPool::recordBufferInUse() {
+    int buffersInUse = ++_buffersInUse;
+
+    int highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+    while (buffersInUse > highWaterMark
+           && !_highWaterMark.compare_exchange_weak(highWaterMark, buffersInUse, std::memory_order_relaxed)) {
+    }
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() const {
+    Stats stats;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.buffersInUse = _buffersInUse;
+    stats.highWaterMark = _highWaterMark;
+    return stats;
+}
+
+void PacketBufferPool::resetHitsAndMisses() {
+    _hits = 0;
+    _misses = 0;
+}
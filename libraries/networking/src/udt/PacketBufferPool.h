@@ -0,0 +1,93 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PacketBufferPool_h
+#define hifi_PacketBufferPool_h
+
+#include <atomic>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "Constants.h"
+
+namespace udt {
+
+struct PacketBufferDeleter {
+    void operator()(char* buffer) const;
+};
+
+// the memory behind every BasePacket, returned to the PacketBufferPool when the packet is done with it
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+/// Thread-safe, lock-free pool of MTU sized packet buffers.
+/// Buffers up to MAX_PACKET_SIZE come from a free list that grows on demand up to MAX_POOLED_BUFFERS,
+/// anything larger (or anything past the pool capacity) falls back to the heap.
+class PacketBufferPool {
+public:
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+    static const int BUFFERS_PER_CHUNK = 256;
+    static const int MAX_CHUNKS = 64;
+    static const int MAX_POOLED_BUFFERS = BUFFERS_PER_CHUNK * MAX_CHUNKS;
+
+    struct Stats {
+        quint64 hits { 0 };         // allocations served from the free list
+        quint64 misses { 0 };       // allocations that needed new memory
+        int buffersInUse { 0 };
+        int highWaterMark { 0 };    // most buffers in use at once
+    };
+
+    static PacketBufferPool& getInstance();
+
+    // returns a buffer of at least the given size, zeroed if requested
+    static PacketBuffer allocate(qint64 size, bool zeroed = false) { return getInstance().allocateBuffer(size, zeroed); }
+
+    Stats getStats() const;
+    void resetHitsAndMisses();
+
+private:
+    PacketBufferPool();
+
+    PacketBufferPool(const PacketBufferPool&) = delete;
+    PacketBufferPool& operator=(const PacketBufferPool&) = delete;
+
+    PacketBuffer allocateBuffer(qint64 size, bool zeroed);
+    void release(char* buffer);
+
+    char* bufferForIndex(quint32 index);
+    char* heapBuffer(qint64 size);
+
+    void recordBufferInUse();
+
+    friend struct PacketBufferDeleter;
+
+    // every buffer is preceded by a header that stores its index in the pool (or HEAP_BUFFER_INDEX)
+    static const int BUFFER_HEADER_SIZE = 16;
+    static const quint32 HEAP_BUFFER_INDEX = 0xFFFFFFFF;
+    static const int BUFFER_STRIDE = BUFFER_HEADER_SIZE + BUFFER_SIZE;
+
+    // the free list head packs an ABA tag in the high 32 bits and (index + 1) in the low 32 bits, 0 meaning empty
+    std::atomic<quint64> _freeListHead { 0 };
+    std::atomic<quint32> _nextFree[MAX_POOLED_BUFFERS];
+
+    std::atomic<char*> _chunks[MAX_CHUNKS];
+    std::atomic<quint32> _numPooledBuffers { 0 };
+
+    std::atomic<quint64> _hits { 0 };
+    std::atomic<quint64> _misses { 0 };
+    std::atomic<int> _buffersInUse { 0 };
+    std::atomic<int> _highWaterMark { 0 };
+};
+
+}
+
+#endif // hifi_PacketBufferPool_h
@@ -43,11 +43,12 @@ const QSet<PacketType> RELIABLE_PACKETS = QSet<PacketType>();
 PacketVersion versionForPacketType(PacketType packetType) {
     switch (packetType) {
         case PacketType::DomainList:
-            return 18;
+        case PacketType::DomainListRequest:
+            return static_cast<PacketVersion>(DomainListVersion::DeltaUpdates);
         case PacketType::EntityAdd:
         case PacketType::EntityEdit:
         case PacketType::EntityData:
-            return VERSION_LIGHT_HAS_FALLOFF_RADIUS;
+            return VERSION_ENTITIES_POLYVOX_CHUNKED_VOXEL_DATA;
         case PacketType::AvatarData:
         case PacketType::BulkAvatarData:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::SoftAttachmentSupport);
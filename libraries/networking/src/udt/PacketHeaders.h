@@ -93,7 +93,9 @@ public:
         MessagesUnsubscribe,
         ICEServerHeartbeatDenied,
         AssetMappingOperation,
-        AssetMappingOperationReply
+        AssetMappingOperationReply,
+        NegotiateAudioFormat,
+        SelectedAudioFormat
     };
 };
 
@@ -170,6 +172,12 @@ const PacketVersion VERSION_ENTITITES_HAVE_QUERY_BOX = 54;
 const PacketVersion VERSION_ENTITITES_HAVE_COLLISION_MASK = 55;
 const PacketVersion VERSION_ATMOSPHERE_REMOVED = 56;
 const PacketVersion VERSION_LIGHT_HAS_FALLOFF_RADIUS = 57;
+const PacketVersion VERSION_ENTITIES_POLYVOX_CHUNKED_VOXEL_DATA = 58;
+
+enum class DomainListVersion : PacketVersion {
+    PermissionsSupport = 18,
+    DeltaUpdates
+};
 
 enum class AvatarMixerPacketVersion : PacketVersion {
     TranslationSupport = 17,
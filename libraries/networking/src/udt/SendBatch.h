@@ -0,0 +1,57 @@
+//
+//  SendBatch.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendBatch_h
+#define hifi_SendBatch_h
+
+#include <memory>
+#include <vector>
+
+#include "../HifiSockAddr.h"
+#include "Packet.h"
+
+namespace udt {
+
+/// Unreliable packets collected to be written by Socket::writeBatch with as few syscalls as the platform allows.
+/// Packets are written in the order they were added. A batch is only meant to be used from one thread at a time.
+class SendBatch {
+public:
+    void addPacket(std::unique_ptr<Packet> packet, const HifiSockAddr& destination) {
+        Q_ASSERT_X(!packet->isReliable(), "SendBatch::addPacket", "Cannot batch a reliable packet");
+        _datagrams.push_back({ std::move(packet), destination });
+    }
+
+    bool isEmpty() const { return _datagrams.empty(); }
+    int getNumPackets() const { return (int)_datagrams.size(); }
+
+    // totals over every write of this batch, divide to get the datagrams written per syscall
+    int getNumWriteSyscalls() const { return _numWriteSyscalls; }
+    int getNumWrittenDatagrams() const { return _numWrittenDatagrams; }
+    void resetStats() { _numWriteSyscalls = 0; _numWrittenDatagrams = 0; }
+
+private:
+    struct Datagram {
+        std::unique_ptr<Packet> packet;
+        HifiSockAddr destination;
+    };
+
+    std::vector<Datagram> _datagrams;
+
+    int _numWriteSyscalls { 0 };
+    int _numWrittenDatagrams { 0 };
+
+    friend class Socket;
+};
+
+}
+
+#endif // hifi_SendBatch_h
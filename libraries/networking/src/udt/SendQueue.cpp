@@ -29,6 +29,7 @@
 #include "Packet.h"
 #include "PacketList.h"
 #include "../UserActivityLogger.h"
+#include "SendQueueScheduler.h"
 #include "Socket.h"
 
 using namespace udt;
@@ -58,10 +59,21 @@ private:
     Mutex2& _mutex2;
 };
 
+using PacketsAndNAKsLock = DoubleLock<std::recursive_mutex, std::mutex>;
+
+static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destination) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
     
-    auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination));
+    auto scheduler = socket->getSendQueueScheduler();
+    auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, scheduler));
+
+    if (scheduler) {
+        // the pacing threads of the scheduler step the queue, it stays on the thread of its connection
+        scheduler->add(queue.get());
+        return queue;
+    }
 
     // Setup queue private thread
     QThread* thread = new QThread;
@@ -80,9 +92,10 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, HifiSockAddr destin
     return queue;
 }
     
-SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
+SendQueue::SendQueue(Socket* socket, HifiSockAddr dest, SendQueueScheduler* scheduler) :
     _socket(socket),
-    _destination(dest)
+    _destination(dest),
+    _scheduler(scheduler)
 {
 
     // setup psuedo-random number generation for all instances of SendQueue
@@ -102,10 +115,10 @@ SendQueue::SendQueue(Socket* socket, HifiSockAddr dest) :
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is sleeping waiting for packets
+    wakeUp();
     
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
+    if (!_scheduler && !this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
     }
 }
@@ -113,10 +126,10 @@ void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is sleeping waiting for packets
+    wakeUp();
     
-    if (!this->thread()->isRunning() && _state == State::NotStarted) {
+    if (!_scheduler && !this->thread()->isRunning() && _state == State::NotStarted) {
         this->thread()->start();
     }
 }
@@ -128,6 +141,11 @@ void SendQueue::stop() {
     // Notify all conditions in case we're waiting somewhere
     _handshakeACKCondition.notify_one();
     _emptyCondition.notify_one();
+
+    if (_scheduler) {
+        // have the scheduler step us right away so that it sees we've stopped
+        _scheduler->wake(this);
+    }
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
@@ -160,8 +178,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is sleeping with a full congestion window
+    wakeUp();
 }
 
 void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
@@ -173,8 +191,8 @@ void SendQueue::nak(SequenceNumber start, SequenceNumber end) {
         _naks.insert(start, end);
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is sleeping waiting for losses to re-send
+    wakeUp();
 }
 
 void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
@@ -198,25 +216,28 @@ void SendQueue::overrideNAKListFromPacket(ControlPacket& packet) {
         }
     }
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // wake the queue up in case it is sleeping waiting for losses to re-send
+    wakeUp();
 }
 
 void SendQueue::sendHandshake() {
     std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
     if (!_hasReceivedHandshakeACK) {
         // we haven't received a handshake ACK from the client, send another now
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-
-        handshakePacket->writePrimitive(_initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
+        sendHandshakePacket();
         
         // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
         _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
     }
 }
 
+void SendQueue::sendHandshakePacket() {
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+
+    handshakePacket->writePrimitive(_initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _destination);
+}
+
 void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
     if (initialSequenceNumber == _initialSequenceNumber) {
         {
@@ -226,6 +247,10 @@ void SendQueue::handshakeACK(SequenceNumber initialSequenceNumber) {
 
         // Notify on the handshake ACK condition
         _handshakeACKCondition.notify_one();
+
+        if (_scheduler) {
+            wakeUp();
+        }
     }
 }
 
@@ -301,18 +326,11 @@ void SendQueue::run() {
     }
 
     // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    _nextPacketTimestamp = p_high_resolution_clock::now();
 
     while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
-        }
+        int newPacketCount = 0;
+        bool attemptedToSendPacket = maybeSendPackets(newPacketCount);
         
         // since we're a while loop, give the thread a chance to process events
         QCoreApplication::sendPostedEvents(this);
@@ -325,47 +343,152 @@ void SendQueue::run() {
             return;
         }
 
-        // push the next packet timestamp forwards by the current packet send period
-        auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-        nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
-
         // sleep as long as we need until next packet send, if we can
-        auto now = p_high_resolution_clock::now();
-        auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
-
-        // we're seeing SendQueues sleep for a long period of time here,
-        // which can lock the NodeList if it's attempting to clear connections
-        // for now we guard this by capping the time this thread and sleep for
-
-        const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-        if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-            qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-            qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-            qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-            // alright, we're in a weird state
-            // we want to know why this is happening so we can implement a better fix than this guard
-            // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-            static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-            // setup a json object with the details we want
-            QJsonObject longSleepObject;
-            longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-            longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-            longSleepObject["nextPacketDelta"] = nextPacketDelta;
-            longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-            longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-            // hopefully send this event using the user activity logger
-            UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-
-            timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+        std::this_thread::sleep_for(timeUntilNextPacket(newPacketCount));
+    }
+}
+
+bool SendQueue::step(TimePoint& nextStepTime) {
+    // whatever we were waiting on has either happened or timed out
+    _isWaitingForWakeUp = false;
+
+    State notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
+
+    if (_state != State::Running) {
+        return false;
+    }
+
+    auto now = p_high_resolution_clock::now();
+
+    if (!_hasReceivedHandshakeACK) {
+        std::lock_guard<std::mutex> handshakeLock { _handshakeMutex };
+
+        if (!_hasReceivedHandshakeACK) {
+            if (now >= _nextHandshakeTimestamp) {
+                // we haven't received a handshake ACK from the client, send another now
+                sendHandshakePacket();
+                _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
+            }
+
+            // we wait for the ACK (which wakes us up) or the re-send interval to expire
+            _isWaitingForWakeUp = true;
+            nextStepTime = _nextHandshakeTimestamp;
+            return true;
+        }
+    }
+
+    if (!_hasStartedPacing) {
+        _nextPacketTimestamp = now;
+        _hasStartedPacing = true;
+    }
+
+    if (_idleDeadline != TimePoint()) {
+        // we were idle - either something woke us up or the wait for it has timed out
+        bool hasTimedOut = now >= _idleDeadline;
+        _idleDeadline = TimePoint();
+
+        if (hasTimedOut) {
+            PacketsAndNAKsLock doubleLock(_packets.getLock(), _naksLock);
+            PacketsAndNAKsLock::Lock locker(doubleLock);
+
+            if (isIdle() && handleIdleTimeout(locker, _wasFullyACKedWhenIdle)) {
+                return false;
+            }
         }
 
-        std::this_thread::sleep_for(timeToSleep);
+        // like the threaded send loop, pace the next packet from where we were before going idle
+        nextStepTime = p_high_resolution_clock::now() + timeUntilNextPacket(0);
+        return true;
+    }
+
+    int newPacketCount = 0;
+    bool attemptedToSendPacket = maybeSendPackets(newPacketCount);
+
+    if (_state != State::Running) {
+        return false;
+    }
+
+    if (hasReceiverTimedOut()) {
+        deactivate();
+        return false;
+    }
+
+    if (!attemptedToSendPacket) {
+        PacketsAndNAKsLock doubleLock(_packets.getLock(), _naksLock);
+        PacketsAndNAKsLock::Lock locker(doubleLock, std::try_to_lock);
+
+        if (locker.owns_lock() && isIdle()) {
+            // instead of blocking a pacing thread we go idle until the same timeout as the threaded send loop,
+            // the wake up flag is raised while we hold both locks so that a packet or NAK added after we checked wakes us
+            _wasFullyACKedWhenIdle = uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber);
+            _idleDeadline = now + idleTimeout(_wasFullyACKedWhenIdle);
+            _isWaitingForWakeUp = true;
+
+            nextStepTime = _idleDeadline;
+            return true;
+        }
+    }
+
+    nextStepTime = p_high_resolution_clock::now() + timeUntilNextPacket(newPacketCount);
+    return true;
+}
+
+bool SendQueue::maybeSendPackets(int& newPacketCount) {
+    bool attemptedToSendPacket = maybeResendPacket();
+    
+    // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+    // (this is according to the current flow window size) then we send out a new packet
+    newPacketCount = 0;
+    if (!attemptedToSendPacket) {
+        newPacketCount = maybeSendNewPacket();
+        attemptedToSendPacket = (newPacketCount > 0);
+    }
+
+    return attemptedToSendPacket;
+}
+
+microseconds SendQueue::timeUntilNextPacket(int newPacketCount) {
+    // push the next packet timestamp forwards by the current packet send period
+    auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
+    _nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+
+    // sleep as long as we need until next packet send, if we can
+    auto now = p_high_resolution_clock::now();
+    auto timeToSleep = duration_cast<microseconds>(_nextPacketTimestamp - now);
+
+    // we're seeing SendQueues sleep for a long period of time here,
+    // which can lock the NodeList if it's attempting to clear connections
+    // for now we guard this by capping the time this thread and sleep for
+
+    const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
+    if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
+        qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
+        qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
+        qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
+            << "NPT:" << _nextPacketTimestamp.time_since_epoch().count()
+            << "NOW:" << now.time_since_epoch().count();
+
+        // alright, we're in a weird state
+        // we want to know why this is happening so we can implement a better fix than this guard
+        // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
+        static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
+
+        // setup a json object with the details we want
+        QJsonObject longSleepObject;
+        longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
+        longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
+        longSleepObject["nextPacketDelta"] = nextPacketDelta;
+        longSleepObject["nextPacketTimestamp"] = qint64(_nextPacketTimestamp.time_since_epoch().count());
+        longSleepObject["then"] = qint64(now.time_since_epoch().count());
+
+        // hopefully send this event using the user activity logger
+        UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
+
+        timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
     }
+
+    return timeToSleep;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -499,7 +622,36 @@ bool SendQueue::maybeResendPacket() {
 
 bool SendQueue::isInactive(bool attemptedToSendPacket) {
     // check for connection timeout first
+    if (hasReceiverTimedOut()) {
+        deactivate();
+        return true;
+    }
 
+    if (!attemptedToSendPacket) {
+        // During our processing above we didn't send any packets
+        
+        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
+        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
+        PacketsAndNAKsLock doubleLock(_packets.getLock(), _naksLock);
+        PacketsAndNAKsLock::Lock locker(doubleLock, std::try_to_lock);
+        
+        if (locker.owns_lock() && isIdle()) {
+            // The packets queue and loss list mutexes are now both locked and they're both empty
+            bool wasFullyACKed = uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber);
+            
+            // use our condition_variable_any to wait
+            auto cvStatus = _emptyCondition.wait_for(locker, idleTimeout(wasFullyACKed));
+            
+            if (cvStatus == std::cv_status::timeout && isIdle() && handleIdleTimeout(locker, wasFullyACKed)) {
+                return true;
+            }
+        }
+    }
+    
+    return false;
+}
+
+bool SendQueue::hasReceiverTimedOut() const {
     // that will be the case if we have had 16 timeouts since hearing back from the client, and it has been
     // at least 5 seconds
     static const int NUM_TIMEOUTS_BEFORE_INACTIVE = 16;
@@ -519,75 +671,74 @@ bool SendQueue::isInactive(bool attemptedToSendPacket) {
             << "and" << MIN_MS_BEFORE_INACTIVE << "milliseconds before receiving any ACK/NAK and is now inactive. Stopping.";
 #endif
 
-        deactivate();
         return true;
     }
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    return false;
+}
+
+bool SendQueue::isIdle() const {
+    return (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty();
+}
+
+microseconds SendQueue::idleTimeout(bool wasFullyACKed) const {
+    if (wasFullyACKed) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
+        return EMPTY_QUEUES_INACTIVE_TIMEOUT;
+    } else {
+        // We think the client is still waiting for data (based on the sequence number gap)
+        // Let's wait either for a response from the client or until the estimated timeout
+        // (plus the sync interval to allow the client to respond) has elapsed
+        return microseconds(_estimatedTimeout + _syncInterval);
+    }
+}
+
+template <typename Lock>
+bool SendQueue::handleIdleTimeout(Lock& locker, bool wasFullyACKed) {
+    if (wasFullyACKed) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+            << duration_cast<seconds>(idleTimeout(wasFullyACKed)).count()
+            << "seconds and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+        // we have the lock again - Make sure to unlock it
+        locker.unlock();
+        
+        // Deactivate queue
+        deactivate();
+        return true;
+    } else if (SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        
+        // Note that thanks to the DoubleLock we have the _naksLock right now
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-                auto waitDuration = std::chrono::microseconds(_estimatedTimeout + _syncInterval);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, waitDuration);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
+        // we have the lock again - time to unlock it
+        locker.unlock();
+        
+        emit timeout();
     }
-    
+
     return false;
 }
 
+void SendQueue::wakeUp() {
+    if (_scheduler) {
+        // only a queue that is waiting is stepped early, a queue that is pacing packets keeps to its send period
+        if (_isWaitingForWakeUp.exchange(false)) {
+            _scheduler->wake(this);
+        }
+    } else {
+        // call notify_one on the condition_variable_any in case the send thread is sleeping
+        _emptyCondition.notify_one();
+    }
+}
+
 void SendQueue::deactivate() {
     // this queue is inactive - emit that signal and stop the while
     emit queueInactive();
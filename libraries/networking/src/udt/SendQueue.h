@@ -38,6 +38,7 @@ class BasePacket;
 class ControlPacket;
 class Packet;
 class PacketList;
+class SendQueueScheduler;
 class Socket;
     
 class SendQueue : public QObject {
@@ -49,7 +50,10 @@ public:
         Running,
         Stopped
     };
+
+    using TimePoint = p_high_resolution_clock::time_point;
     
+    // the queue runs on its own thread, unless the socket has a SendQueueScheduler to step it from a pacing thread
     static std::unique_ptr<SendQueue> create(Socket* socket, HifiSockAddr destination);
     
     void queuePacket(std::unique_ptr<Packet> packet);
@@ -64,6 +68,12 @@ public:
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
     void setSyncInterval(int syncInterval) { _syncInterval = syncInterval; }
+
+    SendQueueScheduler* getScheduler() const { return _scheduler; }
+
+    // runs one iteration of the send loop without blocking, for use by the SendQueueScheduler
+    // returns false once the queue has stopped, otherwise sets the time the next step should be run at
+    bool step(TimePoint& nextStepTime);
     
 public slots:
     void stop();
@@ -86,21 +96,35 @@ private slots:
     void run();
     
 private:
-    SendQueue(Socket* socket, HifiSockAddr dest);
+    SendQueue(Socket* socket, HifiSockAddr dest, SendQueueScheduler* scheduler);
     SendQueue(SendQueue& other) = delete;
     SendQueue(SendQueue&& other) = delete;
     
     void sendHandshake();
+    void sendHandshakePacket();
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
     
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
+    bool maybeSendPackets(int& newPacketCount); // Resends a lost packet or sends new ones, returns true if it tried to send
+    
+    // Advances the next packet timestamp by the send period and returns how long to wait for it
+    std::chrono::microseconds timeUntilNextPacket(int newPacketCount);
     
     bool isInactive(bool attemptedToSendPacket);
+    bool hasReceiverTimedOut() const;
+    bool isIdle() const; // must be called with both the packets and naks locks held
+    std::chrono::microseconds idleTimeout(bool wasFullyACKed) const;
+
+    // called with both locks held through the given lock after waiting while idle timed out
+    // releases the lock and returns true if the queue was deactivated
+    template <typename Lock> bool handleIdleTimeout(Lock& locker, bool wasFullyACKed);
     void deactivate(); // makes the queue inactive and cleans it up
 
+    void wakeUp(); // wakes the queue if it is waiting for packets, ACKs or NAKs
+
     bool isFlowWindowFull() const;
     
     // Increments current sequence number and return it
@@ -139,6 +163,16 @@ private:
     std::condition_variable _handshakeACKCondition;
     
     std::condition_variable_any _emptyCondition;
+
+    SendQueueScheduler* _scheduler { nullptr }; // Steps this queue when it has no thread of its own
+
+    // state for scheduled stepping, only touched by the pacing thread stepping the queue
+    TimePoint _nextPacketTimestamp; // When the next packet should be sent, advanced by the packet send period
+    TimePoint _nextHandshakeTimestamp; // When the next handshake should be sent
+    TimePoint _idleDeadline; // When waiting for data, ACKs or NAKs times out, zero while not waiting
+    bool _wasFullyACKedWhenIdle { false };
+    bool _hasStartedPacing { false };
+    std::atomic<bool> _isWaitingForWakeUp { false }; // set while the scheduled queue can be woken early
 };
     
 }
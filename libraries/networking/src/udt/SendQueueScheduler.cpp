@@ -0,0 +1,146 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include "../NetworkLogging.h"
+#include "SendQueue.h"
+
+using namespace udt;
+
+SendQueueScheduler::SendQueueScheduler(int numThreads) {
+    numThreads = std::max(numThreads, 1);
+
+    for (int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this] { run(); });
+    }
+
+    qCDebug(networking) << "SendQueues will be paced by" << numThreads << (numThreads == 1 ? "thread" : "threads");
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stopping = true;
+    }
+    _stepReady.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto& entry = _entries[queue];
+    schedule(queue, entry, p_high_resolution_clock::now());
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(queue);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    // a pacing thread may be in the middle of a step for this queue, wait for it to be done with the queue
+    auto& entry = it->second;
+    _stepDone.wait(lock, [&entry] { return !entry.isStepping; });
+
+    // any step still in the priority queue is now stale and will be skipped
+    _entries.erase(queue);
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(queue);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    auto& entry = it->second;
+    if (entry.isStepping) {
+        // the pacing thread stepping this queue will re-schedule it for now once the step completes
+        entry.wakeRequested = true;
+    } else if (entry.isScheduled) {
+        auto now = p_high_resolution_clock::now();
+        if (entry.nextStepTime > now) {
+            schedule(queue, entry, now);
+        }
+    }
+}
+
+void SendQueueScheduler::schedule(SendQueue* queue, Entry& entry, TimePoint time) {
+    // only wake a pacing thread if this step is now the first one due
+    bool isFirstStep = _steps.empty() || time < _steps.top().time;
+
+    entry.generation = ++_nextGeneration;
+    entry.nextStepTime = time;
+    entry.isScheduled = true;
+
+    _steps.push({ time, queue, entry.generation });
+
+    if (isFirstStep) {
+        _stepReady.notify_one();
+    }
+}
+
+void SendQueueScheduler::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_stopping) {
+        if (_steps.empty()) {
+            _stepReady.wait(lock);
+            continue;
+        }
+
+        ScheduledStep step = _steps.top();
+
+        auto it = _entries.find(step.queue);
+        if (it == _entries.end() || it->second.generation != step.generation) {
+            // this queue was removed or re-scheduled since the step was pushed
+            _steps.pop();
+            continue;
+        }
+
+        if (step.time > p_high_resolution_clock::now()) {
+            _stepReady.wait_until(lock, step.time);
+            continue;
+        }
+
+        _steps.pop();
+
+        // references to map elements stay valid until the element is erased, which remove() holds off while we step
+        auto& entry = it->second;
+        entry.isScheduled = false;
+        entry.isStepping = true;
+        entry.wakeRequested = false;
+
+        lock.unlock();
+
+        TimePoint nextStepTime;
+        bool isRunning = step.queue->step(nextStepTime);
+
+        lock.lock();
+
+        entry.isStepping = false;
+
+        if (isRunning) {
+            schedule(step.queue, entry, entry.wakeRequested ? p_high_resolution_clock::now() : nextStepTime);
+        }
+
+        _stepDone.notify_all();
+    }
+}
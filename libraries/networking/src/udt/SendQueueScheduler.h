@@ -0,0 +1,88 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QtGlobal>
+
+#include <PortableHighResolutionClock.h>
+
+namespace udt {
+
+class SendQueue;
+
+/// Drives the SendQueues of a Socket from a small pool of pacing threads, instead of one thread per SendQueue.
+/// Queues are kept in a priority queue keyed on the time of their next step, and a pacing thread steps whichever
+/// queue is due first. A queue is only ever stepped by one pacing thread at a time.
+class SendQueueScheduler {
+public:
+    using TimePoint = p_high_resolution_clock::time_point;
+
+    SendQueueScheduler(int numThreads);
+    ~SendQueueScheduler();
+
+    int getNumThreads() const { return (int)_threads.size(); }
+
+    // starts stepping the queue, its first step is run as soon as a pacing thread is free
+    void add(SendQueue* queue);
+
+    // stops stepping the queue, blocks until any step in progress for it has completed
+    void remove(SendQueue* queue);
+
+    // asks for the next step of the queue to be run now instead of at its scheduled time
+    void wake(SendQueue* queue);
+
+private:
+    struct Entry {
+        quint64 generation { 0 }; // changes whenever the queue is re-scheduled, so stale steps can be skipped
+        TimePoint nextStepTime;
+        bool isScheduled { false };
+        bool isStepping { false };
+        bool wakeRequested { false };
+    };
+
+    struct ScheduledStep {
+        TimePoint time;
+        SendQueue* queue;
+        quint64 generation;
+
+        bool operator>(const ScheduledStep& other) const { return time > other.time; }
+    };
+
+    void run();
+    void schedule(SendQueue* queue, Entry& entry, TimePoint time);
+
+    std::mutex _mutex;
+    std::condition_variable _stepReady; // signalled when an earlier step is scheduled or we are stopping
+    std::condition_variable _stepDone; // signalled whenever a pacing thread completes a step
+
+    std::unordered_map<SendQueue*, Entry> _entries;
+    std::priority_queue<ScheduledStep, std::vector<ScheduledStep>, std::greater<ScheduledStep>> _steps;
+
+    quint64 _nextGeneration { 0 };
+
+    bool _stopping { false };
+    std::vector<std::thread> _threads;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
@@ -11,6 +11,25 @@
 
 #include "Socket.h"
 
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <string.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <sys/socket.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include <LogHandler.h>
@@ -172,6 +191,229 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const HifiSockAddr& soc
     return bytesWritten;
 }
 
+qint64 Socket::writeBatch(SendBatch& batch) {
+    // write the correct sequence numbers to the packets, in the order they were added
+    for (auto& datagram : batch._datagrams) {
+        datagram.packet->writeSequenceNumber(++_unreliableSequenceNumbers[datagram.destination]);
+    }
+
+    qint64 bytesWritten = 0;
+
+#ifdef Q_OS_LINUX
+    if (_isBatchedSendEnabled) {
+        bytesWritten = writeBatchedDatagrams(batch);
+        batch._datagrams.clear();
+        return bytesWritten;
+    }
+#endif
+
+    for (auto& datagram : batch._datagrams) {
+        auto datagramBytes = writeDatagram(datagram.packet->getData(), datagram.packet->getDataSize(), datagram.destination);
+
+        ++batch._numWriteSyscalls;
+
+        if (datagramBytes > 0) {
+            bytesWritten += datagramBytes;
+            ++batch._numWrittenDatagrams;
+        }
+    }
+
+    batch._datagrams.clear();
+    return bytesWritten;
+}
+
+#ifdef Q_OS_LINUX
+
+bool Socket::isSegmentationOffloadSupported() {
+    if (_segmentationOffloadSupport == 0) {
+        // kernels that know about UDP GSO (4.18+) answer for the UDP_SEGMENT option, older ones would silently
+        // ignore the control message and send every run of segments as one oversized datagram
+        int segmentSize = 0;
+        socklen_t optionLength = sizeof(segmentSize);
+        bool isSupported = getsockopt(_udpSocket.socketDescriptor(), SOL_UDP, UDP_SEGMENT, &segmentSize, &optionLength) == 0;
+
+        qCDebug(networking) << "UDP segmentation offload is" << (isSupported ? "supported" : "not supported");
+        _segmentationOffloadSupport = isSupported ? 1 : -1;
+    }
+
+    return _segmentationOffloadSupport > 0;
+}
+
+qint64 Socket::writeBatchedDatagrams(SendBatch& batch) {
+    auto& datagrams = batch._datagrams;
+    int socketDescriptor = _udpSocket.socketDescriptor();
+
+    // the batched path only talks IPv4, like the rest of the Socket
+    bool isIPv4 = std::all_of(datagrams.begin(), datagrams.end(), [](const SendBatch::Datagram& datagram) {
+        return datagram.destination.getAddress().protocol() == QAbstractSocket::IPv4Protocol;
+    });
+
+    if (socketDescriptor == -1 || !isIPv4) {
+        qint64 bytesWritten = 0;
+        for (auto& datagram : datagrams) {
+            auto datagramBytes = writeDatagram(datagram.packet->getData(), datagram.packet->getDataSize(), datagram.destination);
+            ++batch._numWriteSyscalls;
+            if (datagramBytes > 0) {
+                bytesWritten += datagramBytes;
+                ++batch._numWrittenDatagrams;
+            }
+        }
+        return bytesWritten;
+    }
+
+    static const int MAX_SEGMENTS_PER_MESSAGE = 64; // the kernel's UDP_MAX_SEGMENTS
+    static const int MAX_BYTES_PER_MESSAGE = 65507; // the largest UDP payload over IPv4
+    static const int MAX_MESSAGES_PER_SEND_SYSCALL = 1024; // UIO_MAXIOV
+    static const int SEGMENT_CONTROL_SIZE = CMSG_SPACE(sizeof(uint16_t));
+
+    struct SegmentControl {
+        alignas(cmsghdr) char buffer[SEGMENT_CONTROL_SIZE];
+    };
+
+    bool canSegment = isSegmentationOffloadSupported();
+
+    size_t numDatagrams = datagrams.size();
+    std::vector<mmsghdr> messages;
+    std::vector<iovec> messageVectors(numDatagrams);
+    std::vector<sockaddr_in> destinations;
+    std::vector<SegmentControl> segmentControls;
+    std::vector<std::pair<size_t, int>> messageDatagrams; // first datagram and number of datagrams in each message
+
+    messages.reserve(numDatagrams);
+    destinations.reserve(numDatagrams);
+    segmentControls.reserve(numDatagrams);
+    messageDatagrams.reserve(numDatagrams);
+
+    size_t datagramIndex = 0;
+    while (datagramIndex < numDatagrams) {
+        auto& first = datagrams[datagramIndex];
+        int segmentSize = (int)first.packet->getDataSize();
+
+        // gather a run of datagrams for the same destination that can go out as segments of one GSO message,
+        // every segment but the last has to be exactly the size of the first
+        int numSegments = 1;
+        int messageBytes = segmentSize;
+
+        if (canSegment) {
+            while (datagramIndex + numSegments < numDatagrams && numSegments < MAX_SEGMENTS_PER_MESSAGE) {
+                auto& next = datagrams[datagramIndex + numSegments];
+                int nextSize = (int)next.packet->getDataSize();
+
+                if (next.destination != first.destination || nextSize > segmentSize
+                    || messageBytes + nextSize > MAX_BYTES_PER_MESSAGE) {
+                    break;
+                }
+
+                ++numSegments;
+                messageBytes += nextSize;
+
+                if (nextSize < segmentSize) {
+                    // a shorter segment has to be the last one
+                    break;
+                }
+            }
+        }
+
+        for (int i = 0; i < numSegments; ++i) {
+            auto& packet = datagrams[datagramIndex + i].packet;
+            messageVectors[datagramIndex + i].iov_base = const_cast<char*>(packet->getData());
+            messageVectors[datagramIndex + i].iov_len = packet->getDataSize();
+        }
+
+        sockaddr_in destination;
+        memset(&destination, 0, sizeof(destination));
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(first.destination.getPort());
+        destination.sin_addr.s_addr = htonl(first.destination.getAddress().toIPv4Address());
+        destinations.push_back(destination);
+
+        mmsghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_hdr.msg_name = &destinations.back();
+        message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+        message.msg_hdr.msg_iov = &messageVectors[datagramIndex];
+        message.msg_hdr.msg_iovlen = numSegments;
+
+        if (numSegments > 1) {
+            segmentControls.emplace_back();
+            message.msg_hdr.msg_control = segmentControls.back().buffer;
+            message.msg_hdr.msg_controllen = SEGMENT_CONTROL_SIZE;
+
+            cmsghdr* control = CMSG_FIRSTHDR(&message.msg_hdr);
+            control->cmsg_level = SOL_UDP;
+            control->cmsg_type = UDP_SEGMENT;
+            control->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+
+            uint16_t segmentSizeOption = segmentSize;
+            memcpy(CMSG_DATA(control), &segmentSizeOption, sizeof(segmentSizeOption));
+        }
+
+        messages.push_back(message);
+        messageDatagrams.push_back({ datagramIndex, numSegments });
+
+        datagramIndex += numSegments;
+    }
+
+    qint64 bytesWritten = 0;
+    size_t messageIndex = 0;
+
+    while (messageIndex < messages.size()) {
+        int numMessages = (int)std::min(messages.size() - messageIndex, (size_t)MAX_MESSAGES_PER_SEND_SYSCALL);
+        int numSent = sendmmsg(socketDescriptor, &messages[messageIndex], numMessages, 0);
+
+        ++batch._numWriteSyscalls;
+
+        if (numSent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            auto& failedMessage = messageDatagrams[messageIndex];
+
+            if (failedMessage.second > 1 && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT)) {
+                // the kernel or the network device can't segment for us after all - stop trying and write the rest of
+                // the batch one datagram at a time
+                qCDebug(networking) << "sendmmsg with UDP segmentation failed with error" << errno
+                    << "- no longer segmenting datagrams";
+                _segmentationOffloadSupport = -1;
+
+                for (size_t i = failedMessage.first; i < numDatagrams; ++i) {
+                    auto& datagram = datagrams[i];
+                    auto datagramBytes = writeDatagram(datagram.packet->getData(), datagram.packet->getDataSize(),
+                                                       datagram.destination);
+                    ++batch._numWriteSyscalls;
+                    if (datagramBytes > 0) {
+                        bytesWritten += datagramBytes;
+                        ++batch._numWrittenDatagrams;
+                    }
+                }
+
+                return bytesWritten;
+            }
+
+            // like a failed writeDatagram, the message that could not be written is dropped
+            static const QString WRITE_ERROR_REGEX = "Socket::writeBatch sendmmsg failed with error [0-9]+";
+            static QString repeatedMessage = LogHandler::getInstance().addRepeatedMessageRegex(WRITE_ERROR_REGEX);
+
+            qCDebug(networking) << "Socket::writeBatch sendmmsg failed with error" << errno;
+
+            ++messageIndex;
+            continue;
+        }
+
+        for (int i = 0; i < numSent; ++i) {
+            bytesWritten += messages[messageIndex + i].msg_len;
+            batch._numWrittenDatagrams += messageDatagrams[messageIndex + i].second;
+        }
+
+        messageIndex += numSent;
+    }
+
+    return bytesWritten;
+}
+
+#endif
+
 Connection& Socket::findOrCreateConnection(const HifiSockAddr& sockAddr) {
     auto it = _connectionsHash.find(sockAddr);
 
@@ -235,66 +477,145 @@ void Socket::readPendingDatagrams() {
         HifiSockAddr senderSockAddr;
         
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
        
         // pull the datagram
         auto sizeRead = _udpSocket.readDatagram(buffer.get(), packetSizeWithHeader,
                                                 senderSockAddr.getAddressPointer(), senderSockAddr.getPortPointer());
 
+        ++_numReceiveSyscalls;
+
         if (sizeRead <= 0) {
             // we either didn't pull anything for this packet or there was an error reading (this seems to trigger
             // on windows even if there's not a packet available)
             continue;
         }
+
+        ++_numReceivedDatagrams;
         
-        auto it = _unfilteredHandlers.find(senderSockAddr);
-        
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this HifiSockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                it->second(std::move(basePacket));
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+
+#ifdef Q_OS_LINUX
+        if (_isBatchedReceiveEnabled) {
+            // the readDatagram call above has re-armed the read notifications of the QUdpSocket,
+            // so whatever else is waiting can be pulled in batches straight from the socket descriptor
+            readPendingDatagramsBatched();
+        }
+#endif
+    }
+}
+
+#ifdef Q_OS_LINUX
+
+void Socket::readPendingDatagramsBatched() {
+    int socketDescriptor = _udpSocket.socketDescriptor();
+    if (socketDescriptor == -1) {
+        return;
+    }
+
+    mmsghdr messages[MAX_DATAGRAMS_PER_RECEIVE_SYSCALL];
+    iovec messageVectors[MAX_DATAGRAMS_PER_RECEIVE_SYSCALL];
+    sockaddr_storage senderAddresses[MAX_DATAGRAMS_PER_RECEIVE_SYSCALL];
+
+    while (true) {
+        for (int i = 0; i < MAX_DATAGRAMS_PER_RECEIVE_SYSCALL; ++i) {
+            // replace the buffers that were handed off to packets during the last batch
+            if (!_receiveBuffers[i]) {
+                _receiveBuffers[i] = PacketBufferPool::allocate(MAX_PACKET_SIZE);
             }
-            
-            continue;
+
+            messageVectors[i].iov_base = _receiveBuffers[i].get();
+            messageVectors[i].iov_len = MAX_PACKET_SIZE;
+
+            memset(&messages[i], 0, sizeof(mmsghdr));
+            messages[i].msg_hdr.msg_iov = &messageVectors[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+            messages[i].msg_hdr.msg_name = &senderAddresses[i];
+            messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        }
+
+        int numReceived = recvmmsg(socketDescriptor, messages, MAX_DATAGRAMS_PER_RECEIVE_SYSCALL, MSG_DONTWAIT, nullptr);
+
+        if (numReceived <= 0) {
+            // EAGAIN means we've read everything that was waiting, anything else we'll leave for the regular path
+            if (numReceived < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                qCDebug(networking) << "recvmmsg failed with error" << errno << "- falling back to reading one datagram at a time";
+                _isBatchedReceiveEnabled = false;
+            }
+            return;
+        }
+
+        ++_numReceiveSyscalls;
+        _numReceivedDatagrams += numReceived;
+
+        for (int i = 0; i < numReceived; ++i) {
+            if (messages[i].msg_len == 0 || (messages[i].msg_hdr.msg_flags & MSG_TRUNC)) {
+                // this datagram was empty or too large to be one of our packets, drop it and keep the buffer
+                continue;
+            }
+
+            HifiSockAddr senderSockAddr(reinterpret_cast<const sockaddr*>(&senderAddresses[i]));
+            processDatagram(std::move(_receiveBuffers[i]), messages[i].msg_len, senderSockAddr);
+        }
+
+        if (numReceived < MAX_DATAGRAMS_PER_RECEIVE_SYSCALL) {
+            // the socket is drained
+            return;
+        }
+    }
+}
+
+#endif
+
+void Socket::processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader,
+                             const HifiSockAddr& senderSockAddr) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+    
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this HifiSockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            it->second(std::move(basePacket));
         }
         
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        return;
+    }
+    
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+    
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
         
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            
-            // move this control packet to the matching connection
-            auto& connection = findOrCreateConnection(senderSockAddr);
-            connection.processControl(move(controlPacket));
-            
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
-                    auto& connection = findOrCreateConnection(senderSockAddr);
-
-                    if (!connection.processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                  packet->getDataSize(),
-                                                                  packet->getPayloadSize())) {
-                        // the connection indicated that we should not continue processing this packet
-                        continue;
-                    }
+        // move this control packet to the matching connection
+        auto& connection = findOrCreateConnection(senderSockAddr);
+        connection.processControl(move(controlPacket));
+        
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isReliable()) {
+                // if this was a reliable packet then signal the matching connection with the sequence number
+                auto& connection = findOrCreateConnection(senderSockAddr);
+
+                if (!connection.processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                              packet->getDataSize(),
+                                                              packet->getPayloadSize())) {
+                    // the connection indicated that we should not continue processing this packet
+                    return;
                 }
+            }
 
-                if (packet->isPartOfMessage()) {
-                    auto& connection = findOrCreateConnection(senderSockAddr);
-                    connection.queueReceivedMessagePacket(std::move(packet));
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
+            if (packet->isPartOfMessage()) {
+                auto& connection = findOrCreateConnection(senderSockAddr);
+                connection.queueReceivedMessagePacket(std::move(packet));
+            } else if (_packetHandler) {
+                // call the verified packet callback to let it handle this packet
+                _packetHandler(std::move(packet));
             }
         }
     }
@@ -363,13 +684,47 @@ void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     }
 }
 
+bool Socket::setNumSendQueueThreads(int numThreads) {
+    if (QThread::currentThread() != thread()) {
+        bool result;
+        QMetaObject::invokeMethod(this, "setNumSendQueueThreads", Qt::BlockingQueuedConnection,
+                                  Q_RETURN_ARG(bool, result), Q_ARG(int, numThreads));
+        return result;
+    }
+
+    if (_sendQueueScheduler && !_connectionsHash.empty()) {
+        // the SendQueues of the existing connections hold on to the current scheduler
+        qCWarning(networking) << "Cannot change how SendQueues are paced once connections are paced by a scheduler";
+        return false;
+    }
+
+    if (!_connectionsHash.empty()) {
+        qCDebug(networking) << _connectionsHash.size() << "existing connections keep a SendQueue thread each";
+    }
+
+    if (numThreads > 0) {
+        _sendQueueScheduler.reset(new SendQueueScheduler(numThreads));
+    } else {
+        _sendQueueScheduler.reset();
+    }
+    return true;
+}
+
 ConnectionStats::Stats Socket::sampleStatsForConnection(const HifiSockAddr& destination) {
+    ConnectionStats::Stats stats;
+
     auto it = _connectionsHash.find(destination);
     if (it != _connectionsHash.end()) {
-        return it->second->sampleStats();
-    } else {
-        return ConnectionStats::Stats();
+        stats = it->second->sampleStats();
     }
+
+    stats.receiveSyscalls = _numReceiveSyscalls;
+    stats.receivedDatagrams = _numReceivedDatagrams;
+
+    _numReceiveSyscalls = 0;
+    _numReceivedDatagrams = 0;
+
+    return stats;
 }
 
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
@@ -377,7 +732,15 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
     result.reserve(_connectionsHash.size());
     for (const auto& connectionPair : _connectionsHash) {
         result.emplace_back(connectionPair.first, connectionPair.second->sampleStats());
+
+        // the receive syscall counts are for the whole socket, every connection reports the same sample
+        result.back().second.receiveSyscalls = _numReceiveSyscalls;
+        result.back().second.receivedDatagrams = _numReceivedDatagrams;
     }
+
+    _numReceiveSyscalls = 0;
+    _numReceivedDatagrams = 0;
+
     return result;
 }
 
@@ -14,7 +14,9 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <unordered_map>
 
 #include <QtCore/QObject>
@@ -24,6 +26,8 @@
 #include "../HifiSockAddr.h"
 #include "CongestionControl.h"
 #include "Connection.h"
+#include "SendBatch.h"
+#include "SendQueueScheduler.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -59,6 +63,10 @@ public:
     qint64 writePacketList(std::unique_ptr<PacketList> packetList, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const char* data, qint64 size, const HifiSockAddr& sockAddr);
     qint64 writeDatagram(const QByteArray& datagram, const HifiSockAddr& sockAddr);
+
+    // writes and empties the batch - on Linux with sendmmsg, sending runs of MTU-sized packets to the same destination
+    // as a single UDP GSO message where the kernel supports it, elsewhere one datagram at a time
+    qint64 writeBatch(SendBatch& batch);
     
     void bind(const QHostAddress& address, quint16 port = 0) { _udpSocket.bind(address, port); setSystemBufferSizes(); }
     void rebind();
@@ -79,9 +87,22 @@ public:
     
     StatsVector sampleStatsForAllConnections();
 
+    // reading several datagrams per syscall is only available on Linux, where it is on by default
+    void setBatchedReceiveEnabled(bool enabled) { _isBatchedReceiveEnabled = enabled; }
+
+    // the same goes for writing a SendBatch with several datagrams per syscall
+    void setBatchedSendEnabled(bool enabled) { _isBatchedSendEnabled = enabled; }
+
+    SendQueueScheduler* getSendQueueScheduler() const { return _sendQueueScheduler.get(); }
+
 public slots:
     void cleanupConnection(HifiSockAddr sockAddr);
     void clearConnections();
+
+    // with a number of threads > 0 the SendQueues of reliable connections are paced by a shared pool of that many
+    // threads instead of running one thread each - connections that already exist keep their own threads.
+    // Returns false if the pool could not be changed because connections are already paced by it.
+    bool setNumSendQueueThreads(int numThreads);
     
 private slots:
     void readPendingDatagrams();
@@ -90,6 +111,14 @@ private slots:
 private:
     void setSystemBufferSizes();
     Connection& findOrCreateConnection(const HifiSockAddr& sockAddr);
+
+    void processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const HifiSockAddr& senderSockAddr);
+
+#ifdef Q_OS_LINUX
+    void readPendingDatagramsBatched();
+    qint64 writeBatchedDatagrams(SendBatch& batch);
+    bool isSegmentationOffloadSupported();
+#endif
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const HifiSockAddr& destination);
@@ -108,12 +137,35 @@ private:
     
     std::unordered_map<HifiSockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<HifiSockAddr, SequenceNumber> _unreliableSequenceNumbers;
+
+    // declared before the connections so that it outlives the SendQueues it steps
+    std::unique_ptr<SendQueueScheduler> _sendQueueScheduler;
+
     std::unordered_map<HifiSockAddr, std::unique_ptr<Connection>> _connectionsHash;
     
     int _synInterval { 10 }; // 10ms
     QTimer* _synTimer { nullptr };
 
     int _maxBandwidth { -1 };
+
+#ifdef Q_OS_LINUX
+    static const int MAX_DATAGRAMS_PER_RECEIVE_SYSCALL = 64;
+
+    // buffers the batched receive path reads into, each one is handed off to the packet built on it
+    // and replaced before the next batch
+    PacketBuffer _receiveBuffers[MAX_DATAGRAMS_PER_RECEIVE_SYSCALL];
+    bool _isBatchedReceiveEnabled { true };
+
+    // batches are written from whichever thread owns them, so these are atomic
+    std::atomic<bool> _isBatchedSendEnabled { true };
+    std::atomic<int> _segmentationOffloadSupport { 0 }; // 0 until probed, then 1 if supported and -1 if not
+#else
+    bool _isBatchedReceiveEnabled { false };
+    std::atomic<bool> _isBatchedSendEnabled { false };
+#endif
+
+    int _numReceiveSyscalls { 0 };
+    int _numReceivedDatagrams { 0 };
     
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<DefaultCC>() };
     
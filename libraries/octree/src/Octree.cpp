@@ -49,7 +49,10 @@
 #include "OctreeLogging.h"
 
 
-QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"svo", "json", "json.gz", "bin"};
+
+const char BINARY_PERSIST_MAGIC[] = { 'H', 'F', 'O', 'B' };
+const quint32 BINARY_PERSIST_FORMAT_VERSION = 1;
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -1632,6 +1635,10 @@ bool Octree::readFromFile(const char* fileName) {
         return readJSONFromGzippedFile(qFileName);
     }
 
+    if (qFileName.endsWith(".bin")) {
+        return readBinaryFromFile(qFileName);
+    }
+
     QFile file(qFileName);
 
     if (!file.open(QIODevice::ReadOnly)) {
@@ -1885,22 +1892,24 @@ void Octree::writeToFile(const char* fileName, OctreeElementPointer element, QSt
         writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        writeToBinaryFile(cFileName, element);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
 }
 
 void Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element, bool doGzip) {
-    QVariantMap entityDescription;
-
     qCDebug(octree, "Saving JSON SVO to file %s...", fileName);
 
-    OctreeElementPointer top;
-    if (element) {
-        top = element;
-    } else {
-        top = _rootElement;
-    }
+    OctreeElementPointer top = element ? element : _rootElement;
+    saveJSONFile(fileName, doGzip, [&](QVariantMap& entityDescription) {
+        return writeToMap(entityDescription, top, true, true);
+    });
+}
+
+bool Octree::saveJSONFile(const char* fileName, bool doGzip, const std::function<bool(QVariantMap&)>& writeItems) {
+    QVariantMap entityDescription;
 
     // include the "bitstream" version
     PacketType expectedType = expectedDataPacketType();
@@ -1908,10 +1917,10 @@ void Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
     entityDescription["Version"] = (int) expectedVersion;
 
     // store the entity data
-    bool entityDescriptionSuccess = writeToMap(entityDescription, top, true, true);
+    bool entityDescriptionSuccess = writeItems(entityDescription);
     if (!entityDescriptionSuccess) {
         qCritical("Failed to convert Entities to QVariantMap while saving to json.");
-        return;
+        return false;
     }
 
     // convert the QVariantMap to JSON
@@ -1921,7 +1930,7 @@ void Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
     if (doGzip) {
         if (!gzip(jsonData, jsonDataForFile, -1)) {
             qCritical("unable to gzip data while saving to json.");
-            return;
+            return false;
         }
     } else {
         jsonDataForFile = jsonData;
@@ -1932,7 +1941,99 @@ void Octree::writeToJSONFile(const char* fileName, OctreeElementPointer element,
         persistFile.write(jsonDataForFile);
     } else {
         qCritical("Could not write to JSON description of entities.");
+        return false;
+    }
+    return true;
+}
+
+void Octree::writeToBinaryFile(const char* fileName, OctreeElementPointer element) {
+    qCDebug(octree, "Saving binary Octree to file %s...", fileName);
+
+    OctreeElementPointer top = element ? element : _rootElement;
+    saveBinaryFile(fileName, [&](QDataStream& persistStream) {
+        return writeToBinaryStream(persistStream, top);
+    });
+}
+
+bool Octree::saveBinaryFile(const char* fileName, const std::function<bool(QDataStream&)>& writeItems) {
+    QFile persistFile(fileName);
+    if (!persistFile.open(QIODevice::WriteOnly)) {
+        qCritical("Could not write binary Octree file.");
+        return false;
+    }
+
+    QDataStream persistStream(&persistFile);
+    persistStream.writeRawData(BINARY_PERSIST_MAGIC, sizeof(BINARY_PERSIST_MAGIC));
+
+    // include the "bitstream" version, the items are stored in the same encoding we send them in
+    PacketType expectedType = expectedDataPacketType();
+    PacketVersion expectedVersion = versionForPacketType(expectedType);
+    persistStream << BINARY_PERSIST_FORMAT_VERSION << (quint8)expectedType << (quint8)expectedVersion;
+
+    if (!writeItems(persistStream) || persistStream.status() != QDataStream::Ok) {
+        qCritical() << "Failed to write binary Octree file:" << persistFile.errorString();
+        return false;
     }
+    return true;
+}
+
+bool Octree::writeSnapshotToFile(const char* fileName, OctreeSnapshotPointer snapshot, QString persistAsFileType) {
+    // make the sure file extension makes sense
+    QString qFileName = fileNameWithoutExtension(QString(fileName), PERSIST_EXTENSIONS) + "." + persistAsFileType;
+    QByteArray byteArray = qFileName.toUtf8();
+    const char* cFileName = byteArray.constData();
+
+    qCDebug(octree) << "Saving snapshot of" << snapshot->getNumItems() << "items to file" << qFileName << "...";
+
+    if (persistAsFileType == "json" || persistAsFileType == "json.gz") {
+        return saveJSONFile(cFileName, persistAsFileType == "json.gz", [&](QVariantMap& entityDescription) {
+            return snapshot->writeToMap(entityDescription, true);
+        });
+    } else if (persistAsFileType == "bin") {
+        return saveBinaryFile(cFileName, [&](QDataStream& persistStream) {
+            return snapshot->writeToBinaryStream(persistStream);
+        });
+    }
+
+    qCDebug(octree) << "unable to write octree snapshot to file of type" << persistAsFileType;
+    return false;
+}
+
+bool Octree::readBinaryFromFile(QString qFileName) {
+    QFile file(qFileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCritical() << "Cannot open binary Octree file for reading: " << qFileName;
+        return false;
+    }
+
+    QDataStream fileStream(&file);
+
+    char magic[sizeof(BINARY_PERSIST_MAGIC)];
+    quint32 formatVersion = 0;
+    quint8 packetType = 0;
+    quint8 bitstreamVersion = 0;
+
+    if (fileStream.readRawData(magic, sizeof(magic)) != sizeof(magic)
+        || memcmp(magic, BINARY_PERSIST_MAGIC, sizeof(magic)) != 0) {
+        qCritical() << "Binary Octree file has an unknown format: " << qFileName;
+        return false;
+    }
+
+    fileStream >> formatVersion >> packetType >> bitstreamVersion;
+    if (formatVersion > BINARY_PERSIST_FORMAT_VERSION || (PacketType)packetType != expectedDataPacketType()
+        || !canProcessVersion(bitstreamVersion)) {
+        qCritical() << "Binary Octree file" << qFileName << "has format version" << formatVersion
+            << "packet type" << packetType << "bitstream version" << bitstreamVersion << "which we can't read.";
+        return false;
+    }
+
+    qCDebug(octree) << "Loading binary file" << qFileName << "...";
+
+    emit importProgress(0);
+    bool success = readFromBinaryStream(fileStream, bitstreamVersion);
+    emit importProgress(100);
+
+    return success;
 }
 
 void Octree::writeToSVOFile(const char* fileName, OctreeElementPointer element) {
@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <functional>
 #include <memory>
 #include <set>
 
@@ -25,6 +26,7 @@
 #include "ViewFrustum.h"
 #include "OctreeElement.h"
 #include "OctreeElementBag.h"
+#include "OctreeJournal.h"
 #include "OctreePacketData.h"
 #include "OctreeSceneStats.h"
 
@@ -37,6 +39,25 @@ using OctreePointer = std::shared_ptr<Octree>;
 
 extern QVector<QString> PERSIST_EXTENSIONS;
 
+/// A consistent copy of the items in an Octree, taken while holding its read lock, that can be written out after
+/// the lock is released. Edits made to the tree after the snapshot was taken never show up in it.
+class OctreeSnapshot {
+public:
+    virtual ~OctreeSnapshot() {}
+    virtual int getNumItems() const = 0;
+    virtual bool writeToMap(QVariantMap& entityDescription, bool skipDefaultValues) = 0;
+    virtual bool writeToBinaryStream(QDataStream& outputStream) = 0;
+};
+using OctreeSnapshotPointer = std::shared_ptr<OctreeSnapshot>;
+
+/// One record of an inbound edit packet, decoded and validated by Octree::decodeEditPacketData() without holding the
+/// tree's lock, so that a batch of them can be applied with Octree::applyEdit() under a single write lock.
+class OctreeEdit {
+public:
+    virtual ~OctreeEdit() {}
+};
+using OctreeEditPointer = std::unique_ptr<OctreeEdit>;
+
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
 class RecurseOctreeOperator {
 public:
@@ -220,6 +241,15 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // Decode one edit record without touching the tree, setting bytesRead to the size of the record. Returns nullptr if
+    // the record should be ignored. The returned edit is applied later with applyEdit() while holding the write lock.
+    virtual OctreeEditPointer decodeEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& sourceNode, int& bytesRead) {
+        bytesRead = 0;
+        return OctreeEditPointer();
+    }
+    virtual void applyEdit(OctreeEdit& edit) { }
                     
     virtual bool recurseChildrenWithData() const { return true; }
     virtual bool rootElementHasData() const { return false; }
@@ -304,8 +334,14 @@ public:
     void writeToFile(const char* filename, OctreeElementPointer element = NULL, QString persistAsFileType = "svo");
     void writeToJSONFile(const char* filename, OctreeElementPointer element = NULL, bool doGzip = false);
     void writeToSVOFile(const char* filename, OctreeElementPointer element = NULL);
+    void writeToBinaryFile(const char* filename, OctreeElementPointer element = NULL);
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
+    virtual bool writeToBinaryStream(QDataStream& outputStream, OctreeElementPointer element) { return false; }
+
+    // Snapshot support, lets long readers like the OctreePersistThread write the tree out without holding its lock.
+    virtual OctreeSnapshotPointer takeSnapshot() { return OctreeSnapshotPointer(); } // callers must hold the read lock
+    bool writeSnapshotToFile(const char* filename, OctreeSnapshotPointer snapshot, QString persistAsFileType);
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -314,7 +350,16 @@ public:
     bool readSVOFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromStream(unsigned long streamLength, QDataStream& inputStream);
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readBinaryFromFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription) = 0;
+    virtual bool readFromBinaryStream(QDataStream& inputStream, PacketVersion bitstreamVersion) { return false; }
+
+    // Write-ahead journal support, lets the OctreePersistThread save changes without rewriting the whole tree.
+    // While journaling is on the tree tracks what changed, and writes those changes out as journal records.
+    virtual bool canJournalChanges() const { return false; }
+    virtual void setJournalChanges(bool journalChanges) { }
+    virtual int writeJournalRecords(OctreeJournal& journal) { return 0; } // callers must hold the read lock
+    virtual int replayJournal(OctreeJournal& journal) { return 0; } // callers must hold the write lock
 
     unsigned long getOctreeElementsCount();
 
@@ -376,6 +421,10 @@ protected:
     int readElementData(OctreeElementPointer destinationElement, const unsigned char* nodeData,
                 int bufferSizeBytes, ReadBitstreamToTreeParams& args);
 
+    // write the file headers, then call the writer for the items themselves
+    bool saveJSONFile(const char* fileName, bool doGzip, const std::function<bool(QVariantMap&)>& writeItems);
+    bool saveBinaryFile(const char* fileName, const std::function<bool(QDataStream&)>& writeItems);
+
     OctreeElementPointer _rootElement = nullptr;
 
     bool _isDirty;
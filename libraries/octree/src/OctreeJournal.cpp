@@ -0,0 +1,137 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QtEndian>
+
+#ifdef Q_OS_UNIX
+#include <unistd.h>
+#endif
+
+#include "OctreeLogging.h"
+
+OctreeJournal::OctreeJournal(const QString& filename) :
+    _filename(filename)
+{
+}
+
+bool OctreeJournal::exists() const {
+    return QFile::exists(_filename);
+}
+
+qint64 OctreeJournal::getSize() const {
+    return QFileInfo(_filename).size();
+}
+
+void OctreeJournal::append(RecordType type, const QUuid& id, const QByteArray& data) {
+    QByteArray body;
+    body.reserve(sizeof(quint8) + RECORD_ID_SIZE + data.size());
+    body.append((char)type);
+    body.append(id.toRfc4122());
+    body.append(data);
+
+    char header[RECORD_HEADER_SIZE];
+    qToLittleEndian<quint32>((quint32)data.size(), reinterpret_cast<uchar*>(header));
+    qToLittleEndian<quint16>(qChecksum(body.constData(), body.size()), reinterpret_cast<uchar*>(header + sizeof(quint32)));
+
+    _pendingRecords.append(header, RECORD_HEADER_SIZE);
+    _pendingRecords.append(body);
+    ++_numPendingRecords;
+}
+
+bool OctreeJournal::flush() {
+    if (_numPendingRecords == 0) {
+        return true;
+    }
+
+    QFile file(_filename);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qCWarning(octree) << "Unable to open journal" << _filename << "for writing:" << file.errorString();
+        return false;
+    }
+
+    if (file.write(_pendingRecords) != _pendingRecords.size() || !file.flush()) {
+        qCWarning(octree) << "Failed to write" << _numPendingRecords << "records to journal" << _filename
+            << ":" << file.errorString();
+        return false;
+    }
+
+#ifdef Q_OS_UNIX
+    // the records are only durable once they have reached the disk
+    ::fsync(file.handle());
+#endif
+
+    _pendingRecords.clear();
+    _numPendingRecords = 0;
+    return true;
+}
+
+int OctreeJournal::replay(const RecordHandler& handler) {
+    QFile file(_filename);
+    if (!file.open(QIODevice::ReadWrite)) {
+        return 0;
+    }
+
+    const QByteArray contents = file.readAll();
+    const char* data = contents.constData();
+    const int size = contents.size();
+
+    int offset = 0;
+    int numRecords = 0;
+
+    while (size - offset >= RECORD_HEADER_SIZE) {
+        quint32 dataSize = qFromLittleEndian<quint32>(reinterpret_cast<const uchar*>(data + offset));
+        quint16 checksum = qFromLittleEndian<quint16>(reinterpret_cast<const uchar*>(data + offset + sizeof(quint32)));
+
+        const char* body = data + offset + RECORD_HEADER_SIZE;
+        qint64 bodySize = sizeof(quint8) + RECORD_ID_SIZE + (qint64)dataSize;
+
+        if (bodySize > size - offset - RECORD_HEADER_SIZE || qChecksum(body, (uint)bodySize) != checksum) {
+            break;
+        }
+
+        Record record;
+        record.type = (RecordType)body[0];
+        record.id = QUuid::fromRfc4122(QByteArray::fromRawData(body + sizeof(quint8), RECORD_ID_SIZE));
+        record.data = QByteArray(body + sizeof(quint8) + RECORD_ID_SIZE, dataSize);
+
+        handler(record);
+
+        offset += RECORD_HEADER_SIZE + (int)bodySize;
+        ++numRecords;
+    }
+
+    if (offset < size) {
+        // we were interrupted part way through writing the last records, drop them so new records follow intact ones
+        qCWarning(octree) << "Dropping" << (size - offset) << "bytes of incomplete records from journal" << _filename;
+        file.resize(offset);
+    }
+
+    return numRecords;
+}
+
+bool OctreeJournal::truncate() {
+    _pendingRecords.clear();
+    _numPendingRecords = 0;
+
+    QFile file(_filename);
+    if (!file.exists()) {
+        return true;
+    }
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Unable to truncate journal" << _filename << ":" << file.errorString();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,72 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+
+/// Append-only binary log of changes made to an Octree since its last persisted snapshot.
+/// Every record holds the complete state of one item (or its removal), so replaying a record more than once,
+/// or on top of a snapshot that already holds it, is harmless.
+///
+/// Each record is laid out as:
+///     quint32 dataSize | quint16 checksum | quint8 type | 16 byte id (RFC 4122) | data
+/// where the checksum covers everything after it. A record cut short by a crash fails its checksum, and is dropped
+/// along with anything after it the next time the journal is replayed.
+class OctreeJournal {
+public:
+    enum RecordType : quint8 {
+        UpsertRecord = 1,  // data holds the complete state of the item
+        EraseRecord = 2    // the item was removed, data is empty
+    };
+
+    struct Record {
+        RecordType type;
+        QUuid id;
+        QByteArray data;
+    };
+
+    using RecordHandler = std::function<void(const Record& record)>;
+
+    OctreeJournal(const QString& filename);
+
+    const QString& getFilename() const { return _filename; }
+
+    bool exists() const;
+    qint64 getSize() const;
+
+    /// queues a record, nothing is written until the next flush()
+    void append(RecordType type, const QUuid& id, const QByteArray& data = QByteArray());
+    int getNumPendingRecords() const { return _numPendingRecords; }
+
+    /// appends queued records to the journal file
+    bool flush();
+
+    /// calls the handler for every intact record in the order they were written, returns the number of records read
+    int replay(const RecordHandler& handler);
+
+    /// drops every record, call this once a snapshot holding all of them has been written
+    bool truncate();
+
+private:
+    static const int RECORD_HEADER_SIZE = sizeof(quint32) + sizeof(quint16);
+    static const int RECORD_ID_SIZE = 16;
+
+    QString _filename;
+    QByteArray _pendingRecords;
+    int _numPendingRecords { 0 };
+};
+
+#endif // hifi_OctreeJournal_h
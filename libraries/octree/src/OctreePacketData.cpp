@@ -9,6 +9,8 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 
+#include <limits>
+
 #include <GLMHelpers.h>
 #include <PerfStat.h>
 
@@ -29,7 +31,9 @@ struct aaCubeData {
     float scale;
 };
 
-OctreePacketData::OctreePacketData(bool enableCompression, int targetSize) {
+OctreePacketData::OctreePacketData(bool enableCompression, int targetSize) :
+    _uncompressed(MAX_OCTREE_UNCOMRESSED_PACKET_SIZE)
+{
     changeSettings(enableCompression, targetSize); // does reset...
 }
 
@@ -39,6 +43,15 @@ void OctreePacketData::changeSettings(bool enableCompression, unsigned int targe
     reset();
 }
 
+void OctreePacketData::changeOversizedTargetSize(unsigned int targetSize) {
+    _enableCompression = false;
+    _targetSize = std::min(MAX_OCTREE_OVERSIZED_DATA_SIZE, targetSize);
+    if (_uncompressed.size() < _targetSize) {
+        _uncompressed.resize(_targetSize);
+    }
+    reset();
+}
+
 void OctreePacketData::reset() {
     _bytesInUse = 0;
     _bytesAvailable = _targetSize;
@@ -386,6 +399,9 @@ bool OctreePacketData::appendValue(const glm::vec3& value) {
 }
 
 bool OctreePacketData::appendValue(const QVector<glm::vec3>& value) {
+    if (value.size() > std::numeric_limits<uint16_t>::max()) {
+        return false; // the count would not survive its uint16_t prefix
+    }
     uint16_t qVecSize = value.size();
     bool success = appendValue(qVecSize);
     if (success) {
@@ -399,11 +415,15 @@ bool OctreePacketData::appendValue(const QVector<glm::vec3>& value) {
 }
 
 bool OctreePacketData::appendValue(const QVector<glm::quat>& value) {
+    if (value.size() > std::numeric_limits<uint16_t>::max()) {
+        return false; // the count would not survive its uint16_t prefix
+    }
     uint16_t qVecSize = value.size();
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
+        // packed quats are smaller than glm::quats, and oversized data can hold more of them than fit in a packet
+        QByteArray dataByteArray(std::max((int)udt::MAX_PACKET_SIZE, value.size() * (int)sizeof(glm::quat)), 0);
         unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
         unsigned char* destinationBuffer = start;
         for (int index = 0; index < value.size(); index++) {
@@ -421,6 +441,9 @@ bool OctreePacketData::appendValue(const QVector<glm::quat>& value) {
 }
 
 bool OctreePacketData::appendValue(const QVector<float>& value) {
+    if (value.size() > std::numeric_limits<uint16_t>::max()) {
+        return false; // the count would not survive its uint16_t prefix
+    }
     uint16_t qVecSize = value.size();
     bool success = appendValue(qVecSize);
     if (success) {
@@ -434,11 +457,14 @@ bool OctreePacketData::appendValue(const QVector<float>& value) {
 }
 
 bool OctreePacketData::appendValue(const QVector<bool>& value) {
+    if (value.size() > std::numeric_limits<uint16_t>::max()) {
+        return false; // the count would not survive its uint16_t prefix
+    }
     uint16_t qVecSize = value.size();
     bool success = appendValue(qVecSize);
 
     if (success) {
-        QByteArray dataByteArray(udt::MAX_PACKET_SIZE, 0);
+        QByteArray dataByteArray(std::max((int)udt::MAX_PACKET_SIZE, value.size() / BITS_IN_BYTE + 1), 0);
         unsigned char* start = reinterpret_cast<unsigned char*>(dataByteArray.data());
         unsigned char* destinationBuffer = start;
         int bit = 0;
@@ -485,6 +511,9 @@ bool OctreePacketData::appendValue(bool value) {
 
 bool OctreePacketData::appendValue(const QString& string) {
     // TODO: make this a ByteCountCoded leading byte
+    if (string.size() + 1 > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
     uint16_t length = string.size() + 1; // include NULL
     bool success = appendValue(length);
     if (success) {
@@ -509,6 +538,9 @@ bool OctreePacketData::appendValue(const QUuid& uuid) {
 
 bool OctreePacketData::appendValue(const QByteArray& bytes) {
     // TODO: make this a ByteCountCoded leading byte
+    if (bytes.size() > std::numeric_limits<uint16_t>::max()) {
+        return false;
+    }
     uint16_t length = bytes.size();
     bool success = appendValue(length);
     if (success) {
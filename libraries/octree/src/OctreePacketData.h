@@ -23,6 +23,7 @@
 #define hifi_OctreePacketData_h
 
 #include <atomic>
+#include <vector>
 
 #include <QByteArray>
 #include <QString>
@@ -53,6 +54,9 @@ const unsigned int MAX_OCTREE_PACKET_DATA_SIZE =
     udt::MAX_PACKET_SIZE - (NLPacket::MAX_PACKET_HEADER_SIZE + OCTREE_PACKET_EXTRA_HEADERS_SIZE);
 const unsigned int MAX_OCTREE_UNCOMRESSED_PACKET_SIZE = MAX_OCTREE_PACKET_DATA_SIZE;
 
+// largest uncompressed size for data that is written to files instead of packets, see changeOversizedTargetSize()
+const unsigned int MAX_OCTREE_OVERSIZED_DATA_SIZE = 1024 * 1024;
+
 const unsigned int MINIMUM_ATTEMPT_MORE_PACKING = sizeof(OCTREE_PACKET_INTERNAL_SECTION_SIZE) + 40;
 const unsigned int COMPRESS_PADDING = 15;
 const int REASONABLE_NUMBER_OF_PACKING_ATTEMPTS = 5;
@@ -89,6 +93,10 @@ public:
     /// change compression and target size settings
     void changeSettings(bool enableCompression = false, unsigned int targetSize = MAX_OCTREE_PACKET_DATA_SIZE);
 
+    /// lets the uncompressed data grow past the size of a packet, up to MAX_OCTREE_OVERSIZED_DATA_SIZE - for data that is
+    /// written to files, it is never compressed
+    void changeOversizedTargetSize(unsigned int targetSize);
+
     /// reset completely, all data is discarded
     void reset();
     
@@ -278,7 +286,7 @@ private:
     unsigned int _targetSize;
     bool _enableCompression;
     
-    unsigned char _uncompressed[MAX_OCTREE_UNCOMRESSED_PACKET_SIZE];
+    std::vector<unsigned char> _uncompressed;
     int _bytesInUse;
     int _bytesAvailable;
     int _subTreeAt;
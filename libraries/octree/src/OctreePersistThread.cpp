@@ -30,6 +30,8 @@
 #include "OctreePersistThread.h"
 
 const int OctreePersistThread::DEFAULT_PERSIST_INTERVAL = 1000 * 30; // every 30 seconds
+const int OctreePersistThread::DEFAULT_JOURNAL_COMPACTION_INTERVAL = 60 * 10; // every 10 minutes
+const qint64 OctreePersistThread::MAX_JOURNAL_SIZE = 64 * 1024 * 1024; // compact early past 64MB of records
 
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, int persistInterval,
                                          bool wantBackup, const QJsonObject& settings, bool debugTimestampNow,
@@ -43,13 +45,19 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     _wantBackup(wantBackup),
     _debugTimestampNow(debugTimestampNow),
     _lastTimeDebug(0),
-    _persistAsFileType(persistAsFileType)
+    _persistAsFileType(persistAsFileType),
+    _journalCompactionInterval(DEFAULT_JOURNAL_COMPACTION_INTERVAL)
 {
     parseSettings(settings);
 
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+
+    if (_wantJournal && _tree->canJournalChanges()) {
+        // the journal is shared by every persist file type, so changes survive switching between them
+        _journal.reset(new OctreeJournal(sansExt + ".journal"));
+    }
 }
 
 QString OctreePersistThread::getPersistFileMimeType() const {
@@ -57,11 +65,33 @@ QString OctreePersistThread::getPersistFileMimeType() const {
         return "application/json";
     } if (_persistAsFileType == "json.gz") {
         return "application/zip";
+    } if (_persistAsFileType == "bin") {
+        return "application/octet-stream";
     }
     return "";
 }
 
 void OctreePersistThread::parseSettings(const QJsonObject& settings) {
+    QJsonValue journalVal = settings["journalChanges"];
+    if (journalVal.isString()) {
+        _wantJournal = journalVal.toString() == "true";
+    } else if (journalVal.isBool()) {
+        _wantJournal = journalVal.toBool();
+    }
+
+    QJsonValue compactionIntervalVal = settings["journalCompactionInterval"];
+    if (compactionIntervalVal.isString()) {
+        bool ok;
+        int compactionInterval = compactionIntervalVal.toString().toInt(&ok);
+        if (ok) {
+            _journalCompactionInterval = compactionInterval;
+        }
+    } else if (compactionIntervalVal.isDouble()) {
+        _journalCompactionInterval = compactionIntervalVal.toInt();
+    }
+
+    qCDebug(octree) << "JOURNAL CHANGES:" << _wantJournal << "compaction interval:" << _journalCompactionInterval;
+
     if (settings["backups"].isArray()) {
         const QJsonArray& backupRules = settings["backups"].toArray();
         qCDebug(octree) << "BACKUP RULES:";
@@ -158,9 +188,19 @@ bool OctreePersistThread::process() {
             }
 
             persistantFileRead = _tree->readFromFile(qPrintable(_filename.toLocal8Bit()));
+
+            // bring the tree up to date with the changes made since the file was last saved
+            if (_journal && _journal->exists()) {
+                _tree->replayJournal(*_journal);
+            }
+
             _tree->pruneTree();
         });
 
+        if (_journal) {
+            _tree->setJournalChanges(true);
+        }
+
         quint64 loadDone = usecTimestampNow();
         _loadTimeUSecs = loadDone - loadStarted;
 
@@ -189,6 +229,7 @@ bool OctreePersistThread::process() {
 
         // Since we just loaded the persistent file, we can consider ourselves as having "just checked" for persistance.
         _lastCheck = usecTimestampNow(); // we just loaded, no need to save again
+        _lastCompaction = _lastCheck;
         
         // This last persist time is not really used until the file is actually persisted. It is only
         // used in formatting the backup filename in cases of non-rolling backup names. However, we don't
@@ -233,7 +274,12 @@ bool OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
-    persist();
+    if (_journal && _initialLoadComplete) {
+        // the journal is enough to restore every change on the next start, no need to save the whole tree
+        writeJournal();
+    } else {
+        persist();
+    }
     qCDebug(octree) << "Persist thread done with about to finish...";
     _stopThread = true;
 }
@@ -247,14 +293,58 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
     return fileContents;
 }
 
+bool OctreePersistThread::writeJournal() {
+    int numChanges = 0;
+    _tree->withReadLock([&] {
+        numChanges = _tree->writeJournalRecords(*_journal);
+    });
+
+    if (numChanges > 0) {
+        if (!_journal->flush()) {
+            return false;
+        }
+        qCDebug(octree) << "journaled" << numChanges << "changes to" << _journal->getFilename();
+    }
+    return true;
+}
+
+bool OctreePersistThread::shouldCompactJournal() const {
+    quint64 sinceLastCompaction = usecTimestampNow() - _lastCompaction;
+    quint64 intervalToCompact = (quint64)_journalCompactionInterval * USECS_PER_SECOND;
+    return sinceLastCompaction > intervalToCompact || _journal->getSize() > MAX_JOURNAL_SIZE;
+}
+
 void OctreePersistThread::persist() {
+    if (_journal && _initialLoadComplete) {
+        // changes are journaled on every persist, the whole tree is only saved once in a while to compact the journal
+        bool journalWritten = writeJournal();
+        if (journalWritten && !shouldCompactJournal()) {
+            return;
+        }
+    }
+
     if (_tree->isDirty() && _initialLoadComplete) {
+        quint64 saveStart = usecTimestampNow();
 
         _tree->withWriteLock([&] {
             qCDebug(octree) << "pruning Octree before saving...";
             _tree->pruneTree();
             qCDebug(octree) << "DONE pruning Octree before saving...";
         });
+        quint64 lockHeld = usecTimestampNow() - saveStart;
+
+        // the tree is only locked long enough to snapshot it, the snapshot is written out while others edit the tree
+        OctreeSnapshotPointer snapshot;
+        if (_persistAsFileType != "svo") {
+            quint64 snapshotStart = usecTimestampNow();
+            _tree->withReadLock([&] {
+                snapshot = _tree->takeSnapshot();
+                if (snapshot) {
+                    _tree->clearDirtyBit(); // edits from here on are not in the snapshot, and dirty the tree again
+                }
+            });
+            lockHeld += usecTimestampNow() - snapshotStart;
+        }
 
         qCDebug(octree) << "persist operation calling backup...";
         backup(); // handle backup if requested        
@@ -267,15 +357,43 @@ void OctreePersistThread::persist() {
         if(lockFile.is_open()) {
             qCDebug(octree) << "saving Octree lock file created at:" << lockFileName;
 
-            _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+            bool saved = true;
+            if (snapshot) {
+                saved = _tree->writeSnapshotToFile(qPrintable(_filename), snapshot, _persistAsFileType);
+                if (!saved) {
+                    _tree->setDirtyBit(); // try again on the next persist
+                }
+            } else {
+                // this tree can't be snapshot, so it has to stay locked while it is written
+                quint64 writeStart = usecTimestampNow();
+                _tree->withReadLock([&] {
+                    _tree->writeToFile(qPrintable(_filename), NULL, _persistAsFileType);
+                    _tree->clearDirtyBit(); // tree is clean after saving
+                });
+                lockHeld += usecTimestampNow() - writeStart;
+            }
             time(&_lastPersistTime);
-            _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE saving Octree to file...";
 
+            quint64 saveTime = usecTimestampNow() - saveStart;
+            _lastSaveTime = saveTime;
+            _lastSaveLockTime = lockHeld;
+            qCDebug(octree) << "saving Octree took" << saveTime << "usecs, holding the tree lock for" << lockHeld << "usecs";
+
+            if (_journal && saved) {
+                // the records journaled before this save are all in the file now, changes made during the save
+                // are still tracked by the tree and will be journaled on the next persist
+                _journal->truncate();
+                _lastCompaction = usecTimestampNow();
+                qCDebug(octree) << "compacted journal" << _journal->getFilename();
+            }
+
             lockFile.close();
             qCDebug(octree) << "saving Octree lock file closed:" << lockFileName;
             remove(qPrintable(lockFileName));
             qCDebug(octree) << "saving Octree lock file removed:" << lockFileName;
+        } else if (snapshot) {
+            _tree->setDirtyBit(); // the snapshot was never written, try again on the next persist
         }
     }
 }
@@ -14,9 +14,13 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <atomic>
+#include <memory>
+
 #include <QString>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeJournal.h"
 
 /// Generalized threaded processor for handling received inbound packets.
 class OctreePersistThread : public GenericThread {
@@ -32,6 +36,8 @@ public:
     };
 
     static const int DEFAULT_PERSIST_INTERVAL;
+    static const int DEFAULT_JOURNAL_COMPACTION_INTERVAL;
+    static const qint64 MAX_JOURNAL_SIZE;
 
     OctreePersistThread(OctreePointer tree, const QString& filename, int persistInterval = DEFAULT_PERSIST_INTERVAL,
                         bool wantBackup = false, const QJsonObject& settings = QJsonObject(),
@@ -46,6 +52,10 @@ public:
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
+    // how long the last full save took, and how much of that time it held the tree lock
+    quint64 getLastSaveTime() const { return _lastSaveTime; }
+    quint64 getLastSaveLockTime() const { return _lastSaveLockTime; }
+
 signals:
     void loadCompleted();
 
@@ -54,6 +64,8 @@ protected:
     virtual bool process();
 
     void persist();
+    bool writeJournal();
+    bool shouldCompactJournal() const;
     void backup();
     void rollOldBackupVersions(const BackupRule& rule);
     void restoreFromMostRecentBackup();
@@ -78,6 +90,14 @@ private:
     quint64 _lastTimeDebug;
 
     QString _persistAsFileType;
+
+    bool _wantJournal { true };
+    int _journalCompactionInterval; // seconds between full saves of the tree while its changes are journaled
+    std::unique_ptr<OctreeJournal> _journal;
+    quint64 _lastCompaction { 0 };
+
+    std::atomic<quint64> _lastSaveTime { 0 };
+    std::atomic<quint64> _lastSaveLockTime { 0 };
 };
 
 #endif // hifi_OctreePersistThread_h
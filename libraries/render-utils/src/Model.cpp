@@ -24,6 +24,7 @@
 #include "AbstractViewStateInterface.h"
 #include "MeshPartPayload.h"
 #include "Model.h"
+#include "ModelKernels.h"
 
 #include "RenderUtilsLogging.h"
 
@@ -225,6 +226,10 @@ bool Model::updateGeometry() {
             MeshState state;
             state.clusterMatrices.resize(mesh.clusters.size());
             state.cauterizedClusterMatrices.resize(mesh.clusters.size());
+            state.jointMatrices.resize(mesh.clusters.size());
+            foreach (const FBXCluster& cluster, mesh.clusters) {
+                state.inverseBindMatrices.append(cluster.inverseBindMatrix);
+            }
 
             _meshStates.append(state);
 
@@ -879,7 +884,8 @@ class Blender : public QRunnable {
 public:
 
     Blender(ModelPointer model, int blendNumber, const std::weak_ptr<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients);
+        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients,
+        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals);
 
     virtual void run();
 
@@ -890,30 +896,46 @@ private:
     std::weak_ptr<NetworkGeometry> _geometry;
     QVector<FBXMesh> _meshes;
     QVector<float> _blendshapeCoefficients;
+    QVector<glm::vec3> _vertices;
+    QVector<glm::vec3> _normals;
 };
 
 Blender::Blender(ModelPointer model, int blendNumber, const std::weak_ptr<NetworkGeometry>& geometry,
-        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients) :
+        const QVector<FBXMesh>& meshes, const QVector<float>& blendshapeCoefficients,
+        const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) :
     _model(model),
     _blendNumber(blendNumber),
     _geometry(geometry),
     _meshes(meshes),
-    _blendshapeCoefficients(blendshapeCoefficients) {
+    _blendshapeCoefficients(blendshapeCoefficients),
+    _vertices(vertices),
+    _normals(normals) {
 }
 
 void Blender::run() {
     PROFILE_RANGE(__FUNCTION__);
-    QVector<glm::vec3> vertices, normals;
+    // write into the buffers we were given, they only reallocate if the meshes have grown
+    QVector<glm::vec3> vertices = std::move(_vertices);
+    QVector<glm::vec3> normals = std::move(_normals);
     if (_model) {
+        int numVertices = 0;
+        foreach (const FBXMesh& mesh, _meshes) {
+            if (!mesh.blendshapes.isEmpty()) {
+                numVertices += mesh.vertices.size();
+            }
+        }
+        vertices.resize(numVertices);
+        normals.resize(numVertices);
+
         int offset = 0;
         foreach (const FBXMesh& mesh, _meshes) {
             if (mesh.blendshapes.isEmpty()) {
                 continue;
             }
-            vertices += mesh.vertices;
-            normals += mesh.normals;
             glm::vec3* meshVertices = vertices.data() + offset;
             glm::vec3* meshNormals = normals.data() + offset;
+            std::copy(mesh.vertices.constBegin(), mesh.vertices.constEnd(), meshVertices);
+            std::copy(mesh.normals.constBegin(), mesh.normals.constEnd(), meshNormals);
             offset += mesh.vertices.size();
             const float NORMAL_COEFFICIENT_SCALE = 0.01f;
             for (int i = 0, n = qMin(_blendshapeCoefficients.size(), mesh.blendshapes.size()); i < n; i++) {
@@ -924,11 +946,9 @@ void Blender::run() {
                 }
                 float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
                 const FBXBlendshape& blendshape = mesh.blendshapes.at(i);
-                for (int j = 0; j < blendshape.indices.size(); j++) {
-                    int index = blendshape.indices.at(j);
-                    meshVertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
-                    meshNormals[index] += blendshape.normals.at(j) * normalCoefficient;
-                }
+                accumulateBlendshape(meshVertices, meshNormals, blendshape.indices.constData(),
+                                     blendshape.vertices.constData(), blendshape.normals.constData(),
+                                     blendshape.indices.size(), vertexCoefficient, normalCoefficient);
             }
         }
     }
@@ -1078,19 +1098,24 @@ void Model::updateClusterMatrices(glm::vec3 modelPosition, glm::quat modelOrient
     for (int i = 0; i < _meshStates.size(); i++) {
         MeshState& state = _meshStates[i];
         const FBXMesh& mesh = geometry.meshes.at(i);
+        int numClusters = mesh.clusters.size();
 
-        for (int j = 0; j < mesh.clusters.size(); j++) {
-            const FBXCluster& cluster = mesh.clusters.at(j);
-            auto jointMatrix = _rig->getJointTransform(cluster.jointIndex);
-            state.clusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
-
-            // as an optimization, don't build cautrizedClusterMatrices if the boneSet is empty.
-            if (!_cauterizeBoneSet.empty()) {
-                if (_cauterizeBoneSet.find(cluster.jointIndex) != _cauterizeBoneSet.end()) {
-                    jointMatrix = cauterizeMatrix;
+        // gather the clusters' joints, then compute all of the mesh's cluster matrices in one batch
+        for (int j = 0; j < numClusters; j++) {
+            state.jointMatrices[j] = _rig->getJointTransform(mesh.clusters.at(j).jointIndex);
+        }
+        composeClusterMatrices(modelToWorld, state.jointMatrices.constData(), state.inverseBindMatrices.constData(),
+                               state.clusterMatrices.data(), numClusters);
+
+        // as an optimization, don't build cautrizedClusterMatrices if the boneSet is empty.
+        if (!_cauterizeBoneSet.empty()) {
+            for (int j = 0; j < numClusters; j++) {
+                if (_cauterizeBoneSet.find(mesh.clusters.at(j).jointIndex) != _cauterizeBoneSet.end()) {
+                    state.jointMatrices[j] = cauterizeMatrix;
                 }
-                state.cauterizedClusterMatrices[j] = modelToWorld * jointMatrix * cluster.inverseBindMatrix;
             }
+            composeClusterMatrices(modelToWorld, state.jointMatrices.constData(), state.inverseBindMatrices.constData(),
+                                   state.cauterizedClusterMatrices.data(), numClusters);
         }
 
         // Once computed the cluster matrices, update the buffer(s)
@@ -1146,8 +1171,15 @@ bool Model::maybeStartBlender() {
     if (isLoaded()) {
         const FBXGeometry& fbxGeometry = getFBXGeometry();
         if (fbxGeometry.hasBlendedMeshes()) {
+            // keep the most recently returned buffers back, their blend may not have let go of them yet
+            QVector<glm::vec3> vertices, normals;
+            if (_spareBlendBuffers.size() > 1) {
+                auto buffers = _spareBlendBuffers.takeFirst();
+                vertices = buffers.first;
+                normals = buffers.second;
+            }
             QThreadPool::globalInstance()->start(new Blender(getThisPointer(), ++_blendNumber, _geometry,
-                fbxGeometry.meshes, _blendshapeCoefficients));
+                fbxGeometry.meshes, _blendshapeCoefficients, vertices, normals));
             return true;
         }
     }
@@ -1156,6 +1188,11 @@ bool Model::maybeStartBlender() {
 
 void Model::setBlendedVertices(int blendNumber, const std::weak_ptr<NetworkGeometry>& geometry,
         const QVector<glm::vec3>& vertices, const QVector<glm::vec3>& normals) {
+    const int MAX_SPARE_BLEND_BUFFERS = 2;
+    if (_spareBlendBuffers.size() < MAX_SPARE_BLEND_BUFFERS) {
+        _spareBlendBuffers.append(qMakePair(vertices, normals));
+    }
+
     auto geometryRef = geometry.lock();
     if (!geometryRef || _geometry != geometryRef || _blendedVertexBuffers.empty() || blendNumber < _appliedBlendNumber) {
         return;
@@ -1180,6 +1217,7 @@ void Model::setBlendedVertices(int blendNumber, const std::weak_ptr<NetworkGeome
 
 void Model::deleteGeometry() {
     _blendedVertexBuffers.clear();
+    _spareBlendBuffers.clear();
     _meshStates.clear();
     _rig->destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
@@ -287,6 +287,10 @@ protected:
         gpu::BufferPointer clusterBuffer;
         gpu::BufferPointer cauterizedClusterBuffer;
 
+        // the clusters' inverse bind matrices and current joint matrices, laid out for composeClusterMatrices()
+        QVector<glm::mat4> inverseBindMatrices;
+        QVector<glm::mat4> jointMatrices;
+
     };
 
     QVector<MeshState> _meshStates;
@@ -341,6 +345,10 @@ protected:
 
     gpu::Buffers _blendedVertexBuffers;
 
+    // vertex and normal buffers of finished blends, which later blends write into rather than allocating their own.
+    // they are handed out oldest first, by which time the blend that returned them has let go of them.
+    QList<QPair<QVector<glm::vec3>, QVector<glm::vec3>>> _spareBlendBuffers;
+
     QVector<QVector<QSharedPointer<Texture> > > _dilatedTextures;
 
     QVector<float> _blendedBlendshapeCoefficients;
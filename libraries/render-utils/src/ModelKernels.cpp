@@ -0,0 +1,97 @@
+//
+//  ModelKernels.cpp
+//  libraries/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelKernels.h"
+
+//
+// on x86 architecture, assume that SSE2 is present
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+// glm::vec3 is not padded, so load and store exactly three floats
+static inline __m128 load3(const glm::vec3& v) {
+    __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)&v.x);
+    return _mm_movelh_ps(xy, _mm_load_ss(&v.z));
+}
+
+static inline void store3(glm::vec3& v, __m128 x) {
+    _mm_storel_pi((__m64*)&v.x, x);
+    _mm_store_ss(&v.z, _mm_movehl_ps(x, x));
+}
+
+void accumulateBlendshape(glm::vec3* vertices, glm::vec3* normals, const int* indices,
+                          const glm::vec3* vertexDeltas, const glm::vec3* normalDeltas, int numDeltas,
+                          float vertexCoefficient, float normalCoefficient) {
+    __m128 vc = _mm_set1_ps(vertexCoefficient);
+    __m128 nc = _mm_set1_ps(normalCoefficient);
+
+    for (int i = 0; i < numDeltas; i++) {
+        glm::vec3& vertex = vertices[indices[i]];
+        glm::vec3& normal = normals[indices[i]];
+
+        store3(vertex, _mm_add_ps(load3(vertex), _mm_mul_ps(load3(vertexDeltas[i]), vc)));
+        store3(normal, _mm_add_ps(load3(normal), _mm_mul_ps(load3(normalDeltas[i]), nc)));
+    }
+}
+
+// result = a * b, for column major matrices whose columns are already loaded from a
+static inline void multiply(const __m128* a, const glm::mat4& b, __m128* result) {
+    const float* bm = &b[0][0];
+    for (int column = 0; column < 4; column++) {
+        __m128 r = _mm_mul_ps(a[0], _mm_set1_ps(bm[4 * column + 0]));
+        r = _mm_add_ps(r, _mm_mul_ps(a[1], _mm_set1_ps(bm[4 * column + 1])));
+        r = _mm_add_ps(r, _mm_mul_ps(a[2], _mm_set1_ps(bm[4 * column + 2])));
+        r = _mm_add_ps(r, _mm_mul_ps(a[3], _mm_set1_ps(bm[4 * column + 3])));
+        result[column] = r;
+    }
+}
+
+void composeClusterMatrices(const glm::mat4& modelToWorld, const glm::mat4* jointMatrices,
+                            const glm::mat4* inverseBindMatrices, glm::mat4* clusterMatrices, int numClusters) {
+    // the model matrix stays in registers for the whole batch
+    __m128 m[4];
+    for (int column = 0; column < 4; column++) {
+        m[column] = _mm_loadu_ps(&modelToWorld[column][0]);
+    }
+
+    for (int i = 0; i < numClusters; i++) {
+        __m128 mj[4];
+        __m128 mji[4];
+        multiply(m, jointMatrices[i], mj);
+        multiply(mj, inverseBindMatrices[i], mji);
+
+        float* result = &clusterMatrices[i][0][0];
+        for (int column = 0; column < 4; column++) {
+            _mm_storeu_ps(result + 4 * column, mji[column]);
+        }
+    }
+}
+
+#else   // portable reference code
+
+void accumulateBlendshape(glm::vec3* vertices, glm::vec3* normals, const int* indices,
+                          const glm::vec3* vertexDeltas, const glm::vec3* normalDeltas, int numDeltas,
+                          float vertexCoefficient, float normalCoefficient) {
+    for (int i = 0; i < numDeltas; i++) {
+        vertices[indices[i]] += vertexDeltas[i] * vertexCoefficient;
+        normals[indices[i]] += normalDeltas[i] * normalCoefficient;
+    }
+}
+
+void composeClusterMatrices(const glm::mat4& modelToWorld, const glm::mat4* jointMatrices,
+                            const glm::mat4* inverseBindMatrices, glm::mat4* clusterMatrices, int numClusters) {
+    for (int i = 0; i < numClusters; i++) {
+        clusterMatrices[i] = modelToWorld * jointMatrices[i] * inverseBindMatrices[i];
+    }
+}
+
+#endif
@@ -0,0 +1,30 @@
+//
+//  ModelKernels.h
+//  libraries/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelKernels_h
+#define hifi_ModelKernels_h
+
+#include <glm/glm.hpp>
+
+//
+// Inner loops of vertex blending and skinning for Model.
+// SSE2 is assumed on x86, otherwise portable code is used.
+//
+
+// adds one blendshape's sparse deltas, scaled by their coefficients, to the vertices and normals they index
+void accumulateBlendshape(glm::vec3* vertices, glm::vec3* normals, const int* indices,
+                          const glm::vec3* vertexDeltas, const glm::vec3* normalDeltas, int numDeltas,
+                          float vertexCoefficient, float normalCoefficient);
+
+// computes modelToWorld * jointMatrices[i] * inverseBindMatrices[i] for each of a mesh's clusters
+void composeClusterMatrices(const glm::mat4& modelToWorld, const glm::mat4* jointMatrices,
+                            const glm::mat4* inverseBindMatrices, glm::mat4* clusterMatrices, int numClusters);
+
+#endif // hifi_ModelKernels_h
@@ -55,6 +55,7 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    invalidateTransformCaches();
 }
 
 Transform SpatiallyNestable::getParentTransform(bool& success, int depth) const {
@@ -139,6 +140,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateTransformCaches();
 }
 
 glm::vec3 SpatiallyNestable::worldToLocal(const glm::vec3& position,
@@ -330,6 +332,7 @@ void SpatiallyNestable::setPosition(const glm::vec3& position, bool& success) {
     if (success) {
         locationChanged();
     } else {
+        invalidateTransformCaches();
         qDebug() << "setPosition failed for" << getID();
     }
 }
@@ -379,6 +382,8 @@ void SpatiallyNestable::setOrientation(const glm::quat& orientation, bool& succe
     });
     if (success) {
         locationChanged();
+    } else {
+        invalidateTransformCaches();
     }
 }
 
@@ -502,14 +507,56 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
     Transform result;
+    if (getCachedTransform(result)) {
+        success = true;
+        return result;
+    }
+
+    // read the generation before computing, so that a change made while we compute leaves the cache stale
+    quint64 generation = _transformGeneration;
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
     _transformLock.withReadLock([&] {
         Transform::mult(result, parentTransform, _transform);
     });
+
+    if (success && canCacheTransform()) {
+        bool hasParent = !_parent.expired();
+        _transformLock.withWriteLock([&] {
+            _cachedTransform = result;
+            _cachedTransformGeneration = generation;
+            _cachedTransformHasParent = hasParent;
+        });
+    }
     return result;
 }
 
+bool SpatiallyNestable::getCachedTransform(Transform& result) const {
+    bool hit = false;
+    bool hasParent = false;
+    _transformLock.withReadLock([&] {
+        if (_cachedTransformGeneration == _transformGeneration) {
+            result = _cachedTransform;
+            hasParent = _cachedTransformHasParent;
+            hit = true;
+        }
+    });
+    // a parent that has gone away has to be looked up again
+    return hit && !(hasParent && _parent.expired());
+}
+
+bool SpatiallyNestable::canCacheTransform() const {
+    // a world-transform can only be cached if nothing it is built from can change without a locationChanged()
+    // reaching this object -- the parent's joints must hold still and the parent's own transform must be cacheable.
+    SpatiallyNestablePointer parent = _parent.lock();
+    if (!parent) {
+        return getParentID().isNull();
+    }
+    Transform parentTransform;
+    return parent->hasStaticJoints() && parent->getCachedTransform(parentTransform);
+}
+
 const Transform SpatiallyNestable::getTransform(int jointIndex, bool& success, int depth) const {
     // this returns the world-space transform for this object.  It finds its parent's transform (which may
     // cause this object's parent to query its parent, etc) and multiplies this object's local transform onto it.
@@ -552,6 +599,8 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
     });
     if (success) {
         locationChanged();
+    } else {
+        invalidateTransformCaches();
     }
 }
 
@@ -579,6 +628,7 @@ void SpatiallyNestable::setScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         _transform.setScale(scale);
     });
+    _transformGeneration++; // children don't inherit scale, so only this object's cache is affected
     dimensionsChanged();
 }
 
@@ -689,6 +739,7 @@ void SpatiallyNestable::setLocalScale(const glm::vec3& scale) {
     _transformLock.withWriteLock([&] {
         _transform.setScale(scale);
     });
+    _transformGeneration++;
     dimensionsChanged();
 }
 
@@ -752,11 +803,19 @@ void SpatiallyNestable::forEachDescendant(std::function<void(SpatiallyNestablePo
 }
 
 void SpatiallyNestable::locationChanged() {
+    _transformGeneration++;
     forEachChild([&](SpatiallyNestablePointer object) {
         object->locationChanged();
     });
 }
 
+void SpatiallyNestable::invalidateTransformCaches() {
+    _transformGeneration++;
+    forEachChild([&](SpatiallyNestablePointer object) {
+        object->invalidateTransformCaches();
+    });
+}
+
 AACube SpatiallyNestable::getMaximumAACube(bool& success) const {
     return AACube(getPosition(success) - glm::vec3(defaultAACubeSize / 2.0f), defaultAACubeSize);
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_SpatiallyNestable_h
 #define hifi_SpatiallyNestable_h
 
+#include <atomic>
+
 #include <QUuid>
 
 #include "Transform.h"
@@ -160,6 +162,13 @@ protected:
     virtual void locationChanged(); // called when a this object's location has changed
     virtual void dimensionsChanged() { } // called when a this object's dimensions have changed
 
+    // true if this object's joints never move relative to it, so children can cache world transforms based on them.
+    // objects with animated joints must leave this false, since their joints move without a locationChanged().
+    virtual bool hasStaticJoints() const { return false; }
+
+    // drops the cached world transforms of this object and everything parented to it
+    void invalidateTransformCaches();
+
     // _queryAACube is used to decide where something lives in the octree
     mutable AACube _queryAACube;
     mutable bool _queryAACubeSet { false };
@@ -172,6 +181,16 @@ private:
     mutable ReadWriteLockable _velocityLock;
     mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
+
+    bool getCachedTransform(Transform& result) const;
+    bool canCacheTransform() const;
+
+    // bumped whenever this object's world-transform may have changed.  _cachedTransform is only valid while
+    // _cachedTransformGeneration matches it.
+    std::atomic<quint64> _transformGeneration { 1 };
+    mutable Transform _cachedTransform;
+    mutable quint64 _cachedTransformGeneration { 0 };
+    mutable bool _cachedTransformHasParent { false };
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
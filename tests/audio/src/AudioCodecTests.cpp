@@ -0,0 +1,137 @@
+//
+//  AudioCodecTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioCodecTests.h"
+
+#include <cmath>
+
+#include <AudioADPCMCodec.h>
+#include <AudioCodec.h>
+#include <AudioConstants.h>
+
+QTEST_MAIN(AudioCodecTests)
+
+// a network frame of a tone, each channel an octave above the last
+static QByteArray toneFrame(int numChannels, int frameIndex) {
+    const int numFrames = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+    const float TONE_HZ = 440.0f;
+    const float AMPLITUDE = 8000.0f;
+
+    QByteArray frame(numFrames * numChannels * sizeof(int16_t), 0);
+    int16_t* samples = reinterpret_cast<int16_t*>(frame.data());
+
+    for (int i = 0; i < numFrames; i++) {
+        float time = (float)(frameIndex * numFrames + i) / AudioConstants::SAMPLE_RATE;
+        for (int channel = 0; channel < numChannels; channel++) {
+            samples[i * numChannels + channel] = (int16_t)(AMPLITUDE * sinf(2.0f * (float)M_PI * TONE_HZ * (channel + 1) * time));
+        }
+    }
+    return frame;
+}
+
+static int maxSampleError(const QByteArray& expected, const QByteArray& actual) {
+    const int16_t* expectedSamples = reinterpret_cast<const int16_t*>(expected.constData());
+    const int16_t* actualSamples = reinterpret_cast<const int16_t*>(actual.constData());
+
+    int maxError = 0;
+    for (int i = 0; i < expected.size() / (int)sizeof(int16_t); i++) {
+        maxError = std::max(maxError, std::abs(expectedSamples[i] - actualSamples[i]));
+    }
+    return maxError;
+}
+
+void AudioCodecTests::builtInCodecs() {
+    QVERIFY(AudioCodecs::getCodecNames().contains("pcm"));
+    QVERIFY(AudioCodecs::getCodecNames().contains(AudioADPCMCodec::NAME));
+
+    QVERIFY(AudioCodecs::getCodec(AudioADPCMCodec::NAME));
+    QVERIFY(!AudioCodecs::getCodec("not-a-codec"));
+}
+
+void AudioCodecTests::pcmRoundTrip() {
+    auto codec = AudioCodecs::getCodec("pcm");
+    auto encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    auto decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+    QByteArray frame = toneFrame(AudioConstants::STEREO, 0);
+    QByteArray encoded, decoded;
+    encoder->encode(frame, encoded);
+    decoder->decode(encoded, decoded);
+
+    QCOMPARE(decoded, frame);
+}
+
+void AudioCodecTests::adpcmEncodedSize() {
+    auto codec = AudioCodecs::getCodec(AudioADPCMCodec::NAME);
+
+    for (int numChannels = AudioConstants::MONO; numChannels <= AudioConstants::STEREO; numChannels++) {
+        auto encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, numChannels);
+
+        QByteArray frame = toneFrame(numChannels, 0);
+        QByteArray encoded;
+        encoder->encode(frame, encoded);
+
+        QCOMPARE(encoded.size(),
+                 AudioADPCMCodec::encodedBytesForFrames(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL, numChannels));
+
+        // four bits a sample, plus the channel headers
+        QVERIFY(encoded.size() * 3 < frame.size());
+    }
+}
+
+void AudioCodecTests::adpcmRoundTrip() {
+    auto codec = AudioCodecs::getCodec(AudioADPCMCodec::NAME);
+
+    // the error allowed once the step size has adapted to the tone, 5% of its amplitude
+    const int MAX_SAMPLE_ERROR = 400;
+    const int NUM_WARMUP_FRAMES = 2;
+
+    for (int numChannels = AudioConstants::MONO; numChannels <= AudioConstants::STEREO; numChannels++) {
+        auto encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, numChannels);
+        auto decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, numChannels);
+
+        for (int frameIndex = 0; frameIndex < 50; frameIndex++) {
+            QByteArray frame = toneFrame(numChannels, frameIndex);
+            QByteArray encoded, decoded;
+            encoder->encode(frame, encoded);
+            decoder->decode(encoded, decoded);
+
+            QCOMPARE(decoded.size(), frame.size());
+            if (frameIndex >= NUM_WARMUP_FRAMES) {
+                QVERIFY(maxSampleError(frame, decoded) <= MAX_SAMPLE_ERROR);
+            }
+        }
+    }
+}
+
+void AudioCodecTests::adpcmFramesDecodeOnTheirOwn() {
+    auto codec = AudioCodecs::getCodec(AudioADPCMCodec::NAME);
+    auto encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+
+    QList<QByteArray> encodedFrames;
+    for (int frameIndex = 0; frameIndex < 10; frameIndex++) {
+        QByteArray encoded;
+        encoder->encode(toneFrame(AudioConstants::STEREO, frameIndex), encoded);
+        encodedFrames << encoded;
+    }
+
+    // a decoder that never saw the frames before it, as when packets are lost, decodes the same samples
+    auto decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    QByteArray inOrder;
+    for (auto& encoded : encodedFrames) {
+        decoder->decode(encoded, inOrder);
+    }
+
+    auto lateDecoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
+    QByteArray lastOnly;
+    lateDecoder->decode(encodedFrames.last(), lastOnly);
+
+    QCOMPARE(lastOnly, inOrder);
+}
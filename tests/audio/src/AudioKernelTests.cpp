@@ -0,0 +1,198 @@
+//
+//  AudioKernelTests.cpp
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioKernelTests.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioMixKernels.h>
+
+QTEST_MAIN(AudioKernelTests)
+
+// an odd number of samples, so the kernels also go through the samples left over by their vectorized loops
+static const int NUM_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO + 3;
+
+static std::vector<int16_t> randomSamples(int numSamples) {
+    std::vector<int16_t> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = (int16_t)(qrand() % 65536 - 32768);
+    }
+    return samples;
+}
+
+// a mix that goes past full scale in both directions
+static std::vector<float> randomMix(int numSamples) {
+    std::vector<float> mix(numSamples);
+    for (auto& sample : mix) {
+        sample = (float)(qrand() % 4001 - 2000) / 1000.0f;
+    }
+    return mix;
+}
+
+void AudioKernelTests::mixInt16ToFloat() {
+    const float GAIN = 0.7f;
+    auto input = randomSamples(NUM_SAMPLES);
+    auto output = randomMix(NUM_SAMPLES);
+    auto expected = output;
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        expected[i] += input[i] * GAIN / AudioConstants::MAX_SAMPLE_VALUE;
+    }
+
+    ::mixInt16ToFloat(input.data(), output.data(), GAIN, NUM_SAMPLES);
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        QVERIFY(fabsf(output[i] - expected[i]) < 1.0e-6f);
+    }
+}
+
+void AudioKernelTests::mixMonoInt16ToStereoFloat() {
+    const float GAIN = 0.3f;
+    const int NUM_FRAMES = NUM_SAMPLES / 2;
+    auto input = randomSamples(NUM_FRAMES);
+    auto output = randomMix(2 * NUM_FRAMES);
+    auto expected = output;
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        expected[2 * i + 0] += input[i] * GAIN / AudioConstants::MAX_SAMPLE_VALUE;
+        expected[2 * i + 1] += input[i] * GAIN / AudioConstants::MAX_SAMPLE_VALUE;
+    }
+
+    ::mixMonoInt16ToStereoFloat(input.data(), output.data(), GAIN, NUM_FRAMES);
+
+    for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+        QVERIFY(fabsf(output[i] - expected[i]) < 1.0e-6f);
+    }
+}
+
+void AudioKernelTests::convertMixToInt16() {
+    auto input = randomMix(NUM_SAMPLES);
+    std::vector<int16_t> output(NUM_SAMPLES);
+
+    QCOMPARE(::convertMixToInt16(input.data(), output.data(), NUM_SAMPLES), true);
+
+    for (int i = 0; i < NUM_SAMPLES; i++) {
+        int expected = (int)(input[i] * AudioConstants::MAX_SAMPLE_VALUE);
+        expected = std::min(std::max(expected, AudioConstants::MIN_SAMPLE_VALUE), AudioConstants::MAX_SAMPLE_VALUE);
+        QCOMPARE((int)output[i], expected);
+    }
+}
+
+void AudioKernelTests::convertSilentMixToInt16() {
+    std::vector<float> input(NUM_SAMPLES, 0.0f);
+    std::vector<int16_t> output(NUM_SAMPLES);
+
+    QCOMPARE(::convertMixToInt16(input.data(), output.data(), NUM_SAMPLES), false);
+
+    // too quiet to survive the conversion
+    input[10] = 0.5f / AudioConstants::MAX_SAMPLE_VALUE;
+    QCOMPARE(::convertMixToInt16(input.data(), output.data(), NUM_SAMPLES), false);
+
+    // a single sample is enough, whether or not it falls in the vectorized loop
+    input[10] = -0.001f;
+    QCOMPARE(::convertMixToInt16(input.data(), output.data(), NUM_SAMPLES), true);
+
+    input[10] = 0.0f;
+    input[NUM_SAMPLES - 1] = 0.001f;
+    QCOMPARE(::convertMixToInt16(input.data(), output.data(), NUM_SAMPLES), true);
+}
+
+void AudioKernelTests::hrtfRender() {
+    const int HRTF_DATASET_INDEX = 1;
+    auto input = randomSamples(HRTF_BLOCK);
+
+    // the HRTF ramps in from a gain of zero, so the first block is quieter than the next
+    AudioHRTF hrtf;
+    std::vector<float> firstBlock(2 * HRTF_BLOCK, 0.0f);
+    std::vector<float> secondBlock(2 * HRTF_BLOCK, 0.0f);
+    hrtf.render(input.data(), firstBlock.data(), HRTF_DATASET_INDEX, 0.5f, 1.0f, HRTF_BLOCK);
+    hrtf.render(input.data(), secondBlock.data(), HRTF_DATASET_INDEX, 0.5f, 1.0f, HRTF_BLOCK);
+
+    float firstEnergy = 0.0f;
+    float secondEnergy = 0.0f;
+    for (int i = 0; i < 2 * HRTF_BLOCK; i++) {
+        QVERIFY(std::isfinite(firstBlock[i]) && std::isfinite(secondBlock[i]));
+        firstEnergy += firstBlock[i] * firstBlock[i];
+        secondEnergy += secondBlock[i] * secondBlock[i];
+    }
+    QVERIFY(firstEnergy > 0.0f);
+    QVERIFY(secondEnergy > firstEnergy);
+
+    // rendering down to a gain of zero, then at zero, leaves nothing but the tail of the filters
+    std::vector<float> fadedBlock(2 * HRTF_BLOCK, 0.0f);
+    std::vector<float> silentBlock(2 * HRTF_BLOCK, 0.0f);
+    hrtf.render(input.data(), fadedBlock.data(), HRTF_DATASET_INDEX, 0.5f, 0.0f, HRTF_BLOCK);
+    hrtf.render(input.data(), silentBlock.data(), HRTF_DATASET_INDEX, 0.5f, 0.0f, HRTF_BLOCK);
+
+    float silentEnergy = 0.0f;
+    for (int i = HRTF_TAPS; i < 2 * HRTF_BLOCK; i++) {
+        silentEnergy += silentBlock[i] * silentBlock[i];
+    }
+    QVERIFY(silentEnergy < 1.0e-6f);
+}
+
+template <typename F>
+static void reportNsecsPerFrame(const char* kernel, F kernelFrame) {
+    const int NUM_FRAMES = 20000;
+
+    // warm up the caches
+    for (int i = 0; i < NUM_FRAMES / 10; i++) {
+        kernelFrame();
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        kernelFrame();
+    }
+    qint64 nsecs = timer.nsecsElapsed();
+
+    qDebug() << kernel << (double)nsecs / NUM_FRAMES << "ns/frame";
+}
+
+void AudioKernelTests::benchmark() {
+    const int HRTF_DATASET_INDEX = 1;
+    const int FRAME_SAMPLES = AudioConstants::NETWORK_FRAME_SAMPLES_STEREO;
+    const int FRAME_SAMPLES_PER_CHANNEL = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
+    auto samples = randomSamples(FRAME_SAMPLES);
+    auto mix = randomMix(FRAME_SAMPLES);
+    std::vector<int16_t> output(FRAME_SAMPLES);
+
+    AudioHRTF hrtf;
+    float azimuth = 0.0f;
+    reportNsecsPerFrame("AudioHRTF::render", [&] {
+        // a moving source, so the filters are interpolated every frame
+        azimuth += 0.01f;
+        hrtf.render(samples.data(), mix.data(), HRTF_DATASET_INDEX, azimuth, 0.5f, FRAME_SAMPLES_PER_CHANNEL);
+    });
+    reportNsecsPerFrame("AudioHRTF::renderSilent", [&] {
+        hrtf.renderSilent(samples.data(), mix.data(), HRTF_DATASET_INDEX, azimuth, 0.5f, FRAME_SAMPLES_PER_CHANNEL);
+    });
+
+    // keep the mix within range for the conversion back
+    mix = randomMix(FRAME_SAMPLES);
+    reportNsecsPerFrame("mixInt16ToFloat", [&] {
+        ::mixInt16ToFloat(samples.data(), mix.data(), 1.0e-6f, FRAME_SAMPLES);
+    });
+    reportNsecsPerFrame("mixMonoInt16ToStereoFloat", [&] {
+        ::mixMonoInt16ToStereoFloat(samples.data(), mix.data(), 1.0e-6f, FRAME_SAMPLES_PER_CHANNEL);
+    });
+
+    bool hasAudio = false;
+    reportNsecsPerFrame("convertMixToInt16", [&] {
+        hasAudio = ::convertMixToInt16(mix.data(), output.data(), FRAME_SAMPLES) || hasAudio;
+    });
+    QVERIFY(hasAudio);
+}
@@ -0,0 +1,29 @@
+//
+//  AudioKernelTests.h
+//  tests/audio/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioKernelTests_h
+#define hifi_AudioKernelTests_h
+
+#include <QtTest/QtTest>
+
+class AudioKernelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void mixInt16ToFloat();
+    void mixMonoInt16ToStereoFloat();
+    void convertMixToInt16();
+    void convertSilentMixToInt16();
+    void hrtfRender();
+
+    // reports the time each kernel takes for one network frame
+    void benchmark();
+};
+
+#endif // hifi_AudioKernelTests_h
@@ -0,0 +1,165 @@
+//
+//  ParticleStoreTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParticleStoreTests.h"
+
+#include <deque>
+#include <vector>
+
+#include <QElapsedTimer>
+
+#include <ParticleStore.h>
+
+QTEST_MAIN(ParticleStoreTests)
+
+using Particle = ParticleStore::Particle;
+using Instance = ParticleStore::Instance;
+
+static Particle makeParticle(float seed) {
+    Particle particle;
+    particle.seed = seed;
+    particle.position = glm::vec3(seed, 0.0f, 0.0f);
+    particle.velocity = glm::vec3(0.0f, 1.0f, seed);
+    particle.acceleration = glm::vec3(0.0f, -9.8f, 0.0f);
+    return particle;
+}
+
+static std::vector<Instance> getInstances(const ParticleStore& store) {
+    std::vector<Instance> instances(store.size());
+    store.writeInstances(instances.data());
+    return instances;
+}
+
+void ParticleStoreTests::testAgeAndKill() {
+    ParticleStore store(10);
+    for (int i = 0; i < 5; i++) {
+        store.age(1.0f, 3.5f);
+        store.push(makeParticle((float)i));
+    }
+
+    // the first particle died when it reached 4 seconds
+    QCOMPARE(store.size(), 4);
+    auto instances = getInstances(store);
+    QCOMPARE(instances[0].lifetimeAndSeed, glm::vec2(3.0f, 1.0f));
+    QCOMPARE(instances[3].lifetimeAndSeed, glm::vec2(0.0f, 4.0f));
+
+    store.age(10.0f, 3.5f);
+    QVERIFY(store.isEmpty());
+}
+
+void ParticleStoreTests::testOverflowAndCapacity() {
+    ParticleStore store(4);
+    for (int i = 0; i < 7; i++) {
+        store.push(makeParticle((float)i));
+    }
+
+    // the newest particles win, and they come out oldest first across the wrap of the ring
+    QCOMPARE(store.size(), 4);
+    auto instances = getInstances(store);
+    for (int i = 0; i < 4; i++) {
+        QCOMPARE(instances[i].lifetimeAndSeed.y, (float)(i + 3));
+    }
+
+    store.setCapacity(2);
+    QCOMPARE(store.size(), 2);
+    instances = getInstances(store);
+    QCOMPARE(instances[0].lifetimeAndSeed.y, 5.0f);
+    QCOMPARE(instances[1].lifetimeAndSeed.y, 6.0f);
+
+    store.setCapacity(8);
+    store.push(makeParticle(7.0f));
+    instances = getInstances(store);
+    QCOMPARE(store.size(), 3);
+    QCOMPARE(instances[2].lifetimeAndSeed.y, 7.0f);
+}
+
+void ParticleStoreTests::testIntegrate() {
+    const float DELTA_TIME = 0.5f;
+    const float EPSILON = 0.0001f;
+
+    // enough particles for the vectorized loops and their scalar tail, wrapped around the ring
+    ParticleStore store(13);
+    std::vector<Particle> expected;
+    for (int i = 0; i < 20; i++) {
+        store.push(makeParticle((float)i));
+        expected.push_back(makeParticle((float)i));
+    }
+    expected.erase(expected.begin(), expected.end() - 13);
+
+    store.integrate(DELTA_TIME);
+    store.integrate(DELTA_TIME);
+
+    auto instances = getInstances(store);
+    for (size_t i = 0; i < expected.size(); i++) {
+        Particle& particle = expected[i];
+        for (int step = 0; step < 2; step++) {
+            particle.position += particle.velocity * DELTA_TIME + (0.5f * DELTA_TIME * DELTA_TIME) * particle.acceleration;
+            particle.velocity += particle.acceleration * DELTA_TIME;
+        }
+        QVERIFY(glm::length(instances[i].position - particle.position) < EPSILON);
+    }
+}
+
+void ParticleStoreTests::benchmarkSimulation() {
+    const int NUM_PARTICLES = 10000;
+    const int NUM_FRAMES = 200;
+    const float DELTA_TIME = 1.0f / 90.0f;
+    const float LIFESPAN = 1000.0f; // long enough that every particle lives through the benchmark
+
+    ParticleStore store(NUM_PARTICLES);
+    std::deque<Particle> particles;
+    for (int i = 0; i < NUM_PARTICLES; i++) {
+        store.push(makeParticle((float)i));
+        particles.push_back(makeParticle((float)i));
+    }
+    std::vector<Instance> instances(NUM_PARTICLES);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        store.age(DELTA_TIME, LIFESPAN);
+        store.integrate(DELTA_TIME);
+        store.writeInstances(instances.data());
+    }
+    qint64 storeNsecs = timer.nsecsElapsed();
+
+    // the same frames over a deque of particle structs, copied out for rendering as the entity used to do
+    timer.restart();
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        int popCount = 0;
+        for (Particle& particle : particles) {
+            particle.lifetime += DELTA_TIME;
+            if (particle.lifetime >= LIFESPAN) {
+                popCount++;
+            } else {
+                particle.position += particle.velocity * DELTA_TIME +
+                    (0.5f * DELTA_TIME * DELTA_TIME) * particle.acceleration;
+                particle.velocity += particle.acceleration * DELTA_TIME;
+            }
+        }
+        particles.erase(particles.begin(), particles.begin() + popCount);
+
+        std::vector<Instance> primitives;
+        primitives.reserve(particles.size());
+        for (auto& particle : particles) {
+            primitives.push_back({ particle.position, glm::vec2(particle.lifetime, particle.seed) });
+        }
+        memcpy(instances.data(), primitives.data(), sizeof(Instance) * primitives.size());
+    }
+    qint64 dequeNsecs = timer.nsecsElapsed();
+
+    double particleFrames = (double)NUM_PARTICLES * NUM_FRAMES;
+    qDebug() << "particle store" << particleFrames * 1.0e6 / storeNsecs << "particles/ms";
+    qDebug() << "particle deque" << particleFrames * 1.0e6 / dequeNsecs << "particles/ms";
+
+    QCOMPARE(store.size(), NUM_PARTICLES);
+    auto storeInstances = getInstances(store);
+    QVERIFY(glm::length(storeInstances.back().position - particles.back().position) < 0.01f);
+}
@@ -0,0 +1,25 @@
+//
+//  ParticleStoreTests.h
+//  tests/entities-renderer/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ParticleStoreTests_h
+#define hifi_ParticleStoreTests_h
+
+#include <QtTest/QtTest>
+
+class ParticleStoreTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testAgeAndKill();
+    void testOverflowAndCapacity();
+    void testIntegrate();
+    void benchmarkSimulation();
+};
+
+#endif // hifi_ParticleStoreTests_h
@@ -0,0 +1,268 @@
+//
+//  PolyVoxTests.cpp
+//  tests/entities-renderer/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PolyVoxTests.h"
+
+#include <algorithm>
+#include <array>
+
+#include <QElapsedTimer>
+
+#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
+#include <PolyVoxCore/SurfaceMesh.h>
+
+#include <PolyVoxChunks.h>
+#include <RenderablePolyVoxEntityItem.h>
+
+QTEST_MAIN(PolyVoxTests)
+
+static uint8_t testPattern(int x, int y, int z) {
+    return (x * y + z) % 7 ? 1 : 0;
+}
+
+static std::shared_ptr<RenderablePolyVoxEntityItem> makeTerrain(int size, int height) {
+    auto entity = std::make_shared<RenderablePolyVoxEntityItem>(EntityItemID(QUuid::createUuid()));
+    entity->setVoxelSurfaceStyle(PolyVoxEntityItem::SURFACE_MARCHING_CUBES);
+    entity->setVoxelVolumeSize(glm::vec3((float)size));
+    entity->withWriteLock([&] {
+        for (int z = 0; z < size; z++) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < size; x++) {
+                    entity->setVoxelInternal(x, y, z, 1);
+                }
+            }
+        }
+    });
+    return entity;
+}
+
+void PolyVoxTests::testLegacyVoxelData() {
+    const quint16 SIZE = 20;
+    QByteArray uncompressedData(SIZE * SIZE * SIZE, '\0');
+    for (int z = 0; z < SIZE; z++) {
+        for (int y = 0; y < SIZE; y++) {
+            for (int x = 0; x < SIZE; x++) {
+                uncompressedData[(z * SIZE + y) * SIZE + x] = testPattern(x, y, z);
+            }
+        }
+    }
+    QByteArray legacyVoxelData;
+    QDataStream writer(&legacyVoxelData, QIODevice::WriteOnly | QIODevice::Truncate);
+    writer << SIZE << SIZE << SIZE << qCompress(uncompressedData, 9);
+
+    PolyVoxChunks chunks;
+    QVERIFY(!PolyVoxChunks::isChunked(legacyVoxelData));
+    QVERIFY(chunks.readVoxelData(legacyVoxelData));
+    QVERIFY(chunks.hasSize(SIZE, SIZE, SIZE));
+    QCOMPARE(chunks.getChunkCount(), 8);
+
+    // read back what was written
+    PolyVoxChunks copy;
+    QByteArray voxelData = chunks.toVoxelData();
+    QVERIFY(PolyVoxChunks::isChunked(voxelData));
+    QVERIFY(!PolyVoxChunks::isPartial(voxelData));
+    QVERIFY(copy.readVoxelData(voxelData));
+
+    const int CHUNK_SIDE = PolyVoxChunks::CHUNK_SIDE;
+    for (int i = 0; i < copy.getChunkCount(); i++) {
+        QVERIFY(copy.getChunk(i) == chunks.getChunk(i));
+
+        QByteArray chunkData = PolyVoxChunks::uncompressChunk(copy.getChunk(i));
+        QCOMPARE(chunkData.size(), PolyVoxChunks::CHUNK_VOXEL_COUNT);
+        int originX, originY, originZ;
+        copy.getChunkOrigin(i, originX, originY, originZ);
+        for (int z = originZ; z < std::min(originZ + CHUNK_SIDE, (int)SIZE); z++) {
+            for (int y = originY; y < std::min(originY + CHUNK_SIDE, (int)SIZE); y++) {
+                for (int x = originX; x < std::min(originX + CHUNK_SIDE, (int)SIZE); x++) {
+                    int index = ((z - originZ) * CHUNK_SIDE + (y - originY)) * CHUNK_SIDE + (x - originX);
+                    QCOMPARE((uint8_t)chunkData[index], testPattern(x, y, z));
+                }
+            }
+        }
+    }
+
+    // a truncated encoding is rejected and leaves the chunks alone
+    voxelData.chop(3);
+    QVERIFY(!copy.readVoxelData(voxelData));
+    QVERIFY(copy.getChunk(copy.getChunkCount() - 1) == chunks.getChunk(chunks.getChunkCount() - 1));
+}
+
+void PolyVoxTests::testPartialVoxelData() {
+    PolyVoxChunks chunks(64, 64, 64);
+    PolyVoxChunks edited = chunks;
+    std::vector<bool> changedChunks(chunks.getChunkCount(), false);
+
+    QByteArray uncompressedData(PolyVoxChunks::CHUNK_VOXEL_COUNT, '\0');
+    uncompressedData[100] = 1;
+    int index = chunks.getChunkIndexForVoxel(20, 40, 60);
+    edited.setChunk(index, PolyVoxChunks::compressChunk(uncompressedData));
+    changedChunks[index] = true;
+
+    QByteArray update = edited.toPartialVoxelData(changedChunks);
+    QVERIFY(PolyVoxChunks::isPartial(update));
+    QVERIFY(update.size() < edited.toVoxelData().size());
+
+    QVERIFY(chunks.readVoxelData(update));
+    for (int i = 0; i < chunks.getChunkCount(); i++) {
+        QVERIFY(chunks.getChunk(i) == edited.getChunk(i));
+    }
+    QVERIFY(!chunks.getChunk(index).isUniform());
+
+    // a partial update only applies to a volume of the same size
+    PolyVoxChunks otherSize(32, 32, 32);
+    QVERIFY(!otherSize.readVoxelData(update));
+}
+
+void PolyVoxTests::testRemeshTouchedChunks() {
+    auto entity = makeTerrain(64, 20);
+    auto setVoxel = [&](int x, int y, int z, uint8_t toValue) {
+        // unlike RenderablePolyVoxEntityItem::setVoxel, this doesn't queue an edit packet
+        entity->withWriteLock([&] {
+            entity->setVoxelInternal(x, y, z, toValue);
+        });
+    };
+
+    QVERIFY(entity->remeshDirtyChunks() > 8);
+    QCOMPARE(entity->remeshDirtyChunks(), 0);
+
+    // inside a chunk
+    setVoxel(24, 19, 24, 0);
+    QCOMPARE(entity->remeshDirtyChunks(), 1);
+
+    // on a face between two chunks
+    setVoxel(32, 19, 24, 0);
+    QCOMPARE(entity->remeshDirtyChunks(), 2);
+
+    // on a corner shared by eight chunks
+    setVoxel(32, 16, 32, 0);
+    QCOMPARE(entity->remeshDirtyChunks(), 8);
+
+    // a voxel that's already off doesn't change the surface
+    setVoxel(24, 40, 24, 0);
+    QCOMPARE(entity->remeshDirtyChunks(), 0);
+}
+
+// a triangle as its three corners, doubled so that the half-voxel positions of cubic faces are integers, and sorted
+// so that the same triangle compares equal whichever corner it starts from
+using Triangle = std::array<int, 9>;
+
+static Triangle makeTriangle(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2) {
+    std::array<std::array<int, 3>, 3> corners;
+    const glm::vec3* points[] = { &p0, &p1, &p2 };
+    for (int i = 0; i < 3; i++) {
+        for (int axis = 0; axis < 3; axis++) {
+            corners[i][axis] = (int)glm::round((*points[i])[axis] * 2.0f);
+        }
+    }
+    std::sort(corners.begin(), corners.end());
+    Triangle triangle;
+    for (int i = 0; i < 9; i++) {
+        triangle[i] = corners[i / 3][i % 3];
+    }
+    return triangle;
+}
+
+void PolyVoxTests::testCubicChunkSeams() {
+    // an irregular volume whose size isn't a multiple of the chunk side, so that faces fall on the seams between
+    // chunks and on the partial chunks along the far faces
+    const int SIZE = 40;
+    PolyVoxEntityItem::PolyVoxSurfaceStyle styles[] = {
+        PolyVoxEntityItem::SURFACE_CUBIC, PolyVoxEntityItem::SURFACE_EDGED_CUBIC
+    };
+    for (PolyVoxEntityItem::PolyVoxSurfaceStyle style : styles) {
+        auto entity = std::make_shared<RenderablePolyVoxEntityItem>(EntityItemID(QUuid::createUuid()));
+        entity->setVoxelSurfaceStyle(style);
+        entity->setVoxelVolumeSize(glm::vec3((float)SIZE));
+        entity->withWriteLock([&] {
+            for (int z = 0; z < SIZE; z++) {
+                for (int y = 0; y < SIZE; y++) {
+                    for (int x = 0; x < SIZE; x++) {
+                        entity->setVoxelInternal(x, y, z, testPattern(x, y, z));
+                    }
+                }
+            }
+        });
+        QVERIFY(entity->remeshDirtyChunks() > 0);
+
+        // the stitched chunk surfaces
+        std::vector<Triangle> chunked;
+        model::MeshPointer mesh = entity->getCurrentMesh();
+        const gpu::BufferView& indexBuffer = mesh->getIndexBuffer();
+        const gpu::BufferView& vertexBuffer = mesh->getVertexBuffer();
+        for (size_t i = 0; i + 2 < mesh->getNumIndices(); i += 3) {
+            chunked.push_back(makeTriangle(vertexBuffer.get<glm::vec3>(indexBuffer.get<uint32_t>(i)),
+                                           vertexBuffer.get<glm::vec3>(indexBuffer.get<uint32_t>(i + 1)),
+                                           vertexBuffer.get<glm::vec3>(indexBuffer.get<uint32_t>(i + 2))));
+        }
+
+        // the surface of the whole volume, extracted in one pass
+        std::vector<Triangle> whole;
+        PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
+        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+        PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+            (volData, volData->getEnclosingRegion(), &polyVoxMesh);
+        surfaceExtractor.execute();
+        const std::vector<PolyVox::PositionMaterialNormal>& vertices = polyVoxMesh.getVertices();
+        const std::vector<uint32_t>& indices = polyVoxMesh.getIndices();
+        auto toVec3 = [&](uint32_t index) {
+            PolyVox::Vector3DFloat position = vertices[index].getPosition();
+            return glm::vec3(position.getX(), position.getY(), position.getZ());
+        };
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            whole.push_back(makeTriangle(toVec3(indices[i]), toVec3(indices[i + 1]), toVec3(indices[i + 2])));
+        }
+
+        // every face is made once, by exactly one chunk
+        QVERIFY(!whole.empty());
+        std::sort(chunked.begin(), chunked.end());
+        std::sort(whole.begin(), whole.end());
+        QCOMPARE(chunked.size(), whole.size());
+        QVERIFY(chunked == whole);
+    }
+}
+
+void PolyVoxTests::benchmarkEditToMesh() {
+    const int SIZE = 128;
+    const int NUM_EDITS = 20;
+    auto entity = makeTerrain(SIZE, SIZE / 3);
+
+    QElapsedTimer timer;
+    timer.start();
+    int chunkCount = entity->remeshDirtyChunks();
+    qDebug() << "initial mesh of" << chunkCount << "chunks" << timer.nsecsElapsed() / 1000 << "usecs";
+
+    // dig small holes into the surface, as a sculpting tool would
+    qint64 editNsecs = 0;
+    int remeshedChunks = 0;
+    for (int i = 0; i < NUM_EDITS; i++) {
+        glm::vec3 center((i * 37) % SIZE, SIZE / 3, (i * 53) % SIZE);
+        timer.restart();
+        entity->withWriteLock([&] {
+            for (int z = -2; z <= 2; z++) {
+                for (int y = -2; y <= 2; y++) {
+                    for (int x = -2; x <= 2; x++) {
+                        entity->setVoxelInternal(center.x + x, center.y + y, center.z + z, 0);
+                    }
+                }
+            }
+        });
+        remeshedChunks += entity->remeshDirtyChunks();
+        editNsecs += timer.nsecsElapsed();
+    }
+    qDebug() << "edit to mesh" << editNsecs / NUM_EDITS / 1000 << "usecs,"
+             << (float)remeshedChunks / NUM_EDITS << "chunks per edit";
+    QVERIFY(remeshedChunks < chunkCount * NUM_EDITS);
+
+    // the same edit, re-extracting the whole volume
+    timer.restart();
+    entity->setAllMeshChunksDirty();
+    entity->remeshDirtyChunks();
+    qDebug() << "whole volume re-mesh" << timer.nsecsElapsed() / 1000 << "usecs";
+}
@@ -10,14 +10,17 @@
 
 #include <QCoreApplication>
 #include <QFile>
+#include <QFileInfo>
 #include <QTimer>
 #include <QElapsedTimer>
 #include <QLoggingCategory>
 #include <QDir>
+#include <QTemporaryDir>
 #include <ByteCountCoding.h>
 
 #include <BoxEntityItem.h>
 #include <EntityItemProperties.h>
+#include <EntityTree.h>
 #include <Octree.h>
 #include <PathUtils.h>
 
@@ -135,8 +138,103 @@ void testPropertyFlags() {
     testPropertyFlags(0xFFFF);
 }
 
+// peak resident set size of the process in KB, 0 where we can't read it
+quint64 getPeakRSS() {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        foreach (QByteArray line, status.readAll().split('\n')) {
+            if (line.startsWith("VmHWM:")) {
+                return line.mid(6).trimmed().split(' ').first().toULongLong();
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+quint64 getCurrentRSS() {
+#ifdef Q_OS_LINUX
+    QFile status("/proc/self/status");
+    if (status.open(QIODevice::ReadOnly)) {
+        foreach (QByteArray line, status.readAll().split('\n')) {
+            if (line.startsWith("VmRSS:")) {
+                return line.mid(6).trimmed().split(' ').first().toULongLong();
+            }
+        }
+    }
+#endif
+    return 0;
+}
+
+// restarts the peak RSS from the current RSS, so each step of the benchmark gets its own peak
+void resetPeakRSS() {
+#ifdef Q_OS_LINUX
+    QFile clearRefs("/proc/self/clear_refs");
+    if (clearRefs.open(QIODevice::WriteOnly)) {
+        clearRefs.write("5");
+    }
+#endif
+}
+
+EntityTreePointer createPersistBenchmarkTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+    return tree;
+}
+
+// compares saving and loading a generated tree in the json.gz and binary persist formats
+void benchmarkPersistFormats(int numEntities) {
+    QTemporaryDir directory;
+    EntityTreePointer tree = createPersistBenchmarkTree();
+
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setPosition(glm::vec3(randFloatInRange(0.0f, 1000.0f), randFloatInRange(0.0f, 100.0f),
+                                         randFloatInRange(0.0f, 1000.0f)));
+        properties.setDimensions(glm::vec3(randFloatInRange(0.1f, 10.0f)));
+        properties.setColor({ (uint8_t)(qrand() % 256), (uint8_t)(qrand() % 256), (uint8_t)(qrand() % 256) });
+        properties.setName(QString("benchmark entity %1").arg(i));
+        properties.setUserData(QString("{\"index\": %1}").arg(i));
+        tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    }
+    qDebug() << "generated" << numEntities << "entities";
+
+    foreach (const QString& persistType, QStringList({ "json.gz", "bin" })) {
+        QString fileName = directory.path() + "/models." + persistType;
+
+        quint64 baseRSS = getCurrentRSS();
+        resetPeakRSS();
+        auto start = usecTimestampNow();
+        tree->writeToFile(qPrintable(fileName), NULL, persistType);
+        float saveMsecs = (float)(usecTimestampNow() - start) / USECS_PER_MSEC;
+        quint64 savePeakKB = getPeakRSS() - baseRSS;
+
+        EntityTreePointer loadedTree = createPersistBenchmarkTree();
+        baseRSS = getCurrentRSS();
+        resetPeakRSS();
+        start = usecTimestampNow();
+        loadedTree->readFromFile(qPrintable(fileName));
+        float loadMsecs = (float)(usecTimestampNow() - start) / USECS_PER_MSEC;
+        quint64 loadPeakKB = getPeakRSS() - baseRSS;
+
+        qDebug() << persistType << "size:" << QFileInfo(fileName).size() / 1024 << "KB"
+            << "save:" << saveMsecs << "ms, peak RSS +" << savePeakKB << "KB"
+            << "load:" << loadMsecs << "ms, peak RSS +" << loadPeakKB << "KB";
+    }
+}
+
 int main(int argc, char** argv) {
     QCoreApplication app(argc, argv);
+
+    if (app.arguments().contains("--persist-benchmark")) {
+        DependencyManager::set<NodeList>(NodeType::Unassigned);
+        const int NUM_PERSIST_BENCHMARK_ENTITIES = 100000;
+        benchmarkPersistFormats(NUM_PERSIST_BENCHMARK_ENTITIES);
+        return 0;
+    }
     {
         auto start = usecTimestampNow();
         for (int i = 0; i < 1000; ++i) {
@@ -0,0 +1,90 @@
+//
+//  SendQueueSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueSchedulerTests.h"
+
+#include <ctime>
+#include <memory>
+#include <vector>
+
+#include <udt/Packet.h>
+#include <udt/Socket.h>
+
+QTEST_MAIN(SendQueueSchedulerTests)
+
+static const int PACKETS_PER_CONNECTION = 100;
+static const int PACKET_PAYLOAD_SIZE = 1000;
+static const int SCHEDULER_THREADS = 4;
+static const int DELIVERY_TIMEOUT_MSECS = 60 * 1000;
+
+void SendQueueSchedulerTests::sendBenchmark_data() {
+    QTest::addColumn<int>("numSendQueueThreads");
+    QTest::addColumn<int>("numConnections");
+
+    for (int numConnections : { 10, 100, 1000 }) {
+        QTest::newRow(qPrintable(QString("thread per queue, %1 connections").arg(numConnections)))
+            << 0 << numConnections;
+        QTest::newRow(qPrintable(QString("scheduler, %1 connections").arg(numConnections)))
+            << SCHEDULER_THREADS << numConnections;
+    }
+}
+
+void SendQueueSchedulerTests::sendBenchmark() {
+    QFETCH(int, numSendQueueThreads);
+    QFETCH(int, numConnections);
+
+    udt::Socket sender;
+    sender.setNumSendQueueThreads(numSendQueueThreads);
+    sender.bind(QHostAddress::LocalHost);
+
+    // every connection needs its own receiving socket, since connections are keyed on the remote address
+    int numReceivedPackets = 0;
+    std::vector<std::unique_ptr<udt::Socket>> receivers;
+
+    for (int i = 0; i < numConnections; ++i) {
+        receivers.emplace_back(new udt::Socket);
+        receivers.back()->bind(QHostAddress::LocalHost);
+        receivers.back()->setPacketHandler([&numReceivedPackets](std::unique_ptr<udt::Packet> packet) {
+            ++numReceivedPackets;
+        });
+    }
+
+    QByteArray payload(PACKET_PAYLOAD_SIZE, 'x');
+
+    QElapsedTimer timer;
+    timer.start();
+    std::clock_t cpuStart = std::clock();
+
+    for (auto& receiver : receivers) {
+        HifiSockAddr destination(QHostAddress::LocalHost, receiver->localPort());
+
+        for (int i = 0; i < PACKETS_PER_CONNECTION; ++i) {
+            auto packet = udt::Packet::create(-1, true);
+            packet->write(payload);
+            sender.writePacket(std::move(packet), destination);
+        }
+    }
+
+    int expectedPackets = numConnections * PACKETS_PER_CONNECTION;
+    while (numReceivedPackets < expectedPackets && timer.elapsed() < DELIVERY_TIMEOUT_MSECS) {
+        QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    }
+
+    auto elapsedMsecs = timer.elapsed();
+    auto cpuMsecs = (std::clock() - cpuStart) * 1000 / CLOCKS_PER_SEC;
+
+    qDebug() << numConnections << "connections," << (numSendQueueThreads > 0 ? "scheduler:" : "thread per queue:")
+        << numReceivedPackets << "packets in" << elapsedMsecs << "ms," << cpuMsecs << "ms of CPU";
+
+    QCOMPARE(numReceivedPackets, expectedPackets);
+
+    // stop the send queues before the sockets they send to go away
+    sender.clearConnections();
+}
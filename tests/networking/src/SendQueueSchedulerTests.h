@@ -0,0 +1,26 @@
+//
+//  SendQueueSchedulerTests.h
+//  tests/networking/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SendQueueSchedulerTests_h
+#define hifi_SendQueueSchedulerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SendQueueSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Compare a thread per SendQueue against a shared SendQueueScheduler delivering reliable packets
+    void sendBenchmark_data();
+    void sendBenchmark();
+};
+
+#endif // hifi_SendQueueSchedulerTests_h
@@ -0,0 +1,233 @@
+//
+//  OctreeJournalTests.cpp
+//  tests/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <QtCore/QTemporaryDir>
+
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <OctreeJournal.h>
+#include <SimpleEntitySimulation.h>
+
+#include "OctreeJournalTests.h"
+
+QTEST_MAIN(OctreeJournalTests)
+
+static EntityTreePointer createServerTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+    return tree;
+}
+
+static EntityItemProperties boxProperties(const glm::vec3& position, const QString& name) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setDimensions(glm::vec3(2.0f));
+    properties.setColor({ 10, 20, 30 });
+    properties.setName(name);
+    return properties;
+}
+
+static int replayInto(EntityTreePointer tree, OctreeJournal& journal) {
+    int numRecords = 0;
+    tree->withWriteLock([&] {
+        numRecords = tree->replayJournal(journal);
+    });
+    return numRecords;
+}
+
+void OctreeJournalTests::initTestCase() {
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+void OctreeJournalTests::replayReadsRecordsInOrder() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    OctreeJournal journal(directory.path() + "/test.journal");
+    QUuid first = QUuid::createUuid();
+    QUuid second = QUuid::createUuid();
+
+    journal.append(OctreeJournal::UpsertRecord, first, QByteArray("first"));
+    journal.append(OctreeJournal::UpsertRecord, second, QByteArray(4096, 'x'));
+    QCOMPARE(journal.getNumPendingRecords(), 2);
+    QVERIFY(journal.flush());
+    QCOMPARE(journal.getNumPendingRecords(), 0);
+
+    journal.append(OctreeJournal::EraseRecord, first);
+    QVERIFY(journal.flush());
+
+    QList<OctreeJournal::Record> records;
+    int numRecords = journal.replay([&](const OctreeJournal::Record& record) {
+        records << record;
+    });
+
+    QCOMPARE(numRecords, 3);
+    QCOMPARE(records[0].type, OctreeJournal::UpsertRecord);
+    QCOMPARE(records[0].id, first);
+    QCOMPARE(records[0].data, QByteArray("first"));
+    QCOMPARE(records[1].id, second);
+    QCOMPARE(records[1].data, QByteArray(4096, 'x'));
+    QCOMPARE(records[2].type, OctreeJournal::EraseRecord);
+    QCOMPARE(records[2].id, first);
+    QVERIFY(records[2].data.isEmpty());
+}
+
+void OctreeJournalTests::replayDropsIncompleteRecords() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    OctreeJournal journal(directory.path() + "/test.journal");
+    journal.append(OctreeJournal::UpsertRecord, QUuid::createUuid(), QByteArray("intact"));
+    QVERIFY(journal.flush());
+    qint64 intactSize = journal.getSize();
+
+    journal.append(OctreeJournal::UpsertRecord, QUuid::createUuid(), QByteArray("interrupted"));
+    QVERIFY(journal.flush());
+
+    // cut the last record short, as if we had crashed while writing it
+    QFile file(journal.getFilename());
+    QVERIFY(file.resize(journal.getSize() - 4));
+
+    int numRecords = journal.replay([](const OctreeJournal::Record& record) {});
+    QCOMPARE(numRecords, 1);
+    QCOMPARE(journal.getSize(), intactSize);
+
+    // records appended after the replay follow the intact ones
+    journal.append(OctreeJournal::EraseRecord, QUuid::createUuid());
+    QVERIFY(journal.flush());
+    QCOMPARE(journal.replay([](const OctreeJournal::Record& record) {}), 2);
+}
+
+void OctreeJournalTests::truncateDropsAllRecords() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    OctreeJournal journal(directory.path() + "/test.journal");
+    journal.append(OctreeJournal::UpsertRecord, QUuid::createUuid(), QByteArray("saved"));
+    QVERIFY(journal.flush());
+    QVERIFY(journal.getSize() > 0);
+
+    QVERIFY(journal.truncate());
+    QCOMPARE(journal.getSize(), (qint64)0);
+    QCOMPARE(journal.replay([](const OctreeJournal::Record& record) {}), 0);
+}
+
+void OctreeJournalTests::replayRestoresEntityProperties() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreeJournal journal(directory.path() + "/test.journal");
+
+    EntityTreePointer tree = createServerTree();
+    tree->setJournalChanges(true);
+
+    EntityItemID entityID(QUuid::createUuid());
+    QVERIFY(tree->addEntity(entityID, boxProperties(glm::vec3(10.0f, 20.0f, 30.0f), "before")));
+    QCOMPARE(tree->writeJournalRecords(journal), 1);
+
+    // a later edit of the same entity replaces the state of the first record on replay
+    EntityItemProperties edit;
+    edit.setPosition(glm::vec3(100.0f, 20.0f, 30.0f));
+    edit.setName("after");
+    QVERIFY(tree->updateEntity(entityID, edit));
+    QCOMPARE(tree->writeJournalRecords(journal), 1);
+    QVERIFY(journal.flush());
+
+    // replayed over an empty tree and over one that already holds the first state, the entity ends up the same
+    EntityTreePointer emptyTree = createServerTree();
+    EntityTreePointer olderTree = createServerTree();
+    QVERIFY(olderTree->addEntity(entityID, boxProperties(glm::vec3(10.0f, 20.0f, 30.0f), "before")));
+
+    foreach (EntityTreePointer restoredTree, QList<EntityTreePointer>({ emptyTree, olderTree })) {
+        QCOMPARE(replayInto(restoredTree, journal), 2);
+
+        EntityItemPointer entity = restoredTree->findEntityByEntityItemID(entityID);
+        QVERIFY(entity);
+        QCOMPARE(entity->getType(), EntityTypes::Box);
+        QCOMPARE(entity->getName(), QString("after"));
+        QCOMPARE(entity->getPosition(), glm::vec3(100.0f, 20.0f, 30.0f));
+        QCOMPARE(entity->getDimensions(), glm::vec3(2.0f));
+        QCOMPARE(entity->getProperties().getColor().red, (unsigned char)10);
+        QCOMPARE(entity->getProperties().getColor().blue, (unsigned char)30);
+        QVERIFY(restoredTree->findEntityByEntityItemID(entityID) == restoredTree->findClosestEntity(
+            glm::vec3(100.0f, 20.0f, 30.0f), 1.0f));
+    }
+}
+
+void OctreeJournalTests::replayErasesDeletedEntities() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreeJournal journal(directory.path() + "/test.journal");
+
+    EntityTreePointer tree = createServerTree();
+    tree->setJournalChanges(true);
+
+    EntityItemID keptID(QUuid::createUuid());
+    EntityItemID deletedID(QUuid::createUuid());
+    QVERIFY(tree->addEntity(keptID, boxProperties(glm::vec3(10.0f), "kept")));
+    QVERIFY(tree->addEntity(deletedID, boxProperties(glm::vec3(20.0f), "deleted")));
+    QCOMPARE(tree->writeJournalRecords(journal), 2);
+
+    tree->withWriteLock([&] {
+        tree->deleteEntity(deletedID, true, true);
+    });
+    QCOMPARE(tree->writeJournalRecords(journal), 1);
+    QVERIFY(journal.flush());
+
+    EntityTreePointer restoredTree = createServerTree();
+    QVERIFY(restoredTree->addEntity(deletedID, boxProperties(glm::vec3(20.0f), "deleted")));
+    QCOMPARE(replayInto(restoredTree, journal), 3);
+
+    QVERIFY(restoredTree->findEntityByEntityItemID(keptID));
+    QVERIFY(!restoredTree->findEntityByEntityItemID(deletedID));
+}
+
+void OctreeJournalTests::simulationChangesAreJournaled() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+    OctreeJournal journal(directory.path() + "/test.journal");
+
+    EntityTreePointer tree = createServerTree();
+    SimpleEntitySimulation* simulation = new SimpleEntitySimulation();
+    simulation->setEntityTree(tree);
+    tree->setSimulation(simulation);
+    tree->setJournalChanges(true);
+
+    EntityItemID movingID(QUuid::createUuid());
+    EntityItemProperties properties = boxProperties(glm::vec3(10.0f), "moving");
+    properties.setVelocity(glm::vec3(1.0f, 0.0f, 0.0f));
+    properties.setDamping(0.0f);
+    QVERIFY(tree->addEntity(movingID, properties));
+
+    EntityItemID markedID(QUuid::createUuid());
+    QVERIFY(tree->addEntity(markedID, boxProperties(glm::vec3(50.0f), "marked")));
+    QCOMPARE(tree->writeJournalRecords(journal), 2);
+
+    // kinematic motion of the server's own simulation
+    QTest::qSleep(50);
+    tree->update();
+    EntityItemPointer movingEntity = tree->findEntityByEntityItemID(movingID);
+    QVERIFY(movingEntity->getPosition().x > 10.0f);
+
+    // and a change made on the server outside of an edit
+    tree->findEntityByEntityItemID(markedID)->markAsChangedOnServer();
+
+    QCOMPARE(tree->writeJournalRecords(journal), 2);
+    QVERIFY(journal.flush());
+
+    EntityTreePointer restoredTree = createServerTree();
+    QCOMPARE(replayInto(restoredTree, journal), 4);
+    QCOMPARE(restoredTree->findEntityByEntityItemID(movingID)->getPosition(), movingEntity->getPosition());
+    QVERIFY(restoredTree->findEntityByEntityItemID(markedID));
+
+    tree->setSimulation(nullptr);
+    delete simulation;
+}
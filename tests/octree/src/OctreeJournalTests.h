@@ -0,0 +1,29 @@
+//
+//  OctreeJournalTests.h
+//  tests/octree/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournalTests_h
+#define hifi_OctreeJournalTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void replayReadsRecordsInOrder();
+    void replayDropsIncompleteRecords();
+    void truncateDropsAllRecords();
+    void replayRestoresEntityProperties();
+    void replayErasesDeletedEntities();
+    void simulationChangesAreJournaled();
+};
+
+#endif // hifi_OctreeJournalTests_h
@@ -0,0 +1,188 @@
+//
+//  ModelKernelsBenchmark.cpp
+//  tests/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelKernelsBenchmark.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <ModelKernels.h>
+
+// roughly a face mesh, blended for each of a crowd of avatars
+static const int NUM_AVATARS = 50;
+static const int NUM_VERTICES = 5000;
+static const int NUM_BLENDSHAPES = 50;
+static const int DELTAS_PER_BLENDSHAPE = 400;
+static const int NUM_CLUSTERS = 100;
+static const int NUM_FRAMES = 20;
+
+struct TestBlendshape {
+    QVector<int> indices;
+    QVector<glm::vec3> vertices;
+    QVector<glm::vec3> normals;
+};
+
+static float randomFloat() {
+    return (float)rand() / (float)RAND_MAX - 0.5f;
+}
+
+static glm::vec3 randomVec3() {
+    return glm::vec3(randomFloat(), randomFloat(), randomFloat());
+}
+
+static glm::mat4 randomMatrix() {
+    glm::mat4 matrix = glm::mat4_cast(glm::normalize(glm::quat(randomFloat(), randomFloat(), randomFloat(), randomFloat())));
+    matrix[3] = glm::vec4(randomVec3(), 1.0f);
+    return matrix;
+}
+
+static float maxDifference(const QVector<glm::vec3>& a, const QVector<glm::vec3>& b) {
+    float result = 0.0f;
+    for (int i = 0; i < a.size(); i++) {
+        glm::vec3 difference = glm::abs(a[i] - b[i]);
+        result = std::max(result, std::max(difference.x, std::max(difference.y, difference.z)));
+    }
+    return result;
+}
+
+static bool benchmarkBlendshapes() {
+    QVector<glm::vec3> baseVertices, baseNormals;
+    for (int i = 0; i < NUM_VERTICES; i++) {
+        baseVertices << randomVec3();
+        baseNormals << randomVec3();
+    }
+
+    QVector<TestBlendshape> blendshapes(NUM_BLENDSHAPES);
+    QVector<float> coefficients;
+    for (auto& blendshape : blendshapes) {
+        for (int j = 0; j < DELTAS_PER_BLENDSHAPE; j++) {
+            blendshape.indices << rand() % NUM_VERTICES;
+            blendshape.vertices << randomVec3();
+            blendshape.normals << randomVec3();
+        }
+        coefficients << std::max(randomFloat(), 0.0f);
+    }
+
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+    const float EPSILON = 0.0001f;
+
+    // as Blender used to: fresh vectors each blend, and one delta at a time
+    QVector<glm::vec3> scalarVertices, scalarNormals;
+    QElapsedTimer timer;
+    timer.start();
+    for (int blend = 0; blend < NUM_AVATARS * NUM_FRAMES; blend++) {
+        QVector<glm::vec3> vertices, normals;
+        vertices += baseVertices;
+        normals += baseNormals;
+        for (int i = 0; i < NUM_BLENDSHAPES; i++) {
+            float vertexCoefficient = coefficients[i];
+            if (vertexCoefficient < EPSILON) {
+                continue;
+            }
+            float normalCoefficient = vertexCoefficient * NORMAL_COEFFICIENT_SCALE;
+            const TestBlendshape& blendshape = blendshapes.at(i);
+            for (int j = 0; j < blendshape.indices.size(); j++) {
+                int index = blendshape.indices.at(j);
+                vertices[index] += blendshape.vertices.at(j) * vertexCoefficient;
+                normals[index] += blendshape.normals.at(j) * normalCoefficient;
+            }
+        }
+        scalarVertices = vertices;
+        scalarNormals = normals;
+    }
+    qint64 scalarNsecs = timer.nsecsElapsed();
+
+    // as Blender does now: reused buffers and the accumulation kernel
+    QVector<glm::vec3> vertices, normals;
+    timer.restart();
+    for (int blend = 0; blend < NUM_AVATARS * NUM_FRAMES; blend++) {
+        vertices.resize(NUM_VERTICES);
+        normals.resize(NUM_VERTICES);
+        std::copy(baseVertices.constBegin(), baseVertices.constEnd(), vertices.data());
+        std::copy(baseNormals.constBegin(), baseNormals.constEnd(), normals.data());
+        for (int i = 0; i < NUM_BLENDSHAPES; i++) {
+            float vertexCoefficient = coefficients[i];
+            if (vertexCoefficient < EPSILON) {
+                continue;
+            }
+            const TestBlendshape& blendshape = blendshapes.at(i);
+            accumulateBlendshape(vertices.data(), normals.data(), blendshape.indices.constData(),
+                                 blendshape.vertices.constData(), blendshape.normals.constData(),
+                                 blendshape.indices.size(), vertexCoefficient, vertexCoefficient * NORMAL_COEFFICIENT_SCALE);
+        }
+    }
+    qint64 kernelNsecs = timer.nsecsElapsed();
+
+    double blends = NUM_AVATARS * NUM_FRAMES;
+    qDebug() << "blendshapes, scalar:" << blends * 1.0e6 / scalarNsecs << "blends/ms,"
+             << "kernel:" << blends * 1.0e6 / kernelNsecs << "blends/ms";
+
+    const float MAX_ERROR = 0.0001f;
+    return maxDifference(vertices, scalarVertices) < MAX_ERROR && maxDifference(normals, scalarNormals) < MAX_ERROR;
+}
+
+static bool benchmarkClusterMatrices() {
+    glm::mat4 modelToWorld = glm::mat4_cast(glm::normalize(glm::quat(1.0f, 0.2f, 0.3f, 0.4f)));
+    QVector<glm::mat4> jointMatrices, inverseBindMatrices;
+    for (int i = 0; i < NUM_CLUSTERS; i++) {
+        jointMatrices << randomMatrix();
+        inverseBindMatrices << randomMatrix();
+    }
+    QVector<glm::mat4> scalarMatrices(NUM_CLUSTERS), kernelMatrices(NUM_CLUSTERS);
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int update = 0; update < NUM_AVATARS * NUM_FRAMES; update++) {
+        for (int j = 0; j < NUM_CLUSTERS; j++) {
+            scalarMatrices[j] = modelToWorld * jointMatrices[j] * inverseBindMatrices[j];
+        }
+    }
+    qint64 scalarNsecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int update = 0; update < NUM_AVATARS * NUM_FRAMES; update++) {
+        composeClusterMatrices(modelToWorld, jointMatrices.constData(), inverseBindMatrices.constData(),
+                               kernelMatrices.data(), NUM_CLUSTERS);
+    }
+    qint64 kernelNsecs = timer.nsecsElapsed();
+
+    double matrices = (double)NUM_AVATARS * NUM_FRAMES * NUM_CLUSTERS;
+    qDebug() << "cluster matrices, scalar:" << matrices * 1.0e6 / scalarNsecs << "matrices/ms,"
+             << "kernel:" << matrices * 1.0e6 / kernelNsecs << "matrices/ms";
+
+    const float MAX_ERROR = 0.0001f;
+    for (int j = 0; j < NUM_CLUSTERS; j++) {
+        for (int column = 0; column < 4; column++) {
+            glm::vec4 difference = glm::abs(kernelMatrices[j][column] - scalarMatrices[j][column]);
+            if (std::max(std::max(difference.x, difference.y), std::max(difference.z, difference.w)) > MAX_ERROR) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool runModelKernelsBenchmark() {
+    bool blendshapesMatch = benchmarkBlendshapes();
+    bool clusterMatricesMatch = benchmarkClusterMatrices();
+    if (!blendshapesMatch) {
+        qWarning() << "blendshape kernel results differ from the scalar ones";
+    }
+    if (!clusterMatricesMatch) {
+        qWarning() << "cluster matrix kernel results differ from the scalar ones";
+    }
+    return blendshapesMatch && clusterMatricesMatch;
+}
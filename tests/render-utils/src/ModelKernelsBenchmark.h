@@ -0,0 +1,18 @@
+//
+//  ModelKernelsBenchmark.h
+//  tests/render-utils/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelKernelsBenchmark_h
+#define hifi_ModelKernelsBenchmark_h
+
+// times the blendshape and cluster matrix kernels against the scalar loops they replace, without needing a window.
+// returns false if the kernels' results don't match the scalar ones.
+bool runModelKernelsBenchmark();
+
+#endif // hifi_ModelKernelsBenchmark_h
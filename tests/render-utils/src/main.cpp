@@ -25,6 +25,8 @@
 #include <QTimer>
 #include <QWindow>
 
+#include "ModelKernelsBenchmark.h"
+
 class RateCounter {
     std::vector<float> times;
     QElapsedTimer timer;
@@ -203,6 +205,13 @@ hifi.gpu=true
 )V0G0N";
 
 int main(int argc, char** argv) {    
+    // --benchmark times the model kernels and exits, without opening a window
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--benchmark") {
+            return runModelKernelsBenchmark() ? 0 : 1;
+        }
+    }
+
     QGuiApplication app(argc, argv);
     qInstallMessageHandler(messageHandler);
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
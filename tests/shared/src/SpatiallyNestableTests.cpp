@@ -0,0 +1,139 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <QHash>
+
+#include <DependencyManager.h>
+#include <GLMHelpers.h>
+#include <SpatiallyNestable.h>
+
+#include "../GLMTestUtils.h"
+#include "../QTestExtensions.h"
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+const float EPSILON = 0.001f;
+
+class TestNestable : public SpatiallyNestable {
+public:
+    TestNestable(bool staticJoints) : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()), _staticJoints(staticJoints) { }
+
+    virtual glm::quat getAbsoluteJointRotationInObjectFrame(int index) const override { return glm::quat(); }
+    virtual glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override { return glm::vec3(0.0f); }
+    virtual bool setAbsoluteJointRotationInObjectFrame(int index, const glm::quat& rotation) override { return false; }
+    virtual bool setAbsoluteJointTranslationInObjectFrame(int index, const glm::vec3& translation) override { return false; }
+
+protected:
+    virtual bool hasStaticJoints() const override { return _staticJoints; }
+
+private:
+    bool _staticJoints;
+};
+
+using TestNestablePointer = std::shared_ptr<TestNestable>;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    virtual SpatiallyNestableWeakPointer find(QUuid parentID, bool& success,
+                                              SpatialParentTree* entityTree = nullptr) const override {
+        SpatiallyNestableWeakPointer parent = _nestables.value(parentID);
+        success = parentID.isNull() || !parent.expired();
+        return parent;
+    }
+
+    void add(SpatiallyNestablePointer nestable) { _nestables[nestable->getID()] = nestable; }
+
+private:
+    QHash<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+// builds a chain of nestables, each one unit along x from its parent.  the first one is the root.
+static QVector<TestNestablePointer> makeChain(int length, bool staticJoints) {
+    auto finder = DependencyManager::get<TestParentFinder>();
+    QVector<TestNestablePointer> chain;
+    for (int i = 0; i < length; ++i) {
+        auto nestable = std::make_shared<TestNestable>(staticJoints);
+        finder->add(nestable);
+        if (!chain.isEmpty()) {
+            nestable->setParentID(chain.last()->getID());
+        }
+        nestable->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+        chain << nestable;
+    }
+    return chain;
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::cachedTransformFollowsParent() {
+    auto chain = makeChain(4, true);
+    auto root = chain.first();
+    auto leaf = chain.last();
+
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(4.0f, 0.0f, 0.0f), EPSILON);
+    // a second read comes from the cache
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(4.0f, 0.0f, 0.0f), EPSILON);
+
+    root->setPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(3.0f, 2.0f, 0.0f), EPSILON);
+
+    chain[1]->setOrientation(glm::angleAxis(PI_OVER_TWO, Vectors::UNIT_Z));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(2.0f, 4.0f, 0.0f), EPSILON);
+
+    leaf->setLocalPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(2.0f, 5.0f, 0.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::cachedTransformFollowsReparenting() {
+    auto chain = makeChain(3, true);
+    auto other = makeChain(1, true).first();
+    auto leaf = chain.last();
+
+    other->setPosition(glm::vec3(0.0f, 0.0f, 10.0f));
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(3.0f, 0.0f, 0.0f), EPSILON);
+
+    // moving the middle of the chain onto another parent moves everything below it
+    chain[1]->setParentID(other->getID());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(2.0f, 0.0f, 10.0f), EPSILON);
+
+    chain[1]->setParentID(QUuid());
+    QCOMPARE_WITH_ABS_ERROR(leaf->getPosition(), glm::vec3(2.0f, 0.0f, 0.0f), EPSILON);
+}
+
+void SpatiallyNestableTests::getTransformBenchmark_data() {
+    QTest::addColumn<int>("depth");
+    QTest::addColumn<bool>("staticJoints");
+
+    for (int depth = 1; depth <= 10; ++depth) {
+        QTest::newRow(qPrintable(QString("depth %1, static joints").arg(depth))) << depth << true;
+        QTest::newRow(qPrintable(QString("depth %1, animated joints").arg(depth))) << depth << false;
+    }
+}
+
+void SpatiallyNestableTests::getTransformBenchmark() {
+    QFETCH(int, depth);
+    QFETCH(bool, staticJoints);
+
+    auto chain = makeChain(depth, staticJoints);
+    auto leaf = chain.last();
+
+    bool success;
+    glm::vec3 position;
+    QBENCHMARK {
+        position = leaf->getTransform(success).getTranslation();
+    }
+    QVERIFY(success);
+    QCOMPARE_WITH_ABS_ERROR(position, glm::vec3((float)depth, 0.0f, 0.0f), EPSILON);
+}
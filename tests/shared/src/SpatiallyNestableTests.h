@@ -0,0 +1,28 @@
+//
+//  SpatiallyNestableTests.h
+//  tests/shared/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatiallyNestableTests_h
+#define hifi_SpatiallyNestableTests_h
+
+#include <QtTest/QtTest>
+
+class SpatiallyNestableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+    void cachedTransformFollowsParent();
+    void cachedTransformFollowsReparenting();
+
+    // world-transform reads of the leaf of an unchanging chain, with and without cacheable joints
+    void getTransformBenchmark_data();
+    void getTransformBenchmark();
+};
+
+#endif // hifi_SpatiallyNestableTests_h
@@ -0,0 +1,117 @@
+//
+//  main.cpp
+//  tools/entity-file-convert/src
+//
+//  Copyright 2016 High Fidelity, Inc.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+//  Converts an entity-server persist file between the json, json.gz and bin formats, in either direction.
+//  The format of each file is picked from its extension.
+//
+//  USAGE: entity-file-convert models.json.gz models.bin
+//         entity-file-convert models.bin models.json
+//
+
+#include <iostream>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+
+#include <EntityTree.h>
+#include <NodeList.h>
+#include <SpatialParentFinder.h>
+
+// lets entities find their parents in the tree we are converting, so children are not dropped as orphans
+class ConvertParentFinder : public SpatialParentFinder {
+public:
+    ConvertParentFinder(EntityTreePointer tree) : _tree(tree) { }
+
+    virtual SpatiallyNestableWeakPointer find(QUuid parentID, bool& success,
+                                              SpatialParentTree* entityTree = nullptr) const override {
+        SpatiallyNestableWeakPointer parent;
+        if (!parentID.isNull()) {
+            parent = _tree->findEntityByEntityItemID(parentID);
+        }
+        success = parentID.isNull() || !parent.expired();
+        return parent;
+    }
+
+private:
+    EntityTreePointer _tree;
+};
+
+static QString persistTypeForFile(const QString& fileName) {
+    // check the longer extensions first, so models.json.gz isn't taken for json
+    QString lowerFileName = fileName.toLower();
+    QString bestExtension;
+    foreach (const QString& extension, PERSIST_EXTENSIONS) {
+        if (lowerFileName.endsWith("." + extension) && extension.length() > bestExtension.length()) {
+            bestExtension = extension;
+        }
+    }
+    return bestExtension;
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QStringList arguments = app.arguments();
+    if (arguments.size() != 3) {
+        std::cerr << "usage: entity-file-convert <input file> <output file>" << std::endl;
+        std::cerr << "    the file formats are picked from the extensions: .json, .json.gz or .bin" << std::endl;
+        return 1;
+    }
+
+    QString inputFileName = arguments[1];
+    QString outputFileName = arguments[2];
+    QString inputType = persistTypeForFile(inputFileName);
+    QString outputType = persistTypeForFile(outputFileName);
+
+    if (inputType.isEmpty() || inputType == "svo" || outputType.isEmpty() || outputType == "svo") {
+        std::cerr << "only .json, .json.gz and .bin files can be converted" << std::endl;
+        return 1;
+    }
+
+    // entities ask the NodeList for our session when they are read from a bitstream
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->setIsServer(true);
+    tree->createRootElement();
+
+    DependencyManager::registerInheritance<SpatialParentFinder, ConvertParentFinder>();
+    DependencyManager::set<ConvertParentFinder>(tree);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // read the given file directly, readFromFile() would pick up a newer file of another format next to it
+    bool success = false;
+    if (inputType == "bin") {
+        success = tree->readBinaryFromFile(inputFileName);
+    } else if (inputType == "json.gz") {
+        success = tree->readJSONFromGzippedFile(inputFileName);
+    } else {
+        QFile inputFile(inputFileName);
+        if (inputFile.open(QIODevice::ReadOnly)) {
+            QDataStream inputStream(&inputFile);
+            success = tree->readJSONFromStream(inputFile.size(), inputStream);
+        }
+    }
+
+    if (!success) {
+        std::cerr << "failed to read " << qPrintable(inputFileName) << std::endl;
+        return 1;
+    }
+
+    qint64 readMsecs = timer.restart();
+
+    tree->writeToFile(qPrintable(outputFileName), NULL, outputType);
+
+    std::cout << "converted " << qPrintable(inputFileName) << " to " << qPrintable(outputFileName)
+        << " (read " << readMsecs << " ms, write " << timer.elapsed() << " ms)" << std::endl;
+    return 0;
+}